@@ -66,10 +66,12 @@
 //
 // Global variables were used extensively in the test code.  The use of global
 // varaibles was avoided in core BCH functions that might be used as a guide
-// for designing functions of a firmware product.  There are a few global
-// variables in bchDecode to assist testing.  They are marked "for testing only"
-// and may be deleted in the function you write to integrate into a firmware
-// product.
+// for designing functions of a firmware product.  All of the state of a code
+// is kept in a BchCodec context and the per decode working storage is kept in
+// a BchScratch area, so the core functions are reentrant.  There are a few
+// scratch area fields used by bchDecode to assist testing.  They are marked
+// "for testing only" and may be deleted in the function you write to integrate
+// into a firmware product.
 //
 // It is recommended that you run lint or a lint like program to help find subtle
 // errors in your code, especially array boundary problems.  Another way to
@@ -104,6 +106,10 @@
 // a wide range of finite field sizes.  For a particular implementation
 // you could try reducing the size of the values to save memory.  It is
 // possibe that this would affect speed but I am not sure in which direction.
+// (The codeword buffers are now "unsigned char", the log and alog tables are
+// 16 bits per entry and the encode table rows are packed to the redundancy
+// length.  This keeps the tables a code touches small enough to stay in the
+// L2 cache for m up to 14 or so.)
 //
 // This code supports two root finders, Chien and BTA.  You will need to
 // test both to see which one best fits your requirements. For the parameter
@@ -132,6 +138,36 @@
 #include <math.h>   // Not needed right now
 #include <time.h>	// Needed for time functions
 #include <stdlib.h> // Needed for the rand and srand functions
+#include <thread>   // Needed for the batch decode worker threads
+#include <mutex>    // Needed for the batch decode worker pool
+#include <condition_variable> // Needed for the batch decode worker pool
+#include <chrono>   // Needed for the root finder calibration timer
+//
+// SIMD support (PCLMULQDQ, AVX2, AVX-512).  Only built for 64 bit x86.  The
+// instructions are used only if the CPU (and OS) report them at run time.
+#if defined(_M_X64) || defined(__x86_64__)
+#define BCHX86SIMD (1)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>	// Needed for __cpuid
+#define TARGETCLMUL
+#define TARGETAVX2
+#define TARGETAVX512
+#define TARGETAVX512BW
+#define TARGETGFNI
+#define TARGETVPCLMUL
+#else
+#include <cpuid.h>	// Needed for __get_cpuid
+#define TARGETCLMUL __attribute__((target("pclmul,sse2")))
+#define TARGETAVX2 __attribute__((target("avx2")))
+#define TARGETAVX512 __attribute__((target("avx512f")))
+#define TARGETAVX512BW __attribute__((target("avx512f,avx512bw")))
+#define TARGETGFNI __attribute__((target("avx512f,avx512bw,gfni")))
+#define TARGETVPCLMUL __attribute__((target("avx512f,avx512bw,vpclmulqdq")))
+#endif
+#else
+#define BCHX86SIMD (0)
+#endif
 //
 // An instance of this structure is used to return 2 items from bchEval
 struct statAndFCnt { // Status and failing pass number
@@ -142,6 +178,16 @@ struct statAndFCnt { // Status and failing pass number
 // Defines for the functions that deal with codewords on disk
 #define MAXFILESIZE  (5000000) // Maximum file size for reading codewords from disk
 #define MAXLOOPALLCWSCNT (1000000) // For CWs from disk, max times to loop all CWs
+#define UNCORRCHKCWS	(1000)	// # t+1 error words chkUncorrUntouched decodes
+#define CHASECHKCWS		(200)	// # words of each check chkChase decodes
+#define CHASECHKBITS	(4)		// Flip bits chkChase uses for the t+1 error words
+#define KEYEQCHKCWS		(1000)	// # words of 1 to t+1 errors chkKeyEq decodes per riBM width
+#define FFKERNELCHKVECS	(1000)	// # random vectors chkFfKernels runs through each kernel per path
+#define SGCHKCWS		(1000)	// # words chkScatterGather encodes and decodes per remainder engine
+#define SGCHKSEGS		(8)		// Max data (and parity) segments chkScatterGather splits a word into
+#define SGCHKGUARD		(0xa5)	// Guard byte chkScatterGather puts after each segment
+#define MAXDECODETHREADS (256)	// Max worker threads for the batch decoder
+#define STREAMCHUNKBYTES (4000000) // Size of each of the 3 streaming decode buffers
 // Definitions for evaluation code
 #define MAXERRSTOSIM (200)     // Determines memory size for errors to simulate
 #define ZERO			(0)			// Zero
@@ -160,6 +206,63 @@ struct statAndFCnt { // Status and failing pass number
 #define MAXREDUNWDS (((MAXCORR*MAXMPARM)/8+1)/4+1)  //Max # redundancy words
 // Definitions for clarity
 #define BYTESTATES		(256)   // Number of states of a byte
+#define MAXSLICEBYTES	(8)		// Max data bytes per encode/remainder step
+#define ENCODESLICEBYTES (8)	// Data bytes per encode/remainder step - 1, 4 or 8
+#define MAXFOLDWORDS	((MAXCORR*MAXMPARM+63)/64+1) // Max 64 bit words, CLMUL fold
+// Remainder engine options - how data bytes are shifted into the shift register
+#define REMENGTABLE		(0)		// Encode (and slicing) tables
+#define REMENGCLMUL		(1)		// Carry-less multiply folding
+#define REMENGAUTO		(2)		// CLMUL if the CPU has it and CWs are long enough
+#define CLMULMINDATABYTES (64)	// Shortest data field for which auto picks CLMUL
+#define ENCODELANES		(16)	// Max codewords bchEncodeBatch runs in lockstep
+#define ENCODELANEWDS	(2)		// Max redundancy words for lanes with CLMUL engine
+#define ENCODEBATCHCWS	(64)	// Codewords per bchEncodeBatch call when writing test CWs
+#define MAXREDUNBYTES	((MAXCORR*MAXMPARM)/8+1) // Max # redundancy bytes
+#define SYNDROMETBLS	(1)		// "1" - syndromes from per byte tables, "0" - bitwise
+#define CHIENSHORTENED	(1)		// "1" - Chien searches only codeword bits, quits early
+#define KEYEQBERMAS		(0)		// Key equation solver - Berlekamp-Massey (berMas)
+#define KEYEQRIBM		(1)		// Key equation solver - inversionless BM (riBM)
+#define KEYEQSOLVER		(KEYEQBERMAS)	// Key equation solver main passes to bchCodecInit if not asked
+#define LOWWEIGHTDECODE	(1)		// "1" - closed form decode of 1 to 3 errors first
+#define MAXAFFINEDEG	(6)		// Max ELP degree affineElp solves
+#define AFFINEELPDEG	(6)		// ELP degree up to which affineElp is used, 0 - not used
+#define MAXRIBMTERMS	(3*MAXCORR+1+2*MAXCHIENLANES) // riBM array size incl. SIMD overrun
+#define BITSLICEDECODE	(0)		// "1" - bit-sliced bchDecodeBatch, main passes to bchCodecInit if not asked
+#define MAXBITSLICEWORDS (8)	// Max 64 bit words per bit-sliced row (512 CWs per pass)
+#define BITSLICECACHEBYTES (1048576) // Cache budget for the rows of one bit-sliced pass
+#define BITSLICEKEYEQMIN (32)	// Min # CWs in error, of 64, for the bit-sliced riBM
+#define FIXEDCODES		(1)		// "1" - build the compile time specialized codes (BchCode)
+#define DELTAENCODE		(1)		// "1" - build the bit position tables for bchUpdateParity
+#define MAXDELTADATABYTES (4096) // Max numDataBytes for which the delta tables are built
+#define VERIFYCORR		(1)		// "1" - check the error locations against the syndromes
+#define VERIFYBATCHLOCS	(16)	// Min # locations verifyCorr steps with ffMultBatch
+#define MAXCHASEBITS	(12)	// Max least reliable bits bchDecodeChase flips (2^12 patterns)
+#define DIRECTDECODE	(1)		// "1" - t<=2 codes map the syndromes straight to locations
+#define FFKERNELSIMD	(1)		// "1" - GF(2^m) kernels use GFNI/VPCLMULQDQ if the CPU has them
+#define FIXEDSYNTBLMAX	(262144) // Max syndrome table entries BchCode builds
+// CPU feature bits returned by cpuFeatures
+#define CPUPCLMUL		(0x0001)	// PCLMULQDQ
+#define CPUAVX2			(0x0002)	// AVX2 (and OS saves YMM state)
+#define CPUAVX512		(0x0004)	// AVX-512F (and OS saves ZMM state)
+#define CPUAVX512BW		(0x0008)	// AVX-512BW (and OS saves ZMM state)
+#define CPUGFNI			(0x0010)	// GFNI (and OS saves ZMM state)
+#define CPUVPCLMUL		(0x0020)	// VPCLMULQDQ (and OS saves ZMM state)
+// Root finder options
+#define ROOTFINDCHIEN	(0)		// Chien search
+#define ROOTFINDBTA		(1)		// Berlekamp trace algorithm
+#define ROOTFINDSIMD	(2)		// SIMD Chien search (AVX2/AVX-512BW)
+#define ROOTFINDTABLE	(3)		// Chien search with constant multiplier tables
+#define ROOTFINDAUTO	(4)		// TABLE if its tables fit in cache, else SIMD
+#define ROOTFINDAFFINE	(5)		// Affine (linearized) polynomial root finder
+#define ROOTFINDTUNED	(6)		// Per ELP degree, the root finder timed fastest at init
+#define ROOTFINDBATCH	(7)		// ELP evaluated at all positions by the GF(2^m) batch kernels
+#define ROOTFINDOPTIONS	(8)		// # of root finder options
+#define BATCHEVALPTS	(256)	// Positions per ffPolyEvalBatch call of rootFindBatch
+#define TUNEELPS		(16)	// ELPs per degree the calibration times each root finder on
+#define CHIENTBLCACHEBYTES (1048576) // Cache budget for the Chien multiplier tables
+#define CHIENTBLPOS		(4)		// Positions per table Chien search step
+#define MAXCHIENLANES	(64)	// Max positions per SIMD Chien search step
+#define AFFINELOWBITS	(8)		// Low element bits rootFindAffine takes from tables
 // Init error definitions
 //#define QUADBUILDERR  (2)		// Err building the quad table for special solutions
 // Definition of error flag bits (uncorrectable errors)
@@ -186,6 +289,13 @@ struct statAndFCnt { // Status and failing pass number
 #define QUOZROONENTRYERR  (0x100000)// QUOTIENT - zero on entry error
 #define LOGALPHAIGTHMPARM (0x200000)// BTA - LOGALPHAi GTH mParm
 #define LOGALOGBUILDERR   (0x400000)// Err building the log or alog table
+#define BADCODEPARM       (0x800000)// bchCodecInit - code parameter out of range
+#define AFFINEELPERR      (0x1000000)// affineElp - # roots error
+#define AFFINEFINDERR     (0x2000000)// rootFindAffine - # roots error
+#define IOVECLENERR       (0x4000000)// Data or parity segment lengths do not add up
+#define DELTARANGEERR     (0x8000000)// bchUpdateParity - changed bytes outside the data
+#define VERIFYERR         (0x10000000)// verifyCorr - locations do not match the syndromes
+#define TBLALLOCERR       (0x20000000)// bchCodecInit - no memory for the field tables
 //
 // Definition of the status bits returned by eccDecode
 #define CORR		(1)				// Correctable status
@@ -197,30 +307,181 @@ struct statAndFCnt { // Status and failing pass number
 #define EXPDERRFREE   (0x0020)		// (32) if dcdStatus>ERRFREE && statusExpd==ERRFREE
 #define EXPDERR		  (0x0040)		// (64) if dcdStatus==ERRFREE && statusExpd>ERRFREE
 #define COMPAREERR    (0X0080)      // (128)Compare error
+#define UPDPARITYERR  (0x0100)		// (256)bchUpdateParity parity differs from bchEncode
+#define UNCORRCHGD    (0x0200)		// (512)dcdStatus==UNCORR but the codeword was changed
+//
+// Finite field table entry types.  Field elements and logs are at most 16
+// bits.  The log of zero is kept in the tables as FFLOGZERO - logs of nonzero
+// elements are at most nParm-1, so 0xFFFF is free for any m up to 16.  It is
+// not logZVal (2*nParm, 17 bits when m is 16), which is the log of zero the
+// decode arithmetic uses - log sums up to 2*nParm-2 index alogTbl directly
+// and alogTbl[logZVal] is zero.  A log read from a table for an element that
+// may be zero is mapped to logZVal before it is used.
+#if MAXMPARM>16
+#error "FfLog is 16 bits - MAXMPARM must be 16 or less"
+#endif
+typedef unsigned short FfElem;
+typedef unsigned short FfLog;
+#define FFLOGZERO	(0xFFFF)	// Log of zero in logTbl and directLocTbl
+//
+// An instance of this structure holds everything that describes one binary
+// BCH code.  The finite field tables, the code generator polynomial, the encode
+// table and the code parameters are all kept here rather than in file scope
+// variables, so that several codes can be set up side by side and so that any
+// number of threads can encode and decode with the same instance at once.
+// The options are bchCodecInit inputs or compile time defaults, and nothing
+// in the structure is written after initialization.  The large tables
+// are allocated by bchCodecInit, sized to the code, and released by
+// bchCodecFree, so the structure itself is about 50 KB.  Zero an instance
+// before its first bchCodecInit (static instances are) - bchCodecInit frees
+// the tables of an earlier code first.
+struct BchCodec {
+	// Code parameters
+	int mParm,mParmOdd,nParm,tParm,kParm; // m of GF(2^m), m odd flag, n=(2^m)-1, t, k
+	int ffPoly,ffSize,logZVal;	// Field generator poly, field size, log of zero value
+	int numCodewordBytes,numDataBytes,numDataBits;
+	int numRedunBits,numRedunBytes,numRedunWords;
+	int rootFindOption;			// ROOTFINDCHIEN, BTA, SIMD, TABLE, AFFINE, TUNED or BATCH (AUTO is resolved)
+	// Finite field tables - 16 bit entries (see FfElem and FfLog),
+	// 2*ffSize and ffSize entries
+	FfElem *alogTbl;
+	FfLog *logTbl;
+	int traceTestVal,quadCompTbl[MAXMPARM];
+	// GF(2^m) kernels (see genFfKernelConsts) - ffKernelFeatures is the
+	// CPUGFNI and CPUVPCLMUL bits the batch kernels use, 0 for the log and
+	// alog tables.  ffClmulMu is x^(2m) div p(x) for the Barrett reduction
+	// of carry-less products.  ffSquareMat is squaring as GF2P8AFFINEQB
+	// matrices - [o][s] maps byte s of the operand to byte o of the result.
+	int ffKernelFlg;			// "1" - the batch kernels may use GFNI and VPCLMULQDQ
+	int ffKernelFeatures;
+	unsigned long long ffClmulMu;
+	unsigned long long ffSquareMat[2][2];
+	// Code generator polynomial and encode table
+	int cgpBitArray[MAXCORR*MAXMPARM+1],cgpDegree;
+	unsigned int cgpFdbkWords[MAXREDUNWDS];
+	// The encode and slicing table rows are numRedunWords long and packed
+	// back to back, so only the part of the tables the code uses is touched.
+	// Row b of the encode table starts at encodeTbl[b*numRedunWords].
+	unsigned int encodeTbl[BYTESTATES*MAXREDUNWDS];
+	// Slicing tables - row (d-1)*BYTESTATES+b of sliceTbl is the shift
+	// register value for byte b followed by d zero bytes.  Built for
+	// d < encodeSliceBytes.
+	int encodeSliceBytes;		// Data bytes per encode/remainder step - 1, 4 or 8
+	unsigned int *sliceTbl;
+	// Carry-less multiply folding - x^(64*clmulFoldWords) mod g(x), low word first
+	int remainderEngine;		// REMENGTABLE or REMENGCLMUL (AUTO is resolved)
+	int clmulFoldWords;
+	unsigned long long clmulFoldConst[MAXFOLDWORDS];
+	// Delta encode - row q of deltaTbl (numRedunWords words, packed) is
+	// the parity of data with only bit q set, x^(numDataBits-1-q+numRedunBits)
+	// mod g(x).  Built if deltaTblFlg and numDataBytes<=MAXDELTADATABYTES.
+	int deltaTblFlg;			// "1" - deltaTbl built, "0" - bchUpdateParity shifts
+	unsigned int *deltaTbl;
+	int encodeLanes;			// bchEncodeBatch lanes - 16 (AVX-512), 8 (AVX2) or 1
+	// Syndrome tables - synTbl[(i*BYTESTATES+b)*tParm+k] is the
+	// contribution of remainder byte i with value b to syndrome 2k+1
+	int syndromeTblFlg;			// "1" - computeSyndromesTbl, "0" - computeSyndromes
+	unsigned short *synTbl;		// numRedunBytes*BYTESTATES*tParm entries
+	// "1" - the Chien searches skip the pad bits and quit as soon as the
+	// positions left cannot hold the missing roots (see chienSearchRange)
+	int chienShortenedFlg;
+	int keyEqSolver;			// KEYEQBERMAS or KEYEQRIBM
+	int keyEqLanes;				// riBM terms per step - 64, 32 (SIMD) or 1
+	int lowWeightFlg;			// "1" - lowWeightDecode before berMas/riBM
+	// Direct decode for t<=2 (see directDecode) - directLocTbl[2e] and
+	// [2e+1] are the logs of the roots y of y^2+y=1+alpha^e, e<nParm,
+	// and [2*nParm], [2*nParm+1] those of y^2+y=1 (FFLOGZERO if none)
+	int directDecodeFlg;		// "1" - t<=2 and solveKeyEq calls directDecode
+	FfLog *directLocTbl;
+	int verifyCorrFlg;			// "1" - locateAndFix calls verifyCorr before fixErrors
+	int affineElpDeg;			// affineElp solves ELPs up to this degree (see elpStopDeg)
+	// SIMD Chien search - chienStepTbl[j][q][h] are split nibble multiply
+	// tables for alpha^(-j*chienLanes): nibble q of the operand, byte h
+	// of the product
+	int chienLanes;				// Positions per step - 64, 32, or 0 (not built)
+	unsigned char chienStepTbl[MAXCORR+1][4][2][16];
+	// The same multiplies as GF2P8AFFINEQB matrices (see ffLinearMats),
+	// built if chienLanes is 64 and ffKernelFeatures has CPUGFNI
+	unsigned long long chienStepMat[MAXCORR+1][2][2];
+	// Table Chien search - chienMultTbl[(j-1)*ffSize+x] is x*alpha^(-j*CHIENTBLPOS)
+	int chienTblBytes;			// Memory used by chienMultTbl, 0 if not built
+	unsigned short *chienMultTbl;
+	// Tuned root finding - rootFindTbl[Ln] is the root finder used for ELP
+	// degree Ln and rootFindTuneNs[Ln][option] the mean ns it took option
+	// in the calibration, -1 if not timed (see genRootFindTbl)
+	int rootFindTbl[MAXCORR+1];
+	int rootFindTuneNs[MAXCORR+1][ROOTFINDOPTIONS];
+	// Bit-sliced batch decode - odd syndrome 2k+1 is computed from the
+	// codeword modulo x^bsFoldLen[k]+x^bsFoldTap[k]+1, a multiple of its
+	// minimum polynomial (bsFoldTap[k]=0 - the binomial x^bsFoldLen[k]+1).
+	// bsSquareTbl[b] is the square of the field element with only bit b set.
+	int bitSliceFlg;			// "1" - bchDecodeBatch decodes bitSliceWords*64 CWs per pass
+	int bitSliceWords;			// 64 bit words per bit-sliced row - 8 (AVX-512), 4 (AVX2) or 1
+	int bsFoldLen[MAXCORR],bsFoldTap[MAXCORR];
+	int bsFoldRows;				// Rows in the bsFold ring - a power of 2 > the remainder rows
+	int bsSquareTbl[MAXMPARM];
+};
+//
+// An instance of this structure is the caller owned scratch space for
+// bchDecode.  Each thread that decodes must have its own instance.  On entry
+// to bchDecode the arrays do not contain useful data.  The items marked "for
+// testing only" may be deleted in a firmware product.
+struct BchScratch {
+	int Loc[MAXCORR];			// Error locations found by the root finder
+	// fixByte[i] points to the byte of the caller's data or parity span
+	// (or segment) the fix for Loc[i] was applied to and fixMask[i] is the
+	// bit flipped
+	// (if any Loc[i] is outside the codeword all fixByte[i] are 0 and
+	// nothing is flipped)
+	unsigned char *fixByte[MAXCORR];
+	unsigned char fixMask[MAXCORR];
+	int remainBytes[(MAXCORR*MAXMPARM)/8+1];
+	int syndromes[MAXNUMSYN];
+	int sigmaOrig[MAXCORR+1],LnOrig;	// For testing only
+	int berMasUCECntr,rootFindUCECntr,fixErrorsUCECntr; // For testing only
+};
+//
+// An array of these structures describes where the data or the parity bytes
+// of a codeword lie when they are not contiguous (scatter-gather, like the
+// iovec of readv and writev).  Segments are taken in array order - the data
+// segments hold the numDataBytes data bytes and the parity segments the
+// numRedunBytes redundancy bytes, first byte first.  Segments may be empty.
+struct BchIoVec {
+	unsigned char *base;		// First byte of the segment
+	int len;					// # bytes in the segment
+};
+//
+// An array of these structures describes the data bytes changed by a partial
+// rewrite of a codeword for bchUpdateParity.
+struct BchDelta {
+	int byteAddr;				// Data byte address of the first changed byte
+	int len;					// # changed bytes
+	const unsigned char *delta;	// Old value XOR new value of the changed bytes
+};
 //
-static int gblLogZVal,gblRootFindOption;
-static int gblSigmaOrig[MAXCORR+1],gblSyndromes[MAXNUMSYN];
-static int gblFFPoly,gblFFSize,gblLnOrig;
-static int gblAlogTbl[2*MAXFFSIZE],gblLogTbl[MAXFFSIZE];
+// Globals for the test code only.  The core BCH functions do not use them.
+static struct BchCodec gblCodec;
+static struct BchScratch gblScratch;
 static int gblAppliedErrLocs[MAXERRSTOSIM],gblAppliedErrVals[MAXERRSTOSIM];
-static int gblCodeword[MAXCODEWDBYTES], gblCodewordSav[MAXCODEWDBYTES];
-static int gblRemainBytes[(MAXCORR*MAXMPARM)/8+1],gblLoc[MAXCORR];
-static int gblKParm,gblMParm, gblNParm, gblMParmOdd,  gblTParm;
-static int gblNumCodewordBytes,gblNumErrsApplied;
-static int gblNumRedunBits, gblNumRedunBytes, gblNumDataBytes;
-static int gblNumDataBits,gblNumRedunWords;
-static int gblCgpBitArray[MAXCORR*MAXMPARM+1], gblCgpDegree;
+static unsigned char gblCodeword[MAXCODEWDBYTES], gblCodewordSav[MAXCODEWDBYTES];
+static unsigned char gblCodewordRcvd[MAXCODEWDBYTES]; // Codeword with the errors applied
+static int gblNumErrsApplied;
 static int gblMisCorrCnt,gblRawLoc[MAXERRSTOSIM];
-static int gblBerMasUCECntr,gblRootFindUCECntr,gblFixErrorsUCECntr;
-static int gblTraceTestVal,gblQuadCompTbl[MAXMPARM];
-static unsigned int gblCgpFdbkWords[((MAXCORR*MAXMPARM)/8+1)/4+1];
-static unsigned int gblEncodeTbl[BYTESTATES][MAXREDUNWDS];
 static unsigned int gblRandomNum;
+static const struct BchFixedCode *gblFixedCode; // Non zero - bchEval uses this BchCode
+static int gblUpdParityFlg;			// "1" - bchEval rewrites part of each CW (chkUpdateParity)
+static int gblChaseFlg,gblChaseBits; // "1" - bchEval decodes with bchDecodeChase, # flip bits
+static unsigned char gblReliab[MAXCODEWDBYTES*8]; // Bit reliabilities for bchDecodeChase
 //
 // Prototypes - If the functions are rearranged, more protypes will be required
-static int ffInv(int opa,int *pErrFlg);
-static int ffMult(int opa, int opb);
-static int ffDiv(int opa, int opb,int *pErrFlg);
+//
+// The finite field functions, the low degree ELP solvers and berMas are
+// templates on the codec type.  The runtime path passes a BchCodec, the
+// compile time specialized codes (BchCode) pass their BchCodeTbls.
+template<class Cdc> static int ffInv(const Cdc *pCdc,int opa,int *pErrFlg);
+template<class Cdc> static int ffMult(const Cdc *pCdc,int opa, int opb);
+template<class Cdc> static int ffDiv(const Cdc *pCdc,int opa, int opb,int *pErrFlg);
+static void genRootFindTbl(struct BchCodec *pCdc);
 //
 //****************************************************************
 static void randomSetSeed(unsigned int mySeed)
@@ -265,7 +526,7 @@ static unsigned int getRandom()
 	//return (((gblRandomNum+(unsigned int)rand()) & 0x7fffffffU)/2);
 	return (0x11111111);
 }
-static void pickFieldGenPoly()
+static void pickFieldGenPoly(struct BchCodec *pCdc)
 {
 	//****************************************************************
 	//	Function: pickFieldGenPoly
@@ -283,17 +544,17 @@ static void pickFieldGenPoly()
 		67, 137, 285, 529, 1033, 2053, 4179, 8219, 17475,
 		32771, 69643, 131081, 262273, 524327, 1048585
 	};
-	gblFFPoly = fieldPolyTbl[gblMParm-6]; // m = 6 table entry is at location 0
+	pCdc->ffPoly = fieldPolyTbl[pCdc->mParm-6]; // m = 6 table entry is at location 0
 #else
 	int fieldPolyTbl[] = {
 		37, 67, 137, 285, 529, 1033, 2053, 4179, 8219, 17475,
 		32771, 69643, 131081, 262273, 524327, 1048585
 	};
-	gblFFPoly = fieldPolyTbl[gblMParm-5]; // m = 5 table entry is at location 0
+	pCdc->ffPoly = fieldPolyTbl[pCdc->mParm-5]; // m = 5 table entry is at location 0
 #endif
 }
 
-static void buildLogAlogTbls()
+static void buildLogAlogTbls(struct BchCodec *pCdc)
 //****************************************************************
 //	Function: buildLogAlogTbls
 //
@@ -308,27 +569,27 @@ static void buildLogAlogTbls()
 
 	// Construct the finite field log and alog tables
 	shiftReg=1;
-	fdbkCon=(unsigned int)(gblFFPoly-gblFFSize);
-	ffSizeDivTwo=gblFFSize/2;
+	fdbkCon=(unsigned int)(pCdc->ffPoly-pCdc->ffSize);
+	ffSizeDivTwo=pCdc->ffSize/2;
 	// 9-1-10 Doubled size of alog tbl for speed
-	for (kx=0;kx<2*gblFFSize;kx++){
-		gblAlogTbl[kx] = (int)shiftReg;
-		if (kx<gblNParm){
-			gblLogTbl[shiftReg] = kx;
+	for (kx=0;kx<2*pCdc->ffSize;kx++){
+		pCdc->alogTbl[kx] = (FfElem)shiftReg;
+		if (kx<pCdc->nParm){
+			pCdc->logTbl[shiftReg] = (FfLog)kx;
 		}
 		if (shiftReg>=(unsigned int)ffSizeDivTwo){
-			shiftReg=((shiftReg<<1) & (unsigned int)gblNParm)^fdbkCon;
+			shiftReg=((shiftReg<<1) & (unsigned int)pCdc->nParm)^fdbkCon;
 		}
 		else {
 			shiftReg<<=1;
 		}
 	}
 	// 9-1-10 Changed value for log of zero
-	gblLogTbl[0]=gblLogZVal; // This is the value for log of zero
+	pCdc->logTbl[0]=FFLOGZERO; // This is the value for log of zero
 	// 9/2010 Changed next line for double size alog table
-	gblAlogTbl[gblLogZVal] = 0;
+	pCdc->alogTbl[pCdc->logZVal] = 0;
 }
-static int chkLogAlogTbls()
+static int chkLogAlogTbls(const struct BchCodec *pCdc)
 //****************************************************************
 //	Function: chkLogAlogTbls
 //
@@ -340,20 +601,21 @@ static int chkLogAlogTbls()
 	int kx;
 
 	// Check log and alog tables
-	for (kx=0;kx < gblNParm;kx++){
-		if (kx != gblLogTbl[gblAlogTbl[kx]]){
+	for (kx=0;kx < pCdc->nParm;kx++){
+		if (kx != pCdc->logTbl[pCdc->alogTbl[kx]]){
 			return(LOGALOGBUILDERR); // Flag error
 		}
 	}
 	// Next line changed 9-5-10 for double size alog table
-	if (gblLogTbl[0]!=gblLogZVal || gblAlogTbl[gblLogZVal] != 0){
+	if (pCdc->logTbl[0]!=FFLOGZERO || pCdc->alogTbl[pCdc->logZVal] != 0){
 		return(LOGALOGBUILDERR); // Flag error
 	}
 	return(ZERO);
 }
 
 
-static int ffSquareRoot(int opa)
+template<class Cdc>
+static int ffSquareRoot(const Cdc *pCdc,int opa)
 {
 	//****************************************************************
 	//	Function: ffSquareRoot
@@ -370,15 +632,16 @@ static int ffSquareRoot(int opa)
 	}
 	else
 	{
-		logtmp=gblLogTbl[opa];
+		logtmp=pCdc->logTbl[opa];
 		if (logtmp%2==1){
-			logtmp=logtmp+gblNParm;
+			logtmp=logtmp+pCdc->nParm;
 		}
-		return(gblAlogTbl[logtmp/2]);
+		return(pCdc->alogTbl[logtmp/2]);
 	}
 }
 
-static int ffCubeRoot(int opa, int *pErrFlg)
+template<class Cdc>
+static int ffCubeRoot(const Cdc *pCdc,int opa, int *pErrFlg)
 {
 	//****************************************************************
 	//	Function: ffCubeRoot
@@ -398,48 +661,48 @@ static int ffCubeRoot(int opa, int *pErrFlg)
 	}
 	else
 	{
-		logtmp=gblLogTbl[opa];
+		logtmp=pCdc->logTbl[opa];
 		if (logtmp%3 != 0) {
 			*pErrFlg|=E1CROOT; // Or error into location pointed to
 		}
-		return(gblAlogTbl[logtmp/3]);
+		return(pCdc->alogTbl[logtmp/3]);
 	}
 }
-static void genTraceTestVal()
+static void genTraceTestVal(struct BchCodec *pCdc)
 {
 	//****************************************************************
 	// Function: genTraceTestVal
 	//
-	// Function to compute a trace test value (gblTraceTestVal).
+	// Function to compute a trace test value (traceTestVal).
 	// This function is called at initialization
 	// time only.  This value is used in fast root
 	// finding.
 	//
 	// The trace test value is computed by computing
 	// the trace of the first "m" elements of the field.
-	// Let k be a number between 0 and gblNParm-1 then bit k
-	// of the gblTraceTestVal will be "1" if the trace of alpha^k
+	// Let k be a number between 0 and nParm-1 then bit k
+	// of the traceTestVal will be "1" if the trace of alpha^k
 	// is one and "0" otherwise.
 	//****************************************************************
 	int shifter,x,jx,kx,sum;
 
-	gblTraceTestVal=0;
+	pCdc->traceTestVal=0;
 	shifter=1;
-	for (jx=0;jx<gblMParm;jx++){ // Compute trace for alpha^jx
-		x=gblAlogTbl[jx]; // x is element for which trace will be computed
+	for (jx=0;jx<pCdc->mParm;jx++){ // Compute trace for alpha^jx
+		x=pCdc->alogTbl[jx]; // x is element for which trace will be computed
 		sum=0;
-		for (kx=0;kx<gblMParm;kx++){ // This is the trace computing loop
+		for (kx=0;kx<pCdc->mParm;kx++){ // This is the trace computing loop
 			sum^=x;
-			x=ffMult(x,x);
+			x=ffMult(pCdc,x,x);
 		}
 		if (sum==1){
-			gblTraceTestVal=gblTraceTestVal^shifter; // Set appropriate bit if trace is "1"
+			pCdc->traceTestVal=pCdc->traceTestVal^shifter; // Set appropriate bit if trace is "1"
 		}
 		shifter*=2;
 	}
 }
 
-static void genQuadCompTbl()
+static void genQuadCompTbl(struct BchCodec *pCdc)
 {
 	//****************************************************************
 	//	Function: genQuadCompTbl
@@ -447,9 +710,9 @@ static void genQuadCompTbl()
 	//	Function to find a list of components of y to be used
 	//	in finding solutions to Y^2+y+c using a table of
 	//  linear components. This function is called at initialization
-	//  time only.  This solution uses a small table with gblMParm
+	//  time only.  This solution uses a small table with mParm
 	//  entries.  A large table would be faster but would
-	//  require 2^gblMParm entries.  It is possible to have an inbetween
+	//  require 2^mParm entries.  It is possible to have an inbetween
 	//  solution that uses two moderate size tables and is faster than
 	//  this small table solution but not as fast as the one large table
 	//  solution.  The reference for this solution is Dr. Berlekamp's 1968
@@ -460,7 +723,7 @@ static void genQuadCompTbl()
 	//  trace = "1". The second loop searches for each element in the
 	//  table within a set of solutions for
 	//  y^2+y=c and if it finds one then it stores the associated
-	//  value of y in the gblQuadCompTbl.
+	//  value of y in the quadCompTbl.
 	//****************************************************************
 	int c,y,kx,shifter,searchTbl[MAXMPARM],firstTraceOne;
 
@@ -469,9 +732,9 @@ static void genQuadCompTbl()
 	// single "1" bit or the xor of such a pattern with a fixed pattern of an
 	// element with trace = "1"
 	shifter=1;
-	for (kx=0;kx<gblMParm;kx++){
+	for (kx=0;kx<pCdc->mParm;kx++){
 		searchTbl[kx]=0;
-		if ((gblTraceTestVal&shifter)>0){
+		if ((pCdc->traceTestVal&shifter)>0){
 			if (firstTraceOne>0){
 				searchTbl[kx]=shifter^firstTraceOne;
 			}
@@ -484,23 +747,24 @@ static void genQuadCompTbl()
 		}
 		shifter*=2;
 	}
-	for (kx=0;kx<gblMParm;kx++){
-		gblQuadCompTbl[kx]=0; // Clear table
+	for (kx=0;kx<pCdc->mParm;kx++){
+		pCdc->quadCompTbl[kx]=0; // Clear table
 	}
 	// This loop will search for each "c" of y^2+y = c that has a single bit
 	// or is the xor of such a pattern with a fixed pattern of an
 	// element with trace = "1"
-	for (y=0;y<gblFFSize;y+=2){//Incr of 2 may not work with another basis
-		c=ffMult(y,y)^y;
-		for (kx=0;kx<gblMParm;kx++){
+	for (y=0;y<pCdc->ffSize;y+=2){//Incr of 2 may not work with another basis
+		c=ffMult(pCdc,y,y)^y;
+		for (kx=0;kx<pCdc->mParm;kx++){
 			if (c==searchTbl[kx]){
-				gblQuadCompTbl[kx]=y;
+				pCdc->quadCompTbl[kx]=y;
 			}
 		}
 	}
 }
 
-static int ffQuadFun(int c)
+template<class Cdc>
+static int ffQuadFun(const Cdc *pCdc,int c)
 {
 	//****************************************************************
 	// Function: ffQuadFun
@@ -525,13 +789,13 @@ static int ffQuadFun(int c)
 	int kx,y1,shifter,parityWord,parityBit;
 
 	// "c" is "c" of y^2+y=c.  Given "c" we want one solution (y1) of y^2+y=c
-	parityWord=gblTraceTestVal & c;  // Get bits that parity is to be checked on
+	parityWord=pCdc->traceTestVal & c;  // Get bits that parity is to be checked on
 	parityBit=0;
 	y1=0;
 	shifter=1;
-	for (kx=0;kx<gblMParm;kx++){
+	for (kx=0;kx<pCdc->mParm;kx++){
 		if ((c & shifter)>0){
-			y1^=gblQuadCompTbl[kx];// XOR values from the quadratic component table
+			y1^=pCdc->quadCompTbl[kx];// XOR values from the quadratic component table
 		}
 		if ((parityWord & shifter)>0){
 			parityBit ^= 1; // Accumulate parity to get trace of "c"
@@ -546,16 +810,16 @@ static int ffQuadFun(int c)
 	}
 }
 
-static void bchInit()
+static void bchInit(struct BchCodec *pCdc)
 {
 	//****************************************************************
 	//	Function: bchInit
 	//
 	//	Function to do initialization computations.
 	//****************************************************************
-	buildLogAlogTbls();
-	genTraceTestVal();
-	genQuadCompTbl();
+	buildLogAlogTbls(pCdc);
+	genTraceTestVal(pCdc);
+	genQuadCompTbl(pCdc);
 }
 
 static void linearElp(const int sigmaN[],int Loc[])
@@ -569,7 +833,8 @@ static void linearElp(const int sigmaN[],int Loc[])
 	Loc[0]=sigmaN[1];
 }
 
-static int quadraticElp(const int sigmaN[],int Loc[])
+template<class Cdc>
+static int quadraticElp(const Cdc *pCdc,const int sigmaN[],int Loc[])
 {
 	//****************************************************************
 	//	Function:  quadraticElp
@@ -589,20 +854,21 @@ static int quadraticElp(const int sigmaN[],int Loc[])
 	if (sigmaN[1]==0){
 		errFlg|=E1QUADRATIC;
 	}
-	c=ffDiv(sigmaN[2],ffMult(sigmaN[1],sigmaN[1]),&errFlg);
-	y1=ffQuadFun(c);
+	c=ffDiv(pCdc,sigmaN[2],ffMult(pCdc,sigmaN[1],sigmaN[1]),&errFlg);
+	y1=ffQuadFun(pCdc,c);
 	if (y1==0){
 		errFlg|=E2QUADRATIC;
 	}
 	// In next line, if ever use basis other than poly then "1" may have
 	// to change to alog[0]
 	y2=y1^1;
-	Loc[0]=ffMult(sigmaN[1],y1);
-	Loc[1]=ffMult(sigmaN[1],y2);
+	Loc[0]=ffMult(pCdc,sigmaN[1],y1);
+	Loc[1]=ffMult(pCdc,sigmaN[1],y2);
 	return (errFlg);  // Return error flag
 }
 
-static int cubicElp(int nParm, const int sigmaN[],int Loc[],const int alogTbl[])
+template<class Cdc>
+static int cubicElp(const Cdc *pCdc,const int sigmaN[],int Loc[])
 {
 	//****************************************************************
 	//	Function:	cubicElp
@@ -629,16 +895,16 @@ static int cubicElp(int nParm, const int sigmaN[],int Loc[],const int alogTbl[])
 
 	errFlg=0;
 	// n for numerator, d for denominator
-	n=sigmaN[2]^ffMult(sigmaN[1],sigmaN[1]);
-	d=sigmaN[3]^ffMult(sigmaN[1],sigmaN[2]);
+	n=sigmaN[2]^ffMult(pCdc,sigmaN[1],sigmaN[1]);
+	d=sigmaN[3]^ffMult(pCdc,sigmaN[1],sigmaN[2]);
 	// Note to Neal.  The error check on the next line is
 	// redundant. This error would also get caught in "ffDiv" function.
 	if (d==0){
 		errFlg|=E1CUBIC; // Divide by "0" error
 	}
-	n3=ffMult(n,ffMult(n,n)); // Numerator cubed
-	d2=ffMult(d,d);           // Denominator squared
-	c=ffDiv(n3,d2,&errFlg);   // Finite field divide
+	n3=ffMult(pCdc,n,ffMult(pCdc,n,n)); // Numerator cubed
+	d2=ffMult(pCdc,d,d);           // Denominator squared
+	c=ffDiv(pCdc,n3,d2,&errFlg);   // Finite field divide
 	// Note to Neal.  ######## I think I put in the next decision
 	// during debug in 1999.  The code could be extensively tested
 	// without this decision to see if it can be left out.
@@ -648,24 +914,25 @@ static int cubicElp(int nParm, const int sigmaN[],int Loc[],const int alogTbl[])
 	else
 	{
 		// The quad function is equiv to fetching from large table
-		v1=ffQuadFun(c);
+		v1=ffQuadFun(pCdc,c);
 		if (v1==0){
 			errFlg|=E2CUBIC;
 		}
-		u1=ffMult(v1,d);
+		u1=ffMult(pCdc,v1,d);
 	}
 	// Roots of transformed cubic
-	t1=ffCubeRoot(u1,&errFlg);
-	t2=ffMult(t1,alogTbl[nParm/3]); // nParm/3 is 85 for gf(2^8)
+	t1=ffCubeRoot(pCdc,u1,&errFlg);
+	t2=ffMult(pCdc,t1,pCdc->alogTbl[pCdc->nParm/3]); // nParm/3 is 85 for gf(2^8)
 	t3=t1^t2; // Equivalent to t2= line with nParm replaced by 2*nParm
 	// Roots of original cubic
-	Loc[0]=sigmaN[1]^t1^ffDiv(n,t1,&errFlg);
-	Loc[1]=sigmaN[1]^t2^ffDiv(n,t2,&errFlg);
-	Loc[2]=sigmaN[1]^t3^ffDiv(n,t3,&errFlg);
+	Loc[0]=sigmaN[1]^t1^ffDiv(pCdc,n,t1,&errFlg);
+	Loc[1]=sigmaN[1]^t2^ffDiv(pCdc,n,t2,&errFlg);
+	Loc[2]=sigmaN[1]^t3^ffDiv(pCdc,n,t3,&errFlg);
 	return (errFlg);  // Return error flag
 }
 
-static int quarticElp(int nParm,int sigmaN[],int Loc[],const int alogTbl[])
+template<class Cdc>
+static int quarticElp(const Cdc *pCdc,int sigmaN[],int Loc[])
 {
 	//****************************************************************
 	//	Function:	quarticElp
@@ -716,14 +983,14 @@ static int quarticElp(int nParm,int sigmaN[],int Loc[],const int alogTbl[])
 	else
 	{
 		// ---------- Step b of the Deodhar-Weldon paper ----------
-		b4n=ffMult(sigbk[1],sigbk[1]);
-		b4d=ffMult(sigbk[3],sigbk[3])
-			^ffMult(sigbk[1],ffMult(sigbk[2],sigbk[3]))
-			^ffMult(sigbk[4],b4n);
-		b4=ffDiv(b4n,b4d,&errFlg);
-		b3=ffMult(sigbk[1],b4);
-		b2=ffMult(b4,
-			ffSquareRoot(ffMult(sigbk[1],sigbk[3]))^sigbk[2]);
+		b4n=ffMult(pCdc,sigbk[1],sigbk[1]);
+		b4d=ffMult(pCdc,sigbk[3],sigbk[3])
+			^ffMult(pCdc,sigbk[1],ffMult(pCdc,sigbk[2],sigbk[3]))
+			^ffMult(pCdc,sigbk[4],b4n);
+		b4=ffDiv(pCdc,b4n,b4d,&errFlg);
+		b3=ffMult(pCdc,sigbk[1],b4);
+		b2=ffMult(pCdc,b4,
+			ffSquareRoot(pCdc,ffMult(pCdc,sigbk[1],sigbk[3]))^sigbk[2]);
 	}
 	// ---------- Step c of the Deodhar-Weldon paper ----------
 	//	Set up a cubic and find its 3 roots.
@@ -731,41 +998,277 @@ static int quarticElp(int nParm,int sigmaN[],int Loc[],const int alogTbl[])
 	sigmaN[1]=0;
 	sigmaN[2]=b2;
 	sigmaN[3]=b3;
-	errFlg|=cubicElp(nParm,sigmaN,Loc,alogTbl);
+	errFlg|=cubicElp(pCdc,sigmaN,Loc);
 	qq=Loc[1];
 	// ---------- Step d of the Deodhar-Weldon paper ----------
 	//	Set up a quadratic and find its two roots
 	sigmaN[0]=1;
-	sigmaN[1]=ffDiv(b3,qq,&errFlg);
+	sigmaN[1]=ffDiv(pCdc,b3,qq,&errFlg);
 	sigmaN[2]=b4;
-	errFlg|=quadraticElp(sigmaN,Loc);
+	errFlg|=quadraticElp(pCdc,sigmaN,Loc);
 	ss=Loc[0];
 	tt=Loc[1];
 	//	First 2 roots of quartic
 	sigmaN[0]=1;
 	sigmaN[1]=qq;
 	sigmaN[2]=ss;
-	errFlg|=quadraticElp(sigmaN,Loc);
+	errFlg|=quadraticElp(pCdc,sigmaN,Loc);
 	Loc[2]=Loc[0];
 	Loc[3]=Loc[1];
 	//	Last 2 roots of quartic
 	sigmaN[0]=1;
 	sigmaN[1]=qq;
 	sigmaN[2]=tt;
-	errFlg|=quadraticElp(sigmaN,Loc);
+	errFlg|=quadraticElp(pCdc,sigmaN,Loc);
 	//	Skip inverse substitution if special case
 	if (sigbk[1]!=0){
 		// ---------- Step e of the Deodhar-Weldon paper ----------
 		//	Do inverse substitution
-		tmp=ffSquareRoot(ffDiv(sigbk[3],sigbk[1],&errFlg));
+		tmp=ffSquareRoot(pCdc,ffDiv(pCdc,sigbk[3],sigbk[1],&errFlg));
 		for (n=0;n<4;n++){
-			Loc[n]=ffInv(Loc[n],&errFlg)^tmp;
+			Loc[n]=ffInv(pCdc,Loc[n],&errFlg)^tmp;
+		}
+	}
+	return (errFlg);  // Return error flag
+}
+
+template<class Cdc>
+static int affineElp(const Cdc *pCdc,const int sigmaN[],int Loc[],const int Ln)
+{
+	//****************************************************************
+	//	Function:	affineElp
+	//
+	//	Function to find the roots of a degree three to six error
+	//  locator polynomial (ELP), "m" odd or even.  This is the affine
+	//  multiple method of chapter 11 of Dr. Berlekamp's 1968 "Algebraic
+	//  Coding Theory" book.  The roots of the ELP are also roots of
+	//  its lowest degree affine multiple
+	//
+	//      A(z)=z^(2^k)+a(k-1)*z^(2^(k-1))+...+a(0)*z+c
+	//
+	//  A(z) is found by reducing z, z^2, z^4, ... mod the ELP until
+	//  one of them is a combination of "1" and the ones before it.
+	//  k is at most Ln-1.  A(z)+c is linear over GF(2), so the m by m
+	//  bit matrix of A(z)+c is built from the images of the m bits of z
+	//  and A(z)=0 is solved by Gaussian elimination.  Each of the 2^k
+	//  or fewer solutions (32 for a sextic) is tried in the ELP.  The
+	//  cost does not depend on the codeword length, which is what
+	//  makes stopping the Chien search and BTA at degree six pay.
+	//
+	//  The error flag is set unless exactly Ln roots are found.
+	//****************************************************************
+	int ix,jx,kx,numVec,numKer,z,x,y,pv,fac,accum,numRoots,errFlg;
+	int f[MAXAFFINEDEG+1],sq[2*MAXAFFINEDEG];
+	int vec[MAXAFFINEDEG+1],red[MAXAFFINEDEG+1][MAXAFFINEDEG];
+	int comb[MAXAFFINEDEG+1][MAXAFFINEDEG+1],piv[MAXAFFINEDEG+1];
+	int v[MAXAFFINEDEG],cb[MAXAFFINEDEG+1];
+	int basisV[MAXMPARM],basisX[MAXMPARM],ker[MAXMPARM];
+
+	errFlg=0;
+	if (Ln<3 || Ln>MAXAFFINEDEG){
+		return (AFFINEELPERR);
+	}
+	// Roots of the ELP are the roots of f(z)=z^Ln+sigma1*z^(Ln-1)+...+sigmaLn
+	for (ix=0;ix<=Ln;ix++){
+		f[ix]=sigmaN[Ln-ix];
+	}
+	// ---------- Find the affine multiple ----------
+	// Vector 0 is "1", vector j>0 is z^(2^(j-1)) mod f.  Each new
+	// vector is reduced by the ones kept so far (pivot scaled to "1")
+	// and comb tracks it as a combination of the original vectors.
+	for (ix=0;ix<Ln;ix++){
+		v[ix]=0;
+	}
+	v[0]=1;
+	numVec=0;
+	for (jx=0;jx<=Ln;jx++){
+		if (jx==1){
+			v[0]=0; // z
+			v[1]=1;
+		}
+		else if (jx>1){
+			// Square vector jx-1 and reduce mod f
+			for (ix=0;ix<2*Ln-1;ix++){
+				sq[ix]=0;
+			}
+			for (ix=0;ix<Ln;ix++){
+				sq[2*ix]=ffMult(pCdc,vec[ix],vec[ix]);
+			}
+			for (ix=2*Ln-2;ix>=Ln;ix--){
+				if (sq[ix]!=0){
+					for (kx=0;kx<Ln;kx++){
+						sq[ix-Ln+kx]^=ffMult(pCdc,sq[ix],f[kx]);
+					}
+				}
+			}
+			for (ix=0;ix<Ln;ix++){
+				v[ix]=sq[ix];
+			}
+		}
+		for (ix=0;ix<Ln;ix++){
+			vec[ix]=v[ix]; // Unreduced copy to square next pass
+		}
+		for (ix=0;ix<=Ln;ix++){
+			cb[ix]=0;
+		}
+		cb[jx]=1;
+		for (kx=0;kx<numVec;kx++){
+			fac=v[piv[kx]];
+			if (fac!=0){
+				for (ix=0;ix<Ln;ix++){
+					v[ix]^=ffMult(pCdc,fac,red[kx][ix]);
+				}
+				for (ix=0;ix<=jx;ix++){
+					cb[ix]^=ffMult(pCdc,fac,comb[kx][ix]);
+				}
+			}
+		}
+		pv=-1;
+		for (ix=0;ix<Ln;ix++){
+			if (v[ix]!=0){
+				pv=ix;
+				break;
+			}
+		}
+		if (pv<0){
+			break; // cb(0)+cb(1)*z+...+cb(jx)*z^(2^(jx-1)) is 0 mod f
+		}
+		fac=ffInv(pCdc,v[pv],&errFlg);
+		for (ix=0;ix<Ln;ix++){
+			red[numVec][ix]=ffMult(pCdc,fac,v[ix]);
+		}
+		for (ix=0;ix<=Ln;ix++){
+			comb[numVec][ix]=ffMult(pCdc,fac,cb[ix]);
+		}
+		piv[numVec]=pv;
+		numVec++;
+	}
+	if (jx>Ln){
+		return (errFlg|AFFINEELPERR); // Cannot happen - Ln+1 vectors of length Ln
+	}
+	// ---------- Solve A(z)=0 over GF(2) ----------
+	// Column b of the bit matrix is A(z)+c for z with only bit b set.
+	// Columns are reduced against the ones before; a column that
+	// reduces to zero gives a kernel vector.
+	for (ix=0;ix<pCdc->mParm;ix++){
+		basisV[ix]=0;
+	}
+	numKer=0;
+	for (ix=0;ix<pCdc->mParm;ix++){
+		z=1<<ix;
+		y=0;
+		for (kx=1;kx<=jx;kx++){
+			y^=ffMult(pCdc,cb[kx],z);
+			z=ffMult(pCdc,z,z);
+		}
+		x=1<<ix;
+		for (kx=pCdc->mParm-1;kx>=0 && y!=0;kx--){
+			if ((y>>kx)&1){
+				if (basisV[kx]==0){
+					break;
+				}
+				y^=basisV[kx];
+				x^=basisX[kx];
+			}
+		}
+		if (y==0){
+			ker[numKer++]=x;
+		}
+		else{
+			basisV[kx]=y;
+			basisX[kx]=x;
+		}
+	}
+	// Particular solution of A(z)+c=c
+	y=cb[0];
+	z=0;
+	for (kx=pCdc->mParm-1;kx>=0 && y!=0;kx--){
+		if ((y>>kx)&1){
+			if (basisV[kx]==0){
+				return (errFlg|AFFINEELPERR); // No roots
+			}
+			y^=basisV[kx];
+			z^=basisX[kx];
+		}
+	}
+	// ---------- Try each solution in the ELP ----------
+	// Gray code walk of the kernel so each step is one XOR
+	numRoots=0;
+	for (ix=0;ix<(1<<numKer);ix++){
+		if (ix>0){
+			for (kx=0;((ix>>kx)&1)==0;kx++){
+			}
+			z^=ker[kx];
 		}
+		accum=1;
+		for (kx=1;kx<=Ln;kx++){
+			accum=ffMult(pCdc,accum,z)^sigmaN[kx];
+		}
+		if (accum==0 && z!=0){
+			if (numRoots==Ln){
+				return (errFlg|AFFINEELPERR);
+			}
+			Loc[numRoots++]=z;
+		}
+	}
+	if (numRoots!=Ln){
+		errFlg|=AFFINEELPERR;
 	}
 	return (errFlg);  // Return error flag
 }
 
-static int genCodeGenPoly()
+template<class Cdc>
+static int elpStopDeg(const Cdc *pCdc)
+{
+	//****************************************************************
+	//	Function:	elpStopDeg
+	//
+	//	Returns the highest error locator polynomial (ELP) degree that
+	//  lowDegreeElp solves directly.  The Chien searches divide the ELP
+	//  down to this degree and BTA stops splitting factors there.
+	//****************************************************************
+	int stopDeg;
+
+	stopDeg=(pCdc->mParmOdd==0) ? 4 : 2;
+	if (pCdc->affineElpDeg>stopDeg){
+		stopDeg=pCdc->affineElpDeg;
+	}
+	return (stopDeg);
+}
+
+template<class Cdc>
+static int lowDegreeElp(const Cdc *pCdc,int sigmaN[],int Loc[],const int Ln)
+{
+	//****************************************************************
+	//	Function:	lowDegreeElp
+	//
+	//	Finds the roots of an error locator polynomial (ELP) of degree
+	//  one to elpStopDeg.  The closed forms are used where they exist,
+	//  the cubic and quartic ones only for "m" even.  The other degrees
+	//  go to affineElp.  sigmaN may be changed.
+	//****************************************************************
+	int errFlg;
+
+	errFlg=0;
+	if (Ln==1){
+		linearElp(sigmaN,Loc); // No status returned - no errs detected in function
+	}
+	else if (Ln==2){
+		errFlg=quadraticElp(pCdc,sigmaN,Loc);
+	}
+	else if (Ln==3 && pCdc->mParmOdd==0){
+		errFlg=cubicElp(pCdc,sigmaN,Loc);
+	}
+	else if (Ln==4 && pCdc->mParmOdd==0){
+		errFlg=quarticElp(pCdc,sigmaN,Loc);
+	}
+	else if (Ln>2){
+		errFlg=affineElp(pCdc,sigmaN,Loc,Ln);
+	}
+	return (errFlg);
+}
+
+static int genCodeGenPoly(struct BchCodec *pCdc)
 {
 	//****************************************************************
 	//	Function: genCodeGenPoly
@@ -809,49 +1312,49 @@ static int genCodeGenPoly()
 	int flg[MAXFFSIZE], tmp[MAXCORR*MAXMPARM+1];
 	int	kx, root, rootBase, wk, errFlg; // root and rootBase are in log form
 
-	for (kx=0;kx<gblFFSize;kx++){
+	for (kx=0;kx<pCdc->ffSize;kx++){
 		flg[kx]=0;// Index to flg can have values root,2*root,4*root,8*root...
 	}
-	for (kx=0;kx<=gblMParm*gblTParm;kx++){
-		gblCgpBitArray[kx]=0;// Initialize
+	for (kx=0;kx<=pCdc->mParm*pCdc->tParm;kx++){
+		pCdc->cgpBitArray[kx]=0;// Initialize
 		tmp[kx]=0;			 // Initialize
 	}
-	gblCgpDegree=0; // The degree of the code generator poly is initialized to "0"
-	gblCgpBitArray[0]=1; // Now the initial code generator poly is "1" (degree "0")
+	pCdc->cgpDegree=0; // The degree of the code generator poly is initialized to "0"
+	pCdc->cgpBitArray[0]=1; // Now the initial code generator poly is "1" (degree "0")
 	errFlg=0;
-	for (rootBase=1;rootBase<=2*gblTParm-1;rootBase += 2){ // alpha 1,3,5,7 etc.
+	for (rootBase=1;rootBase<=2*pCdc->tParm-1;rootBase += 2){ // alpha 1,3,5,7 etc.
 		if (flg[rootBase] == 0){ // If this root not already processed
 			root = rootBase;
 			for(;;){ // Infinite loop - Exit is by "break"
 				// In loop - root will take values like 1,2,4,8... 3,6,12,24...etc
-				if (gblCgpDegree+1>gblMParm*gblTParm){
+				if (pCdc->cgpDegree+1>pCdc->mParm*pCdc->tParm){
 					errFlg=CGPFATAL;  // Fatal problem of some type
 					break;
 				}
-				// Start multiply this factor times current gblCgpBitArray
+				// Start multiply this factor times current cgpBitArray
 				// Intermediate poly products will have some values greater than one
 				// The coefficients of the final product will have values 0 or 1 only.
 				// Multiply code gen poly by (X - alpha^root)
-				for (kx=gblCgpDegree+1;kx>=1;kx--){
+				for (kx=pCdc->cgpDegree+1;kx>=1;kx--){
 					// Shift poly 1 place (low to high)
-					tmp[kx]=gblCgpBitArray[kx-1];
+					tmp[kx]=pCdc->cgpBitArray[kx-1];
 				}
 				tmp[0]=0;
-				gblCgpDegree++;
-				for (kx=gblCgpDegree;kx>=0;kx--){
-					if (gblCgpBitArray[kx]>0){
-						wk=ffMult(gblCgpBitArray[kx],gblAlogTbl[root]);
-						gblCgpBitArray[kx]=tmp[kx]^wk;
+				pCdc->cgpDegree++;
+				for (kx=pCdc->cgpDegree;kx>=0;kx--){
+					if (pCdc->cgpBitArray[kx]>0){
+						wk=ffMult(pCdc,pCdc->cgpBitArray[kx],pCdc->alogTbl[root]);
+						pCdc->cgpBitArray[kx]=tmp[kx]^wk;
 					}
 					else {
-						gblCgpBitArray[kx]=tmp[kx]; // Move the shifted version of cgp
+						pCdc->cgpBitArray[kx]=tmp[kx]; // Move the shifted version of cgp
 					}
 				}
 				// End multiply
 				flg[root] = 1;
 				root *= 2; // root is in finite field log form
-				if (root>=gblNParm){			//
-					root -= gblNParm; // These 3 lines do a fast mod op
+				if (root>=pCdc->nParm){			//
+					root -= pCdc->nParm; // These 3 lines do a fast mod op
 				}							//
 				if (root == rootBase){
 					break;
@@ -861,7 +1364,7 @@ static int genCodeGenPoly()
 	} // end for
 	return(errFlg);
 } // end function
-static void cvtCgpBitToCgpWord()
+static void cvtCgpBitToCgpWord(struct BchCodec *pCdc)
 {
 	//****************************************************************
 	//	Function: cvtCgpBitToCgpWord
@@ -876,17 +1379,17 @@ static void cvtCgpBitToCgpWord()
 	int nnn, kkk, wordAddr;
 	unsigned int bitMask;
 
-	// Convert gblCgpBitArray to cgpWordArray
+	// Convert cgpBitArray to cgpWordArray
 	// That is, 1 bit per word to 32 bits per word
-	for (nnn=0; nnn < gblNumRedunWords;nnn++){
-		gblCgpFdbkWords[nnn] = 0; // Clear fdbk array
+	for (nnn=0; nnn < pCdc->numRedunWords;nnn++){
+		pCdc->cgpFdbkWords[nnn] = 0; // Clear fdbk array
 	}
 	wordAddr = 0;
 	bitMask =0x80000000;
 	// Place the code generator poly in the ints
-	for (kkk=gblNumRedunBits-1;kkk>=0;kkk--){
-		if (gblCgpBitArray[kkk]>0){
-			gblCgpFdbkWords[wordAddr] ^= bitMask;
+	for (kkk=pCdc->numRedunBits-1;kkk>=0;kkk--){
+		if (pCdc->cgpBitArray[kkk]>0){
+			pCdc->cgpFdbkWords[wordAddr] ^= bitMask;
 		}
 		bitMask >>= 1; // bitMask must be unsigned
 		if (bitMask ==0){
@@ -896,1701 +1399,7179 @@ static void cvtCgpBitToCgpWord()
 	}
 }
 
-static void genEncodeTbls()
+#if BCHX86SIMD
+static void cpuId(unsigned int leaf,unsigned int regs[4])
 {
 	//****************************************************************
-	//	Function: genEncodeTbls
-	//
-	//  Function to generate encode tables.  The encode tables allow
-	//  8 bits of data to be processed at a time.  A Left shifting shift
-	//  reg is implemented in multiple 32-bit words.  A multiple word
-	//  shift register value is stored in the table for each possible
-	//  value of a byte.  A byte value is placed in the left most
-	//  (high order position of lowest address word).  Then the shift
-	//  register is shifted 8 times with feedback.  Then the multiple
-	//  word shift register value is stored in the table at the addr
-	//  specified by the byte.
+	//	Function: cpuId
 	//
-	//  The feedback words are highest order in lowest address and the
-	//  resulting encode table is organized the same way.
+	//	Executes CPUID for a leaf (sub-leaf 0).  regs gets EAX,EBX,ECX,EDX.
 	//****************************************************************
-	unsigned int iii,fdbk,fdbkSav,SR[MAXREDUNWDS];
-	int jjj,nnn;
+#ifdef _MSC_VER
+	int cpuInfo[4];
 
-	// Gen Encode Table
-	for (iii = 0;iii<BYTESTATES;iii++){ // Encoding is 8 bits parallel
-		for (jjj=0; jjj < gblNumRedunWords;jjj++){ // Clear shift register
-			SR[jjj] = 0;
-		}
-		SR[0] ^= (iii << 24);
-		for (jjj = 0;jjj<=7;jjj++){// 7 is the # of bits in a byte -1
-			fdbk = 0;
-			for (nnn=gblNumRedunWords-1; nnn >=0;nnn--){
-				fdbkSav = fdbk;
-				if (SR[nnn] & 0x80000000){
-					fdbk = 1;
-				}
-				else {
-					fdbk = 0;
-				}
-				SR[nnn] <<= 1;
-				SR[nnn] ^= fdbkSav;
-			}
-			if (fdbk == 1){
-				for (nnn=0; nnn < gblNumRedunWords;nnn++){
-					SR[nnn] ^= gblCgpFdbkWords[nnn];
-				}
-			}
-		}
-		for (nnn=0; nnn < gblNumRedunWords;nnn++){
-			gblEncodeTbl[iii][nnn] = SR[nnn];  // Move SR to encode table
-		}
-	}
+	__cpuidex(cpuInfo,(int)leaf,0);
+	regs[0]=(unsigned int)cpuInfo[0];
+	regs[1]=(unsigned int)cpuInfo[1];
+	regs[2]=(unsigned int)cpuInfo[2];
+	regs[3]=(unsigned int)cpuInfo[3];
+#else
+	regs[0]=regs[1]=regs[2]=regs[3]=0;
+	(void)__get_cpuid_count(leaf,0,&regs[0],&regs[1],&regs[2],&regs[3]);
+#endif
 }
 
-static void clearWriteCW()
+static unsigned int osSavedStates()
 {
 	//****************************************************************
-	//	Function: clearWriteCW
+	//	Function: osSavedStates
 	//
-	//	Function to clear write data.
+	//	Returns the low word of XCR0 - the register states the OS saves.
+	//  Only call this if CPUID reports OSXSAVE.
 	//****************************************************************
-	int kx;
+#ifdef _MSC_VER
+	return((unsigned int)_xgetbv(0));
+#else
+	unsigned int eax,edx;
 
-	// Clears gblCodeword including pad bits
-	for (kx=0;kx<gblNumCodewordBytes;kx++){
-		gblCodeword[kx] = 0; // Clear gblCodeword
-	}
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return(eax);
+#endif
 }
+#endif
 
-static void genWriteData()
+static int cpuFeatures()
 {
 	//****************************************************************
-	//	Function: genWriteData
+	//	Function: cpuFeatures
 	//
-	//	Function to generate random data byte values for encoding.  No
-	//  Matter what size of finite field we are using, the encoder
-	//  operates on bytes in byte parallel.
+	//	Returns the CPU feature bits (CPUPCLMUL etc.) that the program
+	//  was built to use and that the CPU supports.  AVX2 and AVX-512
+	//  also require that the OS saves the wider registers.
 	//****************************************************************
-	int kx;
+	int features;
+#if BCHX86SIMD
+	unsigned int regs[4],xcr0;
 
-	// Clear gblCodeword including pad bits
-	for (kx=0;kx<gblNumCodewordBytes;kx++){
-		gblCodeword[kx] = 0; // Clear gblCodeword
+	features=0;
+	cpuId(0,regs);
+	if (regs[0]<1){
+		return(0);
 	}
-	// Put random user data in gblCodeword - there are no pad bits in user data
-	for (kx=0;kx<gblNumDataBytes;kx++){
-		gblCodeword[kx] = (getRandom() % BYTESTATES);// Reduce random # to byte size
+	cpuId(1,regs);
+	if ((regs[2] >> 1) & 1){ // ECX bit 1 - PCLMULQDQ
+		features|=CPUPCLMUL;
+	}
+	if (((regs[2] >> 27) & 1)==0){ // ECX bit 27 - OSXSAVE
+		return(features);
 	}
+	xcr0=osSavedStates();
+	cpuId(0,regs);
+	if (regs[0]<7){
+		return(features);
+	}
+	cpuId(7,regs);
+	if (((regs[1] >> 5) & 1) && (xcr0 & 0x06)==0x06){ // EBX bit 5 - AVX2, XMM+YMM
+		features|=CPUAVX2;
+	}
+	if (((regs[1] >> 16) & 1) && (xcr0 & 0xe6)==0xe6){ // EBX bit 16 - AVX512F, +ZMM
+		features|=CPUAVX512;
+		if ((regs[1] >> 30) & 1){ // EBX bit 30 - AVX512BW
+			features|=CPUAVX512BW;
+		}
+		if ((regs[2] >> 8) & 1){ // ECX bit 8 - GFNI
+			features|=CPUGFNI;
+		}
+		if ((regs[2] >> 10) & 1){ // ECX bit 10 - VPCLMULQDQ
+			features|=CPUVPCLMUL;
+		}
+	}
+#else
+	features=0;
+#endif
+	return(features);
 }
 
-static void bchEncode(const unsigned int encodeTbl[BYTESTATES][MAXREDUNWDS],int codeword[],
-					  int numRedunWords,int numRedunBytes,int numDataBytes)
+static void genClmulFoldConsts(struct BchCodec *pCdc)
 {
 	//****************************************************************
-	//	Function: bchEncode
+	//	Function: genClmulFoldConsts
 	//
-	//  This is the encoder.  It performs its function byte parallel using
-	//  an encode table that is built during initialization.  It processes
-	//  one byte at a time regardless of the size of the finite field.
+	//  Function to resolve the remainder engine option and, for the
+	//  carry-less multiply engine, generate the fold constant.
 	//
-	//  The parallel approach shifts a software shift register implementing the
-	//  code generator polynomial once per codeword byte even though the binary
-	//  BCH code generator polynomial is over GF(2).  The shift occurs once per
-	//  byte regardless of the size of the finite field.  The value of the
-	//  codeword byte being processed addresses a large table to get the next
-	//  value of the software shift register.  See page 243 (k-bit serial techniques)
-	//  of "Practical Error Correction Design for Engineers" (revised second
-	//  edition 1991) by Neal Glover and Trent Dudley.  Page 347 of this book
-	//  describes tables for an early implementation of k-bit serial for
-	//  a binary code (a computer generated code).  The k-bit serial
-	//  method described there would be the same as for a binary
-	//  BCH code.  I learned early on that it was possible to implement
-	//  a parallel shift register for a binary code.  I may have learned this
-	//  from a paper by Hsiao and Sih titled "Serial-to-Parrallel Transformation
-	//  of Linear-Feedback Shift-Register Circuits" which appeared in
-	//  IEEE. Trans. on Elec. Comp., 738-740 (Dec. 1964).
+	//  The CLMUL engine keeps an accumulator of clmulFoldWords 64 bit
+	//  words that is congruent to the data processed so far modulo the
+	//  code generator polynomial g(x).  Each 64 data bits shift the
+	//  accumulator up one word.  The word shifted out of the top is
+	//  folded back in by multiplying it by x^(64*clmulFoldWords) mod g(x).
+	//  The accumulator has one word more than g(x) needs so the product
+	//  always fits.
+	//
+	//  The constant is computed one bit at a time with the shift
+	//  register feedback words.  The register is left justified so
+	//  the coefficient of x^0 of the cgp remainder is bit 32*numRedunWords-
+	//  numRedunBits of the register counting from the low order bit.
 	//****************************************************************
-	unsigned int SR[MAXREDUNWDS], tmp, fdbk, fdbkSav;
-	// +5 So that we can temporarily keep remainder bytes in whole words
-	int redunByteArray[(MAXCORR*MAXMPARM)/8+5];
-	int jx ,kx, writeCWAddr;
+	unsigned int SR[MAXREDUNWDS],topBit,carry,carrySav;
+	int kx,nnn,bitPos,foldBits;
+	const int numRedunWords=pCdc->numRedunWords;
+	const int padBits=32*numRedunWords-pCdc->numRedunBits;
 
-	for (kx=0; kx < numRedunWords;kx++){ // Clear encode shift register
-		SR[kx] = 0;
+	if (pCdc->remainderEngine==REMENGAUTO){
+		pCdc->remainderEngine=(pCdc->numDataBytes>=CLMULMINDATABYTES) ?
+			REMENGCLMUL : REMENGTABLE;
 	}
-	for (writeCWAddr = 0; writeCWAddr < numDataBytes; writeCWAddr++) {// index to write data buffer
-		fdbk = 0;
-		for (jx=numRedunWords-1; jx >=0 ;jx--){
-			// IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT.
-			// WILL HAVE TO PROCESS FROM HIGH ADDRESS BACK TOWARDS ZERO
-			fdbkSav = fdbk;
-			// 32 bits per int - but process 8 bits at a time (8 bits unrelated to "m")
-			fdbk = (SR[jx] >> 24) & 0x000000ff;
-			SR[jx] = (SR[jx] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
+	if (pCdc->remainderEngine!=REMENGCLMUL || (cpuFeatures() & CPUPCLMUL)==0 ||
+		pCdc->numRedunBits<1){
+		pCdc->remainderEngine=REMENGTABLE;
+		return;
+	}
+	pCdc->clmulFoldWords=(pCdc->numRedunBits+63)/64+1;
+	foldBits=64*pCdc->clmulFoldWords;
+	// Start with the polynomial "1" and multiply by x foldBits times
+	for (nnn=0;nnn<numRedunWords;nnn++){
+		SR[nnn]=0;
+	}
+	SR[numRedunWords-1-padBits/32]=1U << (padBits%32);
+	for (kx=0;kx<foldBits;kx++){
+		topBit=SR[0] >> 31;
+		carry=0;
+		for (nnn=numRedunWords-1;nnn>=0;nnn--){
+			carrySav=carry;
+			carry=SR[nnn] >> 31;
+			SR[nnn]=(SR[nnn] << 1) | carrySav;
 		}
-		fdbk ^= (unsigned int)codeword[writeCWAddr];
-		// IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT
-		for (jx=0; jx < numRedunWords;jx++){
-			SR[jx] ^= encodeTbl[fdbk][jx];
+		if (topBit!=0){
+			for (nnn=0;nnn<numRedunWords;nnn++){
+				SR[nnn]^=pCdc->cgpFdbkWords[nnn];
+			}
 		}
 	}
-	// Copy redundancy bytes from shift register (SR) word array
-	for (kx=0;kx<numRedunWords;kx++){
-		tmp=SR[kx]; // Fetch a 32 bit word
-		redunByteArray[4*kx] = tmp>>24;
-		redunByteArray[4*kx+1] = (tmp>>16) & 0x000000ff;
-		redunByteArray[4*kx+2] = (tmp>>8) & 0x000000ff;
-		redunByteArray[4*kx+3] = tmp & 0x000000ff;
+	// Move the register (less its pad bits) to 64 bit words, low order first
+	for (kx=0;kx<MAXFOLDWORDS;kx++){
+		pCdc->clmulFoldConst[kx]=0;
 	}
-	// Copy redundancy to codeword.  Don't copy pad bytes of SR word array
-	for (kx=0;kx<numRedunBytes;kx++){
-		codeword[numDataBytes+kx]=redunByteArray[kx];
+	for (kx=0;kx<pCdc->numRedunBits;kx++){
+		bitPos=kx+padBits;
+		if ((SR[numRedunWords-1-bitPos/32] >> (bitPos%32)) & 1){
+			pCdc->clmulFoldConst[kx/64] |= 1ULL << (kx%64);
+		}
 	}
 }
 
-static void savCodeword()
+static void ffLinearMats(const struct BchCodec *pCdc,const int cols[],
+						 unsigned long long mat[2][2])
 {
 	//****************************************************************
-	//	Function: savCodeword
+	//	Function: ffLinearMats
 	//
-	//	Function to save the original codeword resulting from encoding,
-	//  so that it can be compared later with the corrected codeword.
+	//  Converts a GF(2) linear map of the field elements into
+	//  GF2P8AFFINEQB matrices.  cols[b] is the image of alpha^b (the
+	//  element with only bit b set), b<m.  mat[o][s] maps byte s of the
+	//  operand to byte o of the result, so the result is
+	//
+	//     low byte  = A(lo,mat[0][0]) ^ A(hi,mat[0][1])
+	//     high byte = A(lo,mat[1][0]) ^ A(hi,mat[1][1])
+	//
+	//  where A is GF2P8AFFINEQB.  Byte 7-i of a matrix is the mask of
+	//  the operand bits that are added into bit i of the result.  A
+	//  multiply by a constant c is the map with cols[b]=c*alpha^b and
+	//  squaring the one with cols[b]=alpha^(2b).
 	//****************************************************************
-	int kx;
+	int ox,sx,ix,bx;
+	unsigned long long row;
 
-	for (kx=0;kx<gblNumCodewordBytes;kx++){
-		gblCodewordSav[kx]=gblCodeword[kx];
+	for (ox=0;ox<2;ox++){
+		for (sx=0;sx<2;sx++){
+			mat[ox][sx]=0;
+			for (ix=0;ix<8;ix++){
+				row=0;
+				for (bx=0;bx<8;bx++){
+					if (8*sx+bx<pCdc->mParm && ((cols[8*sx+bx] >> (8*ox+ix)) & 1)!=0){
+						row|=1ULL<<bx;
+					}
+				}
+				mat[ox][sx]|=row<<(8*(7-ix));
+			}
+		}
 	}
 }
 
-static int applyErrors(int lowNumErrs,int hiNumErrs)
+static void genFfKernelConsts(struct BchCodec *pCdc)
 {
 	//****************************************************************
-	//	Function: applyErrors
+	//	Function: genFfKernelConsts
 	//
-	//	Function to apply errors to the codeword before decoding.  The
-	//  minimum and maximum number of errors to apply are established
-	//  by input from the user.  Errors are being put in a codeword of
-	//  bytes regardless of finite field size.
+	//  Function to pick the GF(2^m) batch kernels (ffMultBatch,
+	//  ffPolyEvalBatch, ffMultConstBatch and ffSquareBatch) and to
+	//  generate their constants.  With ffKernelFlg set and AVX-512BW,
+	//  variable products use VPCLMULQDQ (8 per step) and multiplies by
+	//  a constant and squaring use GFNI (32 per step).  Else, and for
+	//  the few elements left at the end, the log and alog tables are
+	//  used.  The GFNI and carry-less forms take the same time for any
+	//  operands, where a table lookup takes longer when it misses the
+	//  cache, and need no tables.
 	//****************************************************************
-	int jx,kx,bitLoc,byteLoc,byteValue;
-	int byteBitNum,uniqueFlg;
+	int bx;
+	unsigned long long num;
+	int cols[MAXMPARM];
+	const int mParm=pCdc->mParm;
 
-	gblNumErrsApplied = ((int)getRandom()%((hiNumErrs-lowNumErrs)+1))+lowNumErrs;
-	for (kx=0;kx<gblNumErrsApplied;kx++){
-		// Highest bit err gblLoc will be gblNumDataBits+gblNumRedunBits-1,
-		// which is the last gblCodeword bit location.  NOTE: Last
-		// gblCodeword bit not necessarialy on a byte boundary.  But
-		// this code works on bytes so there are possibly zero fill
-		// bits in the last gblCodeword byte.  If we put errs in the
-		// fill positions they could appear to be in the front
-		// part of the gblCodeword and miscorrection could result.
-		do {
-			// Working with bits because of pad bits
-			bitLoc = (int)getRandom()%(gblNumDataBits+gblNumRedunBits);
-			uniqueFlg=1;
-			for (jx=0;jx<kx;jx++){ // If kx==0 this loop will not do anything
-				if (bitLoc==gblRawLoc[jx]){
-					uniqueFlg=0;
-					break;
-				}
-			}
-		}while ( uniqueFlg ==0);
-		gblRawLoc[kx]=bitLoc;
-		byteLoc = bitLoc/8;
-		byteBitNum = 7 - (bitLoc % 8);
-		byteValue=1;
-		for (jx=byteBitNum;jx>=1;jx--){
-			byteValue *= 2;
+	pCdc->ffKernelFeatures=0;
+	if (pCdc->ffKernelFlg!=0 && (cpuFeatures() & CPUAVX512BW)!=0){
+		pCdc->ffKernelFeatures=cpuFeatures() & (CPUGFNI | CPUVPCLMUL);
+	}
+	// mu = x^(2m) div p(x), p(x) including its x^m term
+	num=1ULL<<(2*mParm);
+	pCdc->ffClmulMu=0;
+	for (bx=2*mParm;bx>=mParm;bx--){
+		if ((num >> bx) & 1){
+			pCdc->ffClmulMu|=1ULL<<(bx-mParm);
+			num^=(unsigned long long)pCdc->ffPoly<<(bx-mParm);
 		}
-		gblCodeword[byteLoc] ^= byteValue;
-		gblAppliedErrLocs[kx]=byteLoc;
-		gblAppliedErrVals[kx]=byteValue;
 	}
-	return (gblNumErrsApplied);
+	for (bx=0;bx<mParm;bx++){
+		cols[bx]=pCdc->alogTbl[2*bx];
+	}
+	ffLinearMats(pCdc,cols,pCdc->ffSquareMat);
 }
 
-static int computeRemainder(const int codeword[],int numRedunWords,int numRedunBytes,
-							int numDataBytes,
-							const unsigned int encodeTbl[BYTESTATES][MAXREDUNWDS],
-							int remainBytes[])
+#if BCHX86SIMD
+TARGETVPCLMUL static inline __m512i ffClmul512(__m512i opa,__m512i opb)
 {
 	//****************************************************************
-	//	Function: computeRemainder
+	//	Function: ffClmul512
 	//
-	//  This function computes a remainder.  This remainder is the remainder
-	//  from dividing the received codeword by the full code generator polynomial
-	//  (not by factors of it).  This is the key to speeding up syndrome computation.
-	//  This remainder is computed using a parallel approach similar to that used
-	//  in encoding.  Once we have a full remainder we can compute syndromes from it.
-	//  This is faster than computing syndromes directly from the codeword because
-	//  the remainder is much shorter than the codeword.
+	//  Carry-less products of the 8 64 bit lanes of opa and opb.  The
+	//  products must fit in 64 bits.
+	//****************************************************************
+	return(_mm512_unpacklo_epi64(_mm512_clmulepi64_epi128(opa,opb,0x00),
+		_mm512_clmulepi64_epi128(opa,opb,0x11)));
+}
+
+TARGETVPCLMUL static inline __m512i ffMultClmul512(const struct BchCodec *pCdc,
+												  __m512i opa,__m512i opb)
+{
+	//****************************************************************
+	//	Function: ffMultClmul512
 	//
-	//  This also gives us a fast way to determine if the syndromes would all be zero.
-	//  If the remainder is all zeros then there is no need to compute syndromes from
-	//  it as they would all be zeros also.  If the remainder is zero then the
-	//  codeword is assumed to be error free and no further decoding steps are
-	//  necessary.
+	//  GF(2^m) products of the 8 64 bit lanes of opa and opb.  The
+	//  carry-less product p (degree < 2m-1) is reduced modulo p(x) by
+	//  Barrett reduction - q = ((p div x^m)*mu) div x^m is p div p(x),
+	//  and p+q*p(x) is the remainder.
+	//****************************************************************
+	__m512i prod,quo;
+	const int mParm=pCdc->mParm;
+
+	prod=ffClmul512(opa,opb);
+	quo=ffClmul512(_mm512_srli_epi64(prod,mParm),_mm512_set1_epi64((long long)pCdc->ffClmulMu));
+	quo=_mm512_srli_epi64(quo,mParm);
+	prod=_mm512_xor_si512(prod,ffClmul512(quo,_mm512_set1_epi64(pCdc->ffPoly)));
+	return(_mm512_and_si512(prod,_mm512_set1_epi64(pCdc->nParm)));
+}
+
+TARGETVPCLMUL static int ffMultBatchClmul(const struct BchCodec *pCdc,const FfElem opa[],
+										 const FfElem opb[],FfElem prod[],int num)
+{
+	//****************************************************************
+	//	Function: ffMultBatchClmul
 	//
-	//  The parallel approach shifts a software shift register implementing the
-	//  code generator polynomial once per codeword byte even though the binary
-	//  BCH code generator polynomial is over GF(2).  The shift occurs once per
-	//  byte regardless of the size of the finite field.  The value of the
-	//  codeword byte being processed addresses a large table to get the next
-	//  value of the software shift register.  See page 243 (k-bit serial techniques)
-	//  of "Practical Error Correction Design for Engineers" (revised second
-	//  edition 1991) by Neal Glover and Trent Dudley.  Page 347 of this book
-	//  describes tables for an early implementation of k-bit serial for
-	//  a binary code (a computer generated code).  The k-bit serial
-	//  method described there would be the same as for a binary
-	//  BCH code.  I learned early on that it was possible to implement
-	//  a parallel shift register for a binary code.  I may have learned this
-	//  from a paper by Hsiao and Sih titled "Serial-to-Parrallel Transformation
-	//  of Linear-Feedback Shift-Register Circuits" which appeared in
-	//  IEEE. Trans. on Elec. Comp., 738-740 (Dec. 1964).
+	//  ffMultBatch with VPCLMULQDQ, 8 products per step.  Returns the
+	//  number of products done (a multiple of 8).
 	//****************************************************************
-	unsigned int fdbk,fdbkSav,SR[MAXREDUNWDS];
-	int nnn,readCWAddr,remainderDetdErr;
+	int ix;
+	__m512i va,vb;
 
-	for (nnn=0; nnn < numRedunWords;nnn++){ // Clear encode shift register
-		SR[nnn] = 0;
+	for (ix=0;ix+8<=num;ix+=8){
+		va=_mm512_cvtepu16_epi64(_mm_loadu_si128((const __m128i *)&opa[ix]));
+		vb=_mm512_cvtepu16_epi64(_mm_loadu_si128((const __m128i *)&opb[ix]));
+		_mm_storeu_si128((__m128i *)&prod[ix],_mm512_cvtepi64_epi16(ffMultClmul512(pCdc,va,vb)));
 	}
-	// SHIFTS WITH FEEDBACK
-	for (readCWAddr = 0; readCWAddr < numDataBytes; readCWAddr++) {// index to write data buffer
-		fdbk = 0;
-		for (nnn=numRedunWords-1; nnn >=0 ;nnn--){
-			// IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT.
-			// WILL HAVE TO PROCESS FROM HIGH ADDRESS BACK TOWARDS ZERO
-			fdbkSav = fdbk;
-			fdbk = (SR[nnn] >> 24); // 32 - # bits in word (unrelated to "m")
-			SR[nnn] = (SR[nnn] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
+	return(ix);
+}
+
+TARGETVPCLMUL static int ffPolyEvalBatchClmul(const struct BchCodec *pCdc,const int coef[],
+											 int deg,const FfElem x[],FfElem y[],int num)
+{
+	//****************************************************************
+	//	Function: ffPolyEvalBatchClmul
+	//
+	//  ffPolyEvalBatch with VPCLMULQDQ - Horner's rule for 8 points
+	//  per vector.  Each Horner step waits on three carry-less
+	//  multiplies, so four vectors (32 points) are stepped at once.
+	//  Returns the number of points done (a multiple of 8).
+	//****************************************************************
+	int ix,jx,kx;
+	__m512i vx,vy,vx4[4],vy4[4],vc;
+
+	for (ix=0;ix+32<=num;ix+=32){
+		for (kx=0;kx<4;kx++){
+			vx4[kx]=_mm512_cvtepu16_epi64(_mm_loadu_si128((const __m128i *)&x[ix+8*kx]));
+			vy4[kx]=_mm512_set1_epi64(coef[deg]);
 		}
-		fdbk ^= (unsigned int)codeword[readCWAddr];
-		for (nnn=0; nnn < numRedunWords;nnn++){
-			// IT IS POSSIBLE TO UNROLL THIS LOOP
-			SR[nnn] ^= encodeTbl[fdbk][nnn];
+		for (jx=deg-1;jx>=0;jx--){
+			vc=_mm512_set1_epi64(coef[jx]);
+			for (kx=0;kx<4;kx++){
+				vy4[kx]=_mm512_xor_si512(ffMultClmul512(pCdc,vy4[kx],vx4[kx]),vc);
+			}
 		}
-	}
-	// SHIFTS WITHOUT FEEDBACK
-	// Line below - This flag will be set later if the remainder is non zero.
-	// Non-zero means either corr or uncorr err.  We will know which after decoding.
-	remainderDetdErr=0;
-	// index to codeword buffer
-	for (readCWAddr = numDataBytes; readCWAddr < numDataBytes+numRedunBytes; readCWAddr++) {
-		fdbk = 0;
-		for (nnn=numRedunWords-1; nnn >=0 ;nnn--){
-			fdbkSav = fdbk;
-			fdbk = (SR[nnn] >> 24); // 32 - # bits in parallel (unrelated to "m")
-			SR[nnn] = (SR[nnn] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
+		for (kx=0;kx<4;kx++){
+			_mm_storeu_si128((__m128i *)&y[ix+8*kx],_mm512_cvtepi64_epi16(vy4[kx]));
 		}
-		fdbk ^= (unsigned int)codeword[readCWAddr];;
-		remainBytes[readCWAddr-numDataBytes]=(int)fdbk;
-		if (fdbk!=0){
-			remainderDetdErr = 1;
+	}
+	for (;ix+8<=num;ix+=8){
+		vx=_mm512_cvtepu16_epi64(_mm_loadu_si128((const __m128i *)&x[ix]));
+		vy=_mm512_set1_epi64(coef[deg]);
+		for (jx=deg-1;jx>=0;jx--){
+			vy=_mm512_xor_si512(ffMultClmul512(pCdc,vy,vx),_mm512_set1_epi64(coef[jx]));
 		}
+		_mm_storeu_si128((__m128i *)&y[ix],_mm512_cvtepi64_epi16(vy));
 	}
-	return(remainderDetdErr);
+	return(ix);
 }
 
-static void computeSyndromes(int syndromes[],int numRedunBytes,const int remainBytes[],
-							 const int alogTbl[],const int logTbl[],int nParm,int tParm)
+TARGETGFNI static int ffLinearBatchGfni(const unsigned long long mat[2][2],
+									   const FfElem opa[],FfElem res[],int num)
 {
 	//****************************************************************
-	//	Function: computeSyndromes
+	//	Function: ffLinearBatchGfni
 	//
-	//  9-10-10 Made few changes for speed
-	//
-	//  Function to compute syndromes.  Syndromes are computed from a
-	//  remainder not from the codeword.  See the comments
-	//  for the ComputeRemainder function.
+	//  Applies the linear map mat (see ffLinearMats) to 32 elements per
+	//  step with GF2P8AFFINEQB.  The elements are 16 bit words, so each
+	//  matrix is applied to both bytes of every word and the half that
+	//  belongs to the other byte is shifted over or masked off.
+	//  Returns the number of elements done (a multiple of 32).
+	//****************************************************************
+	int ix;
+	__m512i v,lo,hi;
+	const __m512i m00=_mm512_set1_epi64((long long)mat[0][0]);
+	const __m512i m01=_mm512_set1_epi64((long long)mat[0][1]);
+	const __m512i m10=_mm512_set1_epi64((long long)mat[1][0]);
+	const __m512i m11=_mm512_set1_epi64((long long)mat[1][1]);
+	const __m512i loMask=_mm512_set1_epi16(0x00ff);
+
+	for (ix=0;ix+32<=num;ix+=32){
+		v=_mm512_loadu_si512((const void *)&opa[ix]);
+		lo=_mm512_xor_si512(_mm512_and_si512(_mm512_gf2p8affine_epi64_epi8(v,m00,0),loMask),
+			_mm512_srli_epi16(_mm512_gf2p8affine_epi64_epi8(v,m01,0),8));
+		hi=_mm512_xor_si512(_mm512_slli_epi16(_mm512_gf2p8affine_epi64_epi8(v,m10,0),8),
+			_mm512_andnot_si512(loMask,_mm512_gf2p8affine_epi64_epi8(v,m11,0)));
+		_mm512_storeu_si512((void *)&res[ix],_mm512_or_si512(lo,hi));
+	}
+	return(ix);
+}
+#endif
+
+static void ffMultBatch(const struct BchCodec *pCdc,const FfElem opa[],const FfElem opb[],
+						FfElem prod[],int num)
+{
+	//****************************************************************
+	//	Function: ffMultBatch
 	//
-	//  Note that even syndromes are computed from odd syndromes.
-	//  I have know that this is possible for a binary
-	//  BCH code for about 30 years.  I think that I learned
-	//  that this is possible from one of the early ECC books.
-	//  Possibly from an early book by Peterson, Berlekamp, or
-	//  Shu Lin.  I just found an early reference to this on
-	//  page 192 of "Algebraic Coding Theory" by Dr. Elwyn
-	//  Berlekamp.
+	//  prod[i]=opa[i]*opb[i] for num pairs (see genFfKernelConsts).
+	//****************************************************************
+	int ix;
+
+	ix=0;
+#if BCHX86SIMD
+	if ((pCdc->ffKernelFeatures & CPUVPCLMUL)!=0){
+		ix=ffMultBatchClmul(pCdc,opa,opb,prod,num);
+	}
+#endif
+	for (;ix<num;ix++){
+		prod[ix]=(FfElem)ffMult(pCdc,opa[ix],opb[ix]);
+	}
+}
+
+static void ffPolyEvalBatch(const struct BchCodec *pCdc,const int coef[],int deg,
+							const FfElem x[],FfElem y[],int num)
+{
+	//****************************************************************
+	//	Function: ffPolyEvalBatch
 	//
-	//  An early reference for computing syndromes from
-	//  a remainder is page 160 of the Glover-Dudley 1991 book
-	//  "Practical Error Correction Design for Engineers"
-	//  REVISED SECOND EDITION.
+	//  y[i] = coef[deg]*x[i]^deg + .. + coef[1]*x[i] + coef[0] for num
+	//  points (see genFfKernelConsts).  The table form is Horner's rule
+	//  with the log of x[i] fetched once.
 	//****************************************************************
-	int mask, data, evenSNum;
-	int jjj,iii,kkk,x,numSyndromes,accumVal,bumpVal;
+	int ix,jx,logX,val;
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
 
-	// In a real implementation of one fixed code, numSyndromes would be a constant
-	numSyndromes=2*tParm;
-	// Clear syndromes
-	for (kkk=0;kkk<numSyndromes;kkk++){
-		syndromes[kkk] = 0;
+	ix=0;
+#if BCHX86SIMD
+	if ((pCdc->ffKernelFeatures & CPUVPCLMUL)!=0){
+		ix=ffPolyEvalBatchClmul(pCdc,coef,deg,x,y,num);
 	}
-	for (iii=0;iii < numRedunBytes;iii++){
-		mask=0x01;
-		for (jjj=0;jjj<8;jjj++){
-			data = remainBytes[iii] & mask;
-			if (data>0){
-				// 9-10-10 Changed for speed
-				accumVal=(((numRedunBytes-1)-iii)*8+jjj); // Initialize
-				bumpVal=2*accumVal; // Initialize
-				// Note increment by 2
-				for (kkk=0;kkk<numSyndromes;kkk+=2){
-					//  "+1" is for syndrome offset
-					//	CAN UNROLL THIS LOOP FOR A LITTLE MORE SPEED
-					//  A SWITCH STATEMENT WILL BE REQUIRED.
-					//  CAN GET RID OF MOD (FOR SPEED) BY CARRYING A SUM THAT STARTS
-					//  OUT AS THE MAXIMUM VALUE OF ((kkk+1)*preComputeVal) AND
-					//  SUBTRACTING PRECOMPUTEVAL EACH TIME AND IF VALUE GOES
-					//  NEGATIVE ADD IN NPARM.  THE MAX VALUE ABOVE WILL VARY
-					//  BASED ON NUMBER OF REDUN BYTES FOR SELECTED PARMS
-					//  9-10-10 Changed next few lines for speed
-					syndromes[kkk] ^= alogTbl[accumVal];
-					accumVal+=bumpVal; // Add 2*preComputeVal
-					if (accumVal>=nParm){
-						accumVal-=nParm;
-						if (accumVal>=nParm){
-							accumVal-=nParm;
-						}
-					}
+#endif
+	for (;ix<num;ix++){
+		val=coef[deg];
+		if (x[ix]==0){
+			val=coef[0];
+		}
+		else {
+			logX=logTbl[x[ix]];
+			for (jx=deg-1;jx>=0;jx--){
+				if (val!=0){
+					val=alogTbl[logTbl[val]+logX];
 				}
+				val^=coef[jx];
 			}
-			mask *=2;
 		}
+		y[ix]=(FfElem)val;
 	}
-	// Compute even Syndromes from the odd Syndromes
-	for (kkk=0;kkk<numSyndromes;kkk+=2){
-		x=syndromes[kkk];
-		evenSNum=(2*(kkk+1));
-		while (evenSNum<=2*tParm){
-			// Square "x"
-			if (x>0){
-				x=alogTbl[2*logTbl[x]];
+}
+
+static void ffMultConstBatch(const struct BchCodec *pCdc,int c,const FfElem opa[],
+							 FfElem prod[],int num)
+{
+	//****************************************************************
+	//	Function: ffMultConstBatch
+	//
+	//  prod[i]=c*opa[i] for num elements (see genFfKernelConsts).
+	//****************************************************************
+	int ix,logC;
+
+	ix=0;
+#if BCHX86SIMD
+	if ((pCdc->ffKernelFeatures & CPUGFNI)!=0 && num>=32){
+		int bx,cols[MAXMPARM];
+		unsigned long long mat[2][2];
+
+		for (bx=0;bx<pCdc->mParm;bx++){
+			cols[bx]=ffMult(pCdc,c,pCdc->alogTbl[bx]);
+		}
+		ffLinearMats(pCdc,cols,mat);
+		ix=ffLinearBatchGfni(mat,opa,prod,num);
+	}
+#endif
+	logC=(c!=0) ? pCdc->logTbl[c] : 0;
+	for (;ix<num;ix++){
+		prod[ix]=(FfElem)((c!=0 && opa[ix]!=0) ? pCdc->alogTbl[pCdc->logTbl[opa[ix]]+logC] : 0);
+	}
+}
+
+static void ffSquareBatch(const struct BchCodec *pCdc,const FfElem opa[],FfElem res[],int num)
+{
+	//****************************************************************
+	//	Function: ffSquareBatch
+	//
+	//  res[i]=opa[i]^2 for num elements (see genFfKernelConsts).
+	//****************************************************************
+	int ix;
+
+	ix=0;
+#if BCHX86SIMD
+	if ((pCdc->ffKernelFeatures & CPUGFNI)!=0){
+		ix=ffLinearBatchGfni(pCdc->ffSquareMat,opa,res,num);
+	}
+#endif
+	for (;ix<num;ix++){
+		res[ix]=(FfElem)((opa[ix]!=0) ? pCdc->alogTbl[2*pCdc->logTbl[opa[ix]]] : 0);
+	}
+}
+
+static void genSyndromeTbls(struct BchCodec *pCdc)
+{
+	//****************************************************************
+	//	Function: genSyndromeTbls
+	//
+	//  Function to generate the syndrome tables used by
+	//  computeSyndromesTbl.  Bit jjj of remainder byte iii is the
+	//  coefficient of x^p where p=((numRedunBytes-1)-iii)*8+jjj, so a
+	//  set bit adds alpha^(p*(2k+1)) to odd syndrome 2k+1 (the same
+	//  computation computeSyndromes does for each set bit).  The table
+	//  entry for a byte value is the XOR of the entries of its bits.
+	//  If the tables cannot be allocated syndromeTblFlg is cleared.
+	//****************************************************************
+	int iii,jjj,kkk,bVal,lowBit,logVal;
+	unsigned short *rowTbl;
+	const int numRedunBytes=pCdc->numRedunBytes;
+	const int tParm=pCdc->tParm;
+	const int nParm=pCdc->nParm;
+
+	pCdc->synTbl=(unsigned short *)
+		malloc(numRedunBytes*BYTESTATES*tParm*sizeof(unsigned short));
+	if (pCdc->synTbl==0){
+		pCdc->syndromeTblFlg=0;
+		return;
+	}
+	for (iii=0;iii<numRedunBytes;iii++){
+		rowTbl=&pCdc->synTbl[iii*BYTESTATES*tParm]; // Entries for byte iii
+		for (kkk=0;kkk<tParm;kkk++){
+			rowTbl[kkk]=0;
+		}
+		// Single bit byte values
+		for (jjj=0;jjj<8;jjj++){
+			logVal=(((numRedunBytes-1)-iii)*8+jjj)%nParm;
+			for (kkk=0;kkk<tParm;kkk++){
+				rowTbl[(1<<jjj)*tParm+kkk]=(unsigned short)
+					pCdc->alogTbl[(int)(((long long)logVal*(2*kkk+1))%nParm)];
+			}
+		}
+		// Other byte values - XOR of the lowest bit and the rest
+		for (bVal=3;bVal<BYTESTATES;bVal++){
+			lowBit=bVal & (-bVal);
+			if (lowBit==bVal){
+				continue;
+			}
+			for (kkk=0;kkk<tParm;kkk++){
+				rowTbl[bVal*tParm+kkk]=rowTbl[lowBit*tParm+kkk]
+					^ rowTbl[(bVal^lowBit)*tParm+kkk];
 			}
-			syndromes[evenSNum-1]=x;
-			evenSNum*=2;
 		}
 	}
 }
 
-static int berMas(int tParm,int sigmaN[],const int syndromes[],int *pErrFlg,
-				  const int nParm,const int alogTbl[],const int logTbl[])
-//***************************************************************
-//	Function: BerMas
-//
-//  10-3-08 One line was changed and one line was added to change the
-//  the code over from supporting a Reed-Solomon code to supporting a
-//  binary BCH code.
-//
-//	This function computes the coefficient's of the ELP using the Berlekamp-
-//	Massey algorithm. The reference for this algorithm is
-//	"Shift-Register Synthesis and BCH Decoding", IEEE Transactions
-//	on Information Theory, IT-15, 122-127, 1969.  This paper can also be
-//  found in Blake's 1973 book, "Algebraic Coding Theory"
-//  (a collection of papers).  When I wrote the 1999 version of this
-//  function, I evaluated several variations of the Berlekamp-Massey
-//  algorithm. The variations vary mostly in the initialization of "nn"
-//  (0 or 1) and in the algebra used for the decisions.
-//
-//	I wrote this code originally in 1999 for a Reed-Solomon code.
-//  I added the error evaluator polynomial at that time.  My reference
-//  for adding the error evaluator polynomial was the thesis
-//  by Doug Whiting.  I removed the error evaluator polynomial 10-3-08
-//  for a binary BCH, since we do not compute error values for a binary
-//  BCH code.  Variable names used here are related to the variable names
-//  used in the original Massey article as shown below.
-//
-//   This Code   Massey Paper
-//   ---------   ------------
-//	 sigmaTmp    T(D)  D of T(D) is from signal processing and is equiv to using T(x)
-//   SigmaN      C(D)
-//   sigmaK      B(D)
-//   n           N
-//   nminusk     x
-//   dk          b
-//   dn          d
-//   Ln          L
-//
-//  For implementations where the time spent in this function is a
-//  dominating factor in performance, a technique due to C.L. Chen can
-//  be used for a speed up. If you are interested see "High-Speed
-//  Decoding of BCH Codes" by C.L. Chen - IEEE Info Theory VOL. IT-27,
-//  NO. 2, March 1981.  Before implementing this technique you need
-//  to understand its impact on your miscorrection rate.
-//***************************************************************
+static void genDeltaTbl(struct BchCodec *pCdc)
 {
-	int logTmpQ,sigmaK[MAXCORR+1];
-	int sigmaTmp[MAXCORR+1];
-	int dn,dk,Ln;
-	int nn,j,lk,nminusk;
+	//****************************************************************
+	//	Function: genDeltaTbl
+	//
+	//	Builds the bit position table for bchUpdateParity.  The last
+	//  data bit is the x^0 term of the data, so its parity is
+	//  x^numRedunBits mod g(x), the shift register feedback pattern
+	//  cgpFdbkWords.  Each row before it is the row after it times x -
+	//  shifted left one bit with feedback - so rows are built from the
+	//  last data bit back to the first.  If the table would not fit in
+	//  MAXDELTADATABYTES or cannot be allocated deltaTblFlg is cleared.
+	//****************************************************************
+	int qx,nnn;
+	unsigned int fdbk,fdbkSav;
+	unsigned int *row,*nextRow;
+	const int numRedunWords=pCdc->numRedunWords;
 
-	sigmaN[0]=1;sigmaK[0]=1;
-	for (nn=1;nn<=tParm;nn++){
-		sigmaN[nn]=0;
-		sigmaK[nn]=0;
+	if (pCdc->numDataBytes>MAXDELTADATABYTES){
+		pCdc->deltaTblFlg=0;
 	}
-	nminusk=1;dk=1;lk=0;Ln=0;
-	// Next cmd line - 2*tParm is number of syndromes
-	// Next cmd line - *****incr was changed from 1 (RS) to 2 (bin BCH)*****
-	for (nn=0;nn<2*tParm;nn+=2){
-		dn=0;
-		for (j=0;j<=Ln;j++){
-			dn^=ffMult(sigmaN[j],syndromes[nn-j]);
+	if (pCdc->deltaTblFlg==0 || pCdc->numDataBits==0){
+		return;
+	}
+	pCdc->deltaTbl=(unsigned int *)malloc(pCdc->numDataBits*numRedunWords*sizeof(unsigned int));
+	if (pCdc->deltaTbl==0){
+		pCdc->deltaTblFlg=0;
+		return;
+	}
+	row=&pCdc->deltaTbl[(pCdc->numDataBits-1)*numRedunWords];
+	for (nnn=0;nnn<numRedunWords;nnn++){
+		row[nnn]=pCdc->cgpFdbkWords[nnn];
+	}
+	for (qx=pCdc->numDataBits-2;qx>=0;qx--){
+		nextRow=row;
+		row=&pCdc->deltaTbl[qx*numRedunWords];
+		fdbk=0;
+		for (nnn=numRedunWords-1;nnn>=0;nnn--){
+			fdbkSav=fdbk;
+			fdbk=nextRow[nnn] >> 31;
+			row[nnn]=(nextRow[nnn] << 1) ^ fdbkSav;
 		}
-		if (dn==0){
-			nminusk++;
+		if (fdbk==1){
+			for (nnn=0;nnn<numRedunWords;nnn++){
+				row[nnn]^=pCdc->cgpFdbkWords[nnn];
+			}
 		}
-		else {
-			if (2*Ln>nn){
-				if (nn-Ln>(tParm-1)){
-					*pErrFlg|=BERMASERR;
-					break;
-				}
-				// Next 2 "if" blks chgd to not use ffMult and ffDiv funs 9-9-2010
-				if (dk==0){
-					return (DIVZRODIV); // Divide by zero error
-				}
-				if (dn>0){
-					logTmpQ=logTbl[dn]-logTbl[dk];
-					if (logTmpQ<0){
-						logTmpQ+=nParm;
-					}
-					for (j=0;j<=lk;j++) {
-						if (sigmaK[j]>0){
-							sigmaN[nminusk+j]^=alogTbl[logTbl[sigmaK[j]]+logTmpQ];
-						}
-					}
-				}
-				nminusk++;
-			}
-			else {
-				if (nn-Ln>(tParm-1)) {
-					*pErrFlg|=BERMASERR;break;
-				}
-				for (j=0;j<=Ln;j++){
-					sigmaTmp[j]=sigmaN[j];
-				}
-				// Next 2 "if" blks chgd to not use ffMult and ffDiv funs 9-9-2010
-				if (dk==0){
-					return (DIVZRODIV); // Divide by zero error
-				}
-				if (dn>0){
-					logTmpQ=logTbl[dn]-logTbl[dk];
-					if (logTmpQ<0){
-						logTmpQ+=nParm;
-					}
-					for (j=0;j<=lk;j++) {
-						if (sigmaK[j]>0){
-							sigmaN[nminusk+j]^=alogTbl[logTbl[sigmaK[j]]+logTmpQ];
-						}					}
-				}
-				for (j=0;j<=Ln;j++){
-					sigmaK[j]=sigmaTmp[j];
-				}
-				lk=Ln;
-				Ln=nn+1-Ln;
-				dk=dn;
-				nminusk=1;
-			}
-		}
-		nminusk++;// *****This line added for binary BCH*****
-	} // end for
-	if (sigmaN[Ln]==0){
-		*pErrFlg|=BERMASERR;
 	}
-	return (Ln);
 }
 
-static int chienSearch(int sigmaN[],int Loc[],const int alogTbl[], const int logTbl[],
-					   const int LnOrig,const int numCodewordBytes,const int nParm,
-					   const int mParmOdd)
+static void genEncodeTbls(struct BchCodec *pCdc)
 {
 	//****************************************************************
-	//  Function:	ChienSearch
-	//
-	//  This is an enhanced version of the Chien search algorithm.  As
-	//  coded here the function finds roots until the degree (Ln) of
-	//  the Error Locator Polynomial (ELP) has been reduced to four,
-	//  if "m" is even, or to two, if "m" is odd.  The quartic function
-	//  finds the last four roots if "m" is even or the quadratic function
-	//  finds the last two roots if "m" is odd.  This function is not
-	//  called if the degree of the original ELP is 4 or less("m" even) or 2
-	//  or less ("m" odd).  To optimize speed two different techniques are
-	//  used to advance the ELP for its next evaluation.
-	//
-	//  For this code a fast technique is used when there are no zero
-	//  coefficients in the ELP.  A slower technique is used when there are
-	//  zero coefficients in the ELP. The probability that there are zero
-	//  coefficients in the ELP is relatively low.  Also for speed the ELP
-	//  is divided down each time a root is found.  Also for speed the inner
-	//  most loop of the faster technique is unrolled.  Again for speed, mod
-	//  operations are replaced with equivalent but faster operations.
-	//  My original knowledge of unrolling loops came from the Earl
-	//  Cohen Ph.D. thesis (Berkeley).  See also the Glover-Dudley patent
-	//  4,839,896.
+	//	Function: genEncodeTbls
 	//
-	//  The fastest Chien search technique that I am aware of is to
-	//  keep the coefficient values in alog form and to use a table
-	//  in memory to implement each constant multiplier of the Chien
-	//  search.  With this technique combined with loop unrolling
-	//  I think you would see a speed up by about a factor of two
-	//  for root finding.  The memory space requirement will be very
-	//  large for large finite fields.  The large memory requirement
-	//  may not be a problem for decoders that run on a PC.
+	//  Function to generate encode tables.  The encode tables allow
+	//  8 bits of data to be processed at a time.  A Left shifting shift
+	//  reg is implemented in multiple 32-bit words.  A multiple word
+	//  shift register value is stored in the table for each possible
+	//  value of a byte.  A byte value is placed in the left most
+	//  (high order position of lowest address word).  Then the shift
+	//  register is shifted 8 times with feedback.  Then the multiple
+	//  word shift register value is stored in the table at the addr
+	//  specified by the byte.
 	//
-	//  There are software root finding techniques that beat the
-	//  speed of even very well written Chien search software.
-	//  Some of these techniques are for particular cases such
-	//  as for quintic and sextic polynomials.  But others are for
-	//  the general case.  Contact the author for more information.
+	//  The feedback words are highest order in lowest address and the
+	//  resulting encode table is organized the same way.
 	//
-	//  The original reference for the most basic Chien search is
-	//  "Cyclic Decoding Procedures for Bose-Chaudhuri-
-	//  Hocquenghem Codes", IEEE Transactions on Information Theory,
-	//  vol. IT-10, pp 357-363, Oct. 1964.
+	//  If encodeSliceBytes is 4 or 8, slicing tables are also built
+	//  so the encoder and computeRemainder can process 4 or 8 data
+	//  bytes per step (as is done for CRCs).  The table for byte
+	//  distance d is the table for distance d-1 shifted one more byte
+	//  with feedback.  If the slicing tables cannot be allocated the
+	//  encoder steps one byte at a time.
 	//
+	//  The remainder engine option and the number of bchEncodeBatch
+	//  lanes are resolved last, from what the CPU supports.
 	//****************************************************************
-	int nn,jj,kx,coeffContainsAZero;
-	int accum,reg,tmp,errFlg,Ln;
-	//
-	errFlg=0;
-	Ln=LnOrig;
-	// Check for a zero coeff before converting to log domain and if find one, set flag
-	coeffContainsAZero = 0;
-	for (kx=1;kx<=Ln;kx++){
-		if (sigmaN[kx]==0){
-			coeffContainsAZero = 1;
-			break;
-		}
-	}
-	// Convert error locator poly to log domain for Chien Search
-	for (nn=1;nn<=Ln;nn++){
-		sigmaN[nn] = logTbl[sigmaN[nn]];
-	}
-	for (nn=0;nn<numCodewordBytes*8;nn++){
-		accum = 0;
-		// Do simple Chien Search if zero coeffs or if Ln>8.  YOU CANNOT
-		// CHANGE THE # 8 IN "Ln>8" WITHOUT ADDING MORE ENTRIES FOR THE
-		// UNROLLED LOOP
-		if (coeffContainsAZero == 1 || Ln>8){
-			for (jj=1;jj<=Ln;jj++){ // One step of Simple Chien Search in this loop
-				if (sigmaN[jj] != gblLogZVal){ // Test for log of zero
-					accum ^= alogTbl[sigmaN[jj]];
-					sigmaN[jj] -= jj;
-					if (sigmaN[jj] < 0){ // Compare & subtract is faster than mod
-						sigmaN[jj] += nParm;
-					}
-				}
-			}
+	unsigned int iii,fdbk,fdbkSav,SR[MAXREDUNWDS];
+	int jjj,nnn,dist;
+	const unsigned int *prevTbl;
+
+	// Gen Encode Table
+	for (iii = 0;iii<BYTESTATES;iii++){ // Encoding is 8 bits parallel
+		for (jjj=0; jjj < pCdc->numRedunWords;jjj++){ // Clear shift register
+			SR[jjj] = 0;
 		}
-		else{
-			// Unrolled loop
-			switch (Ln)
-			{
-			case 8:accum ^= alogTbl[sigmaN[8]];  // accum is XOR sum of all alogs
-				sigmaN[8] -= 8;
-				if (sigmaN[8] < 0){
-					sigmaN[8] += nParm;
-				}
-				//lint -fallthrough
-			case 7:accum ^= alogTbl[sigmaN[7]];  // accum is XOR sum of all alogs
-				sigmaN[7] -= 7;
-				if (sigmaN[7] < 0){
-					sigmaN[7] += nParm;
-				}
-				//lint -fallthrough
-			case 6:accum ^= alogTbl[sigmaN[6]];  // accum is XOR sum of all alogs
-				sigmaN[6] -= 6;
-				if (sigmaN[6] < 0){
-					sigmaN[6] += nParm;
-				}
-				//lint -fallthrough
-			case 5:accum ^= alogTbl[sigmaN[5]];  // accum is XOR sum of all alogs
-				sigmaN[5] -= 5;
-				if (sigmaN[5] < 0){
-					sigmaN[5] += nParm;
-				}
-				//lint -fallthrough
-			case 4:accum ^= alogTbl[sigmaN[4]];  // accum is XOR sum of all alogs
-				sigmaN[4] -= 4;
-				if (sigmaN[4] < 0){
-					sigmaN[4] += nParm;
-				}
-				//lint -fallthrough
-			case 3:accum ^= alogTbl[sigmaN[3]];  // accum is XOR sum of all alogs
-				sigmaN[3] -= 3;
-				if (sigmaN[3] < 0){
-					sigmaN[3] += nParm;
-				}
-				//lint -fallthrough
-			case 2:accum ^= alogTbl[sigmaN[2]];  // accum is XOR sum of all alogs
-				sigmaN[2] -= 2;
-				if (sigmaN[2] < 0){
-					sigmaN[2] += nParm;
+		SR[0] ^= (iii << 24);
+		for (jjj = 0;jjj<=7;jjj++){// 7 is the # of bits in a byte -1
+			fdbk = 0;
+			for (nnn=pCdc->numRedunWords-1; nnn >=0;nnn--){
+				fdbkSav = fdbk;
+				if (SR[nnn] & 0x80000000){
+					fdbk = 1;
 				}
-				//lint -fallthrough
-			case 1:accum ^= alogTbl[sigmaN[1]];  // accum is XOR sum of all alogs
-				sigmaN[1] -= 1;
-				if (sigmaN[1] < 0){
-					sigmaN[1] += nParm;
+				else {
+					fdbk = 0;
 				}
-				//lint -fallthrough
-			default: break;
-			}
-		}
-		if (accum==1){
-			Loc[Ln-1]=alogTbl[nn];
-			// Convert back to alog domain so we can divide down
-			for (kx=1;kx<=Ln;kx++){
-				sigmaN[kx] = alogTbl[sigmaN[kx]];
-			}
-			// Divide down the ELP to eliminate the root just found
-			reg=0;
-			for (kx=Ln;kx>=0;kx--){
-				tmp=ffMult(reg,alogTbl[1]);// The number "1"
-				reg=sigmaN[kx]^tmp;
-				sigmaN[kx]=tmp;
+				SR[nnn] <<= 1;
+				SR[nnn] ^= fdbkSav;
 			}
-			Ln--; // Ln must be decremented right here - do not move
-			// Check if any coefficients are zero and set flag appropriately
-			coeffContainsAZero = 0;
-			for (kx=1;kx<=Ln;kx++){
-				if (sigmaN[kx]==0){
-					coeffContainsAZero = 1;
-					break;
+			if (fdbk == 1){
+				for (nnn=0; nnn < pCdc->numRedunWords;nnn++){
+					SR[nnn] ^= pCdc->cgpFdbkWords[nnn];
 				}
 			}
-			// If degree reduced, special cases will take it from here
-			if ((Ln==4 && mParmOdd==0) || (Ln==2 && mParmOdd==1))  // 4 and 2
-			{
-				// We are still in alog domain so,
-				// position the ELP back to its starting point for special cases
-				for (kx=1;kx<=Ln;kx++){
-					sigmaN[kx]=ffMult(sigmaN[kx],alogTbl[((nn+1)*kx)%nParm]);
-				}
-				break;
+		}
+		for (nnn=0; nnn < pCdc->numRedunWords;nnn++){
+			pCdc->encodeTbl[iii*pCdc->numRedunWords+nnn] = SR[nnn];  // Move SR to encode table
+		}
+	}
+	// Gen slicing tables
+	if (pCdc->encodeSliceBytes!=4 && pCdc->encodeSliceBytes!=8){
+		pCdc->encodeSliceBytes=1;
+	}
+	if (pCdc->encodeSliceBytes>1){
+		pCdc->sliceTbl=(unsigned int *)malloc((pCdc->encodeSliceBytes-1)*BYTESTATES
+			*pCdc->numRedunWords*sizeof(unsigned int));
+		if (pCdc->sliceTbl==0){
+			pCdc->encodeSliceBytes=1;
+		}
+	}
+	for (dist=1;dist<pCdc->encodeSliceBytes;dist++){
+		for (iii = 0;iii<BYTESTATES;iii++){
+			prevTbl=(dist==1) ? &pCdc->encodeTbl[iii*pCdc->numRedunWords] :
+				&pCdc->sliceTbl[((dist-2)*BYTESTATES+iii)*pCdc->numRedunWords];
+			// Shift the previous value one byte and apply the feedback
+			fdbk = 0;
+			for (nnn=pCdc->numRedunWords-1; nnn >=0;nnn--){
+				fdbkSav = fdbk;
+				fdbk = prevTbl[nnn] >> 24;
+				SR[nnn] = (prevTbl[nnn] << 8) ^ fdbkSav;
 			}
-			// Convert back to log domain so we can continue root search
-			for (kx=1;kx<=Ln;kx++){
-				sigmaN[kx] = logTbl[sigmaN[kx]];
+			for (nnn=0; nnn < pCdc->numRedunWords;nnn++){
+				pCdc->sliceTbl[((dist-1)*BYTESTATES+iii)*pCdc->numRedunWords+nnn] =
+					SR[nnn] ^ pCdc->encodeTbl[fdbk*pCdc->numRedunWords+nnn];
 			}
 		}
 	}
-	// If degree of ELP has not been reduced properly
-	if ((Ln!=4 && mParmOdd ==0) || (Ln!=2 && mParmOdd ==1)){// 4 and 2
-		errFlg|=ROOTSNEQLN;
+	genClmulFoldConsts(pCdc);
+	genDeltaTbl(pCdc);
+	// Resolve the number of lanes for bchEncodeBatch.  The lanes gather
+	// from the table once per data byte per redundancy word, so with the
+	// CLMUL engine they are only used up to 2 redundancy words - past
+	// that CLMUL one codeword at a time is faster.
+	if (pCdc->remainderEngine==REMENGCLMUL && pCdc->numRedunWords>ENCODELANEWDS){
+		pCdc->encodeLanes=1;
+	}
+	else if (pCdc->encodeLanes>=16 && (cpuFeatures() & CPUAVX512)!=0){
+		pCdc->encodeLanes=16;
+	}
+	else if (pCdc->encodeLanes>=8 && (cpuFeatures() & CPUAVX2)!=0){
+		pCdc->encodeLanes=8;
+	}
+	else {
+		pCdc->encodeLanes=1;
 	}
-	return (errFlg);
 }
 
-static int rootFindChien(int sigmaN[],int Loc[],const int alogTbl[], const int logTbl[],
-						 const int LnOrig,const int numCodewordBytes,const int nParm,
-						 const int mParmOdd)
+static void genChienMultTbls(struct BchCodec *pCdc)
 {
 	//****************************************************************
-	//	Function: rootFindChien
-	//
-	//  NOTE: There are seperate rootFind functions for Chien and BTA.
+	//	Function: genChienMultTbls
 	//
-	//  This function is the highest level root finding function.  It calls
-	//  lower level root finding functions.  There are special functions
-	//  called for error locator polynomial (ELP) degrees 1 to 4 ("m" even)
-	//  or 1 to 2 ("m" odd).  If the degree of the ELP is greater than
-	//  4 ("m" even) or 2 ("m" odd) the Chien search function is called.
+	//  Function to resolve the table Chien search option and generate
+	//  its tables.  Table j multiplies any field element by the constant
+	//  alpha^(-j*CHIENTBLPOS), which is the step of ELP coefficient j
+	//  from one group of CHIENTBLPOS positions to the next.  The tables
+	//  take tParm*ffSize short words.  Each is made by multiplying every
+	//  element by its constant with ffMultConstBatch.
+	//  ROOTFINDAUTO picks the table Chien search if that fits in
+	//  CHIENTBLCACHEBYTES, otherwise the SIMD Chien search (which falls
+	//  back to the Chien search if the CPU has no AVX2).  ROOTFINDTUNED
+	//  builds the tables if they fit, so genRootFindTbl can time them.
 	//****************************************************************
-	int errFlg;
+	int jx,val,logStep,tblBytes;
+	unsigned short *multTbl;
+	const int nParm=pCdc->nParm;
 
-	// Note that special cases for quartic and cubic used only for m even
-	// while the special cases for linear and quadratic used for m odd or even
-	if (LnOrig==1){
-		linearElp(sigmaN,Loc); // No status returned - no errs detected in function
-		errFlg=0;
+	pCdc->chienTblBytes=0;
+	tblBytes=pCdc->tParm*pCdc->ffSize*(int)sizeof(pCdc->chienMultTbl[0]);
+	if (pCdc->rootFindOption==ROOTFINDAUTO){
+		if (tblBytes<=CHIENTBLCACHEBYTES){
+			pCdc->rootFindOption=ROOTFINDTABLE;
+		}
+		else {
+			pCdc->rootFindOption=ROOTFINDSIMD;
+		}
 	}
-	else if (LnOrig==2){
-		errFlg=quadraticElp(sigmaN,Loc);
+	if (pCdc->rootFindOption==ROOTFINDTUNED && tblBytes>CHIENTBLCACHEBYTES){
+		return; // Not a candidate
 	}
-	else if (LnOrig==3 && mParmOdd==0){
-		errFlg=cubicElp(nParm,sigmaN,Loc,alogTbl);
+	if (pCdc->rootFindOption!=ROOTFINDTABLE && pCdc->rootFindOption!=ROOTFINDTUNED){
+		return;
 	}
-	else if (LnOrig==4 && mParmOdd==0){
-		errFlg=quarticElp(nParm,sigmaN,Loc,alogTbl);
+	pCdc->chienMultTbl=(unsigned short *)malloc(tblBytes);
+	if (pCdc->chienMultTbl==0){
+		return; // Not built - rootFindChienTbl uses the Chien search
 	}
-	else
-	{
-		errFlg=chienSearch(sigmaN,Loc,alogTbl,logTbl,
-			LnOrig,numCodewordBytes,nParm,mParmOdd);
-		if (errFlg==0 && mParmOdd==0){
-			// m even - Chien will have divided down to quartic
-			errFlg|=quarticElp(nParm,sigmaN,Loc,alogTbl);
-		}
-		else if (errFlg==0 && mParmOdd==1){
-			// m odd - Chien will have divided down to quadratic
-			errFlg|=quadraticElp(sigmaN,Loc);
+	for (jx=1;jx<=pCdc->tParm;jx++){
+		logStep=nParm-((jx*CHIENTBLPOS)%nParm); // log of alpha^(-j*CHIENTBLPOS)
+		multTbl=&pCdc->chienMultTbl[(jx-1)*pCdc->ffSize];
+		for (val=0;val<pCdc->ffSize;val++){
+			multTbl[val]=(unsigned short)val;
 		}
+		ffMultConstBatch(pCdc,pCdc->alogTbl[logStep%nParm],multTbl,multTbl,pCdc->ffSize);
 	}
-	return (errFlg);
+	pCdc->chienTblBytes=tblBytes;
 }
-static int ffPFastQuotient(const int mIn[],int mDegIn,const int nIn[],
-						   int nDegIn,int quotient[],
-						   const int alogTbl[],const int logTbl[],
-						   const int nParm)
+
+static void genChienStepTbls(struct BchCodec *pCdc)
 {
 	//****************************************************************
-	//	Function: ffPFastQuotient
-	//
-	//  Function to compute a polynomial quotient in GF(2^m).
-	//
-	//  mDeg and nDeg are degrees.
+	//	Function: genChienStepTbls
 	//
+	//  Function to resolve the SIMD Chien search option and generate
+	//  its tables.  The SIMD Chien search keeps, for each ELP
+	//  coefficient j, the values sigma(j)*alpha^(-j*p) for chienLanes
+	//  consecutive positions p.  One step multiplies coefficient j by
+	//  the constant alpha^(-j*chienLanes) in every lane.  The multiply
+	//  by a constant is done with 16 entry tables (PSHUFB): the product
+	//  is the XOR of the products of the four nibbles of the operand,
+	//  one table per nibble and per byte of the product.  The tables
+	//  are also built for ROOTFINDTUNED, if the CPU has AVX2.  With 64
+	//  lanes and GFNI the multiplies are also made into GF2P8AFFINEQB
+	//  matrices for chienSearchGfni.
 	//****************************************************************
-	//
-	int k,logQDigit,errFlg,mDeg,nDeg;
-	int m[MAXCORR+1],n[MAXCORR+1];
+	int features,jx,qx,bx,nib,operand,prod,logStep,cols[MAXMPARM];
 
-	errFlg=0; // Clear error flag
-
-	// Copy the input degrees and arrays so not to modify them
-	mDeg=mDegIn;
-	nDeg=nDegIn;
-	for (k=0;k<=mDeg;k++){
-		m[k]=mIn[k];
-	}
-	for (k=0;k<=nDeg;k++){
-		n[k]=nIn[k];
-	}
-	if ((mDeg==0 && m[0]==0) || (nDeg==0 && n[0]==0)) {
-		// '-----zero on entry to ffPFastQuotient-----'
-		return (QUOZROONENTRYERR); // Return error
+	pCdc->chienLanes=0;
+	if (pCdc->rootFindOption!=ROOTFINDSIMD && pCdc->rootFindOption!=ROOTFINDTUNED){
+		return;
 	}
-	while (n[nDeg]==0 && nDeg>0) {
-		nDeg=nDeg-1;
+	features=cpuFeatures();
+	if ((features & CPUAVX512BW)!=0){
+		pCdc->chienLanes=64;
 	}
-	while (m[mDeg]==0 && mDeg>0) {
-		mDeg=mDeg-1;
+	else if ((features & CPUAVX2)!=0){
+		pCdc->chienLanes=32;
 	}
-	for (k=0;k<=mDeg-nDeg;k++) {  // For q array, # coeffs one gth degree
-		quotient[k]=0; // This init loop necessary - do not remove
+	else {
+		if (pCdc->rootFindOption==ROOTFINDSIMD){
+			pCdc->rootFindOption=ROOTFINDCHIEN; // No SIMD - use the Chien search
+		}
+		return;
 	}
-	while (1) {
-		if (mDeg<nDeg) {
-			// Quotient will be returned
-			break;
-		}else{
-			// Divide high coeffs to get tmp
-			if (n[nDeg]==0){
-				return (DIVZRODIV); // Divide by zero error
-			}
-			if (m[mDeg]>0){
-				logQDigit=logTbl[m[mDeg]]-logTbl[n[nDeg]];
-				if (logQDigit<0){
-					logQDigit+=nParm;
-				}
-				quotient[mDeg-nDeg]=alogTbl[logQDigit];
-				for (k=0;k<=mDeg;k++) {
-					if ((k>=mDeg-nDeg) && (n[k-(mDeg-nDeg)]>0)) {
-						m[k]=alogTbl[logTbl[n[k-(mDeg-nDeg)]]+logQDigit]^m[k];
-					}
+	for (jx=0;jx<=pCdc->tParm;jx++){
+		logStep=(int)(((long long)jx*pCdc->chienLanes)%pCdc->nParm);
+		logStep=(pCdc->nParm-logStep)%pCdc->nParm; // alpha^(-j*chienLanes)
+		for (qx=0;qx<4;qx++){
+			for (nib=0;nib<16;nib++){
+				operand=nib<<(4*qx);
+				prod=0;
+				if (operand!=0 && operand<pCdc->ffSize){
+					prod=pCdc->alogTbl[(pCdc->logTbl[operand]+logStep)%pCdc->nParm];
 				}
+				pCdc->chienStepTbl[jx][qx][0][nib]=(unsigned char)(prod & 0xff);
+				pCdc->chienStepTbl[jx][qx][1][nib]=(unsigned char)(prod >> 8);
 			}
-			while (m[mDeg]==0 && mDeg>0) {
-				mDeg=mDeg-1;
-			}
-			if (mDeg==0 && m[0]==0) {
-				// Quotient will be returned
-				break;
+		}
+		if (pCdc->chienLanes==64 && (pCdc->ffKernelFeatures & CPUGFNI)!=0){
+			for (bx=0;bx<pCdc->mParm;bx++){
+				cols[bx]=pCdc->alogTbl[(bx+logStep)%pCdc->nParm];
 			}
+			ffLinearMats(pCdc,cols,pCdc->chienStepMat[jx]);
 		}
 	}
-	return (0);
 }
 
-static int ffPFastMod(const int mIn[],int mDegIn,const int nIn[],
-					  int nDegIn,int remainder[],int *pRDeg,
-					  const int alogTbl[],const int logTbl[],
-					  const int nParm)
+static void genBitSliceTbls(struct BchCodec *pCdc)
 {
 	//****************************************************************
-	//	Function: ffPFastMod
-	//
-	//  Function to compute a polynomial remainder in GF(2^m).
-	//  Computes the poly m modulo the poly n over GF(2^m).
+	//	Function: genBitSliceTbls
 	//
-	//  mDeg and nDeg are degrees.
+	//  Function to generate the tables of the bit-sliced batch
+	//  decoder and to pick its width.  Syndrome S(j), j odd, is c(x)
+	//  evaluated at beta=alpha^j, so it can be computed from c(x)
+	//  modulo any multiple of the minimum polynomial of beta.  Reducing
+	//  modulo a trinomial x^a+x^b+1 is two XORs per codeword bit, where
+	//  reducing modulo the code generator polynomial is one XOR per
+	//  non-zero term of it.  x^a+x^b+1 is such a multiple if
+	//  beta^a=1+beta^b, so for each b the a is a discrete log to the
+	//  base beta.  The shortest trinomial is kept, or the binomial
+	//  x^ord+1 (ord the order of beta) if it is shorter.
 	//
+	//  The rows of one pass must fit the cache budget
+	//  BITSLICECACHEBYTES, else the width drops to the next narrower
+	//  SIMD width.
 	//****************************************************************
-	//
-	int k,logQDigit,errFlg,mDeg,nDeg;
-	// "+2" because input poly of deg MAXCORR is multiplied by x^2
-	int m[MAXCORR+2];
-	int n[MAXCORR+1];
+	int kx,bx,jVal,gcdVal,ord,jRed,jInv,aVal,logV,val,features;
+	int r0,r1,s0,s1,quo,tmp;
+	const int nParm=pCdc->nParm;
 
-	errFlg=0; // Clear error flag
-	// Copy the input degrees and arrays so not to modify them
-	mDeg=mDegIn;
-	nDeg=nDegIn;
-	for (k=0;k<=mDeg;k++){
-		m[k]=mIn[k];
+	for (kx=0;kx<pCdc->tParm;kx++){
+		jVal=2*kx+1;
+		// gcd(j,n) and the order of beta
+		r0=nParm;
+		r1=jVal;
+		while (r1!=0){
+			tmp=r0%r1;
+			r0=r1;
+			r1=tmp;
+		}
+		gcdVal=r0;
+		ord=nParm/gcdVal;
+		// jInv - inverse of j/gcd modulo ord (extended Euclid)
+		jRed=(jVal/gcdVal)%ord;
+		r0=ord;
+		r1=jRed;
+		s0=0;
+		s1=1;
+		while (r1!=0){
+			quo=r0/r1;
+			tmp=r0-quo*r1;
+			r0=r1;
+			r1=tmp;
+			tmp=s0-quo*s1;
+			s0=s1;
+			s1=tmp;
+		}
+		jInv=((s0%ord)+ord)%ord;
+		pCdc->bsFoldLen[kx]=ord; // The binomial x^ord+1
+		pCdc->bsFoldTap[kx]=0;
+		for (bx=1;bx<pCdc->bsFoldLen[kx];bx++){
+			val=1^pCdc->alogTbl[(int)(((long long)bx*jVal)%nParm)];
+			logV=pCdc->logTbl[val];
+			if (val==0 || logV%gcdVal!=0){
+				continue; // 1+beta^b is not a power of beta
+			}
+			aVal=(int)(((long long)(logV/gcdVal)*jInv)%ord);
+			if (aVal>bx && aVal<pCdc->bsFoldLen[kx]){
+				pCdc->bsFoldLen[kx]=aVal;
+				pCdc->bsFoldTap[kx]=bx;
+			}
+			else if (aVal<bx && aVal>0){
+				pCdc->bsFoldLen[kx]=bx;
+				pCdc->bsFoldTap[kx]=aVal;
+			}
+		}
 	}
-	for (k=0;k<=nDeg;k++){
-		n[k]=nIn[k];
+	for (bx=0;bx<pCdc->mParm;bx++){
+		pCdc->bsSquareTbl[bx]=ffMult(pCdc,1<<bx,1<<bx);
 	}
-	if ((mDeg==0 && m[0]==0) || (nDeg==0 && n[0]==0)) {
-		// '-----zero on entry to ffPFastMod-----'
-		return (MODZROONENTRYERR); // Return error
+	// The ring must hold the longest remainder plus the row being reduced
+	val=0;
+	for (kx=0;kx<pCdc->tParm;kx++){
+		if (pCdc->bsFoldLen[kx]>val){
+			val=pCdc->bsFoldLen[kx];
+		}
 	}
-	while (n[nDeg]==0 && nDeg>0) {
-		nDeg=nDeg-1;
+	if (val>pCdc->numCodewordBytes*8){
+		val=pCdc->numCodewordBytes*8;
 	}
-	while (m[mDeg]==0 && mDeg>0) {
-		mDeg=mDeg-1;
+	pCdc->bsFoldRows=1;
+	while (pCdc->bsFoldRows<=val){
+		pCdc->bsFoldRows*=2;
 	}
-	while (1) {
-		if (mDeg<nDeg) {
-			for (k=0;k<=nDeg-1;k++) {
-				if (k<=mDeg) {
-					remainder[k]=m[k];
-				}else{
-					remainder[k]=0;
-				}
-			}
-			*pRDeg=mDeg;
-			break;
-		}else{
-			// Divide high coeffs to get tmp
-			if (n[nDeg]==0){
-				return (DIVZRODIV); // Divide by zero error
-			}
-			if (m[mDeg]>0){
-				logQDigit=logTbl[m[mDeg]]-logTbl[n[nDeg]];
-				if (logQDigit<0){
-					logQDigit+=nParm;
-				}
-				for (k=0;k<=mDeg;k++) {
-					if ((k>=mDeg-nDeg) && (n[k-(mDeg-nDeg)]>0)) {
-						n[k-(mDeg-nDeg)]=
-							alogTbl[logTbl[n[k-(mDeg-nDeg)]]+logQDigit];
-						m[k]=(n[k-(mDeg-nDeg)]^m[k]); // add vectors
-					}
-				}
-			}
-			while (m[mDeg]==0 && mDeg>0) {
-				mDeg=mDeg-1;
-			}
-			if (mDeg==0 && m[0]==0) {
-				for (k=0;k<=nDeg-1;k++) {
-					remainder[k]=0;
-				}
-				*pRDeg=0;
-				break;
-			}
-		}
+	features=cpuFeatures();
+	pCdc->bitSliceWords=1;
+	if ((features & CPUAVX2)!=0){ // The transpose needs AVX2
+		pCdc->bitSliceWords=((features & CPUAVX512)!=0) ? 8 : 4;
+	}
+	while (pCdc->bitSliceWords>1 &&
+		pCdc->numCodewordBytes*8*pCdc->bitSliceWords*8>BITSLICECACHEBYTES){
+		pCdc->bitSliceWords=(pCdc->bitSliceWords==8) ? 4 : 1;
 	}
-	return (0);
 }
 
-static int ffPFastGcd(const int mIn[],int mDegIn,const int nIn[],
-					  int nDegIn,int gcdresult[],int *pDegOut,
-					  const int alogTbl[],const int logTbl[],const int nParm)
+static void genDirectLocTbl(struct BchCodec *pCdc)
 {
 	//****************************************************************
-	//	Function: ffPFastGcd
-	//
-	//  Function to compute a polynomial greatest common divisor
-	//  in GF(2^m).  m and n are the GF(2^m) polynomials for which
-	//  the gcd is required.
-	//
-	//  mDeg and nDeg are degrees.
-	//
-	//  This function implements Euclids algorithm.  MY reference is
-	//  page 149 of the Berlekamp book.
-	//
-	//  E. Berlekamp (1968), Algebraic Coding Theory, McGraw-Hill.
+	//	Function: genDirectLocTbl
 	//
+	//  Function to generate the table directDecode uses for t=2.  For
+	//  two errors X1, X2, S1=X1+X2 and S3=X1^3+X2^3, so X1/S1 and X2/S1
+	//  are the roots y of y^2+y=1+S3/S1^3.  Entry e holds the logs of
+	//  both roots for S3/S1^3=alpha^e, found with ffQuadFun.  Clears
+	//  directDecodeFlg if t>2 (t=1 needs no table) or if the table
+	//  cannot be allocated.
 	//****************************************************************
-	//
-	int k,logQDigit,errFlg,mDeg,nDeg;
-	int m[MAXCORR+1],n[MAXCORR+1];
+	int ex,y1,c;
+	const int nParm=pCdc->nParm;
 
-	// Copy the input degrees and arrays so not to modify them
-	mDeg=mDegIn;
-	nDeg=nDegIn;
-	errFlg=0;
-	for (k=0;k<=mDeg;k++){
-		m[k]=mIn[k];
-	}
-	for (k=0;k<=nDeg;k++){
-		n[k]=nIn[k];
+	if (pCdc->tParm>2){
+		pCdc->directDecodeFlg=0;
 	}
-	if ((mDeg==0 && m[0]==0) || (nDeg==0 && n[0]==0)) {
-		// '-----zero on entry to ffPFastGcd-----'
-		return (GCDZROONENTRYERR); // Return error
+	if (pCdc->directDecodeFlg==0 || pCdc->tParm!=2){
+		return;
 	}
-	while (n[nDeg]==0 && nDeg>0) {
-		nDeg=nDeg-1;
+	pCdc->directLocTbl=(FfLog *)malloc(2*pCdc->ffSize*sizeof(FfLog));
+	if (pCdc->directLocTbl==0){
+		pCdc->directDecodeFlg=0;
+		return;
 	}
-	while (m[mDeg]==0 && mDeg>0) {
-		mDeg=mDeg-1;
+	for (ex=0;ex<=nParm;ex++){
+		c=(ex<nParm) ? 1^pCdc->alogTbl[ex] : 1; // ex=nParm for S3=0
+		y1=ffQuadFun(pCdc,c);
+		if (c==0 || y1==0){
+			// One error (S3=S1^3) or no roots - no two locations
+			pCdc->directLocTbl[2*ex]=FFLOGZERO;
+			pCdc->directLocTbl[2*ex+1]=FFLOGZERO;
+		}
+		else {
+			// In next line, if ever use basis other than poly then "1" may
+			// have to change to alog[0] (as in quadraticElp)
+			pCdc->directLocTbl[2*ex]=pCdc->logTbl[y1];
+			pCdc->directLocTbl[2*ex+1]=pCdc->logTbl[y1^1];
+		}
 	}
-	while (1) {
-		if (nDeg<=mDeg) {
-			// Divide high coeffs to get tmp
-			if (n[nDeg]==0){
-				return (DIVZRODIV); // Divide by zero error
-			}
-			if (m[mDeg]>0){
-				logQDigit=logTbl[m[mDeg]]-logTbl[n[nDeg]];
-				if (logQDigit<0){
-					logQDigit+=nParm;
-				}
-				for (k=0;k<=mDeg;k++) {
-					if ((k>=mDeg-nDeg) && (n[k-(mDeg-nDeg)]>0)) {
-						n[k-(mDeg-nDeg)]=
-							alogTbl[logTbl[n[k-(mDeg-nDeg)]]+logQDigit];
-						m[k]=(n[k-(mDeg-nDeg)]^m[k]); // add vectors
-					}
-				}
-			}
-			while (m[mDeg]==0 && mDeg>0) {
-				mDeg=mDeg-1;
-			}
-			if (mDeg==0 && m[0]==0) {
-				for (k=0;k<=nDeg;k++) {
-					gcdresult[k]=n[k];
-				}
-				*pDegOut=nDeg;
-				break;
-			}
-		}else{
-			// Divide high coeffs to get tmp
-			if (m[mDeg]==0){
-				return (DIVZRODIV); // Divide by zero error
-			}
-			if (n[nDeg]>0){
-				logQDigit=logTbl[n[nDeg]]-logTbl[m[mDeg]];
-				if (logQDigit<0){
-					logQDigit+=nParm;
-				}
-				for (k=0;k<=nDeg;k++) {
-					if ((k>=nDeg-mDeg) && (m[k-(nDeg-mDeg)])){
-						m[k-(nDeg-mDeg)]=alogTbl[logTbl[m[k-(nDeg-mDeg)]]+logQDigit];
-						n[k]=(m[k-(nDeg-mDeg)]^n[k]); // add vectors
-					}
-				}
-			}
-			while (n[nDeg]==0 && nDeg>0) {
-				nDeg=nDeg-1;
-			}
-			if (nDeg==0 && n[0]==0) {
-				for (k=0;k<=mDeg;k++) {
-					gcdresult[k]=m[k];
-				}
-				*pDegOut=mDeg;
-				break;
-			}
+}
+
+static void pickKeyEqLanes(struct BchCodec *pCdc)
+{
+	//****************************************************************
+	//	Function: pickKeyEqLanes
+	//
+	//  Function to pick the riBM SIMD width for keyEqSolver - 64 terms
+	//  per step with AVX-512BW, 32 with AVX2, else 1 (the scalar riBM,
+	//  and berMas).  bchCodecInit sets keyEqSolver before calling this
+	//  (through genDecodeTbls).
+	//****************************************************************
+	pCdc->keyEqLanes=1;
+	if (pCdc->keyEqSolver==KEYEQRIBM){
+		if ((cpuFeatures() & CPUAVX512BW)!=0){
+			pCdc->keyEqLanes=64;
+		}
+		else if ((cpuFeatures() & CPUAVX2)!=0){
+			pCdc->keyEqLanes=32;
 		}
 	}
-	return (0);
 }
 
-static int BTA(const int sigmaN[],int Loc[],const int alogTbl[],
-			   const int logTbl[],const int LnOrig,const int nParm,
-			   const int mParmOdd,const int mParm,const int LogZVal,
-			   const int ffSize)
+static void genDecodeTbls(struct BchCodec *pCdc)
 {
 	//****************************************************************
-	//	Function: BTA
+	//	Function: genDecodeTbls
 	//
-	//  Function that implements the Berlekamp trace method for
-	//	finding roots of finite field polynomials.  The finite
-	//  field supported by this function is GF(2^m).
+	//  Function to generate the optional decode tables - the syndrome
+	//  tables (if syndromeTblFlg is set) and the table or SIMD Chien
+	//  search tables (for rootFindOption ROOTFINDTABLE, ROOTFINDSIMD,
+	//  ROOTFINDAUTO or ROOTFINDTUNED) and the t=2 direct decode table
+	//  (if directDecodeFlg is set) - to set up the GF(2^m) kernels and
+	//  to pick the riBM SIMD width.
+	//  The bit-sliced batch decode tables are always built.  For
+	//  ROOTFINDTUNED the root finders are then calibrated.  Call
+	//  after genEncodeTbls.
+	//****************************************************************
+	if (pCdc->syndromeTblFlg!=0){
+		genSyndromeTbls(pCdc);
+	}
+	genDirectLocTbl(pCdc);
+	genFfKernelConsts(pCdc);
+	genChienMultTbls(pCdc); // Resolves ROOTFINDAUTO
+	genChienStepTbls(pCdc);
+	pickKeyEqLanes(pCdc);
+	genBitSliceTbls(pCdc);
+	genRootFindTbl(pCdc);
+}
+
+static void bchCodecFree(struct BchCodec *pCdc)
+{
+	//****************************************************************
+	//	Function: bchCodecFree
 	//
-	//  My references for the BTA algorithm are a paper [4] by
-	//  Berlekamp and three papers [1,2,3] that discuss a BTA derivative
-	//  algorithm called BTZ.  In this program I implemented much of the
-	//  math from BTZ, but instead of implementing the special root
-	//  finding methods of low degree polynomials by Zinoviev, I
-	//  implemented alternative methods.  References [1-4] can be found
-	//  on the internet, but there may be a fee for some of them.
+	//  Function to release the tables bchCodecInit allocated.  The
+	//  pointers are cleared, so the context may be initialized again.
+	//****************************************************************
+	free(pCdc->alogTbl);
+	free(pCdc->logTbl);
+	free(pCdc->sliceTbl);
+	free(pCdc->deltaTbl);
+	free(pCdc->synTbl);
+	free(pCdc->directLocTbl);
+	free(pCdc->chienMultTbl);
+	pCdc->alogTbl=0;
+	pCdc->logTbl=0;
+	pCdc->sliceTbl=0;
+	pCdc->deltaTbl=0;
+	pCdc->synTbl=0;
+	pCdc->directLocTbl=0;
+	pCdc->chienMultTbl=0;
+	pCdc->chienTblBytes=0;
+}
+
+static int initFieldAndCgp(struct BchCodec *pCdc,int mParm,int ffPoly,int tParm)
+{
+	//****************************************************************
+	//	Function: initFieldAndCgp
 	//
-	//  1) V. Herbert. Efficient root finding of polynomials over fields
-	//  of characteristic 2, WEWoRC 2009, INRIA Paris-Rocquencourt.
-	//  2) V. Herbert. Efficient root finding of polynomials over fields
-	//  of characteristic 2, INRIA Paris-Rocquencourt.
-	//  3) B. Biswas, V. Herbert. Efficient root finding of polynomials
-	//  over fields of characteristic 2, CRI INRIA Paris-Rocquencourt.
-	//  4) E. Berlekamp (1970), Factoring polynomials over large finite
-	//  fields, Mathematics of Computation, v. 24, 1970, pp. 713-735.
+	//  Function to do the first part of bchCodecInit - the field
+	//  tables, the code generator polynomial and the redundancy size.
+	//  main calls it on its own to learn the longest data field the
+	//  code allows before it asks for the data length.  The tables of
+	//  an earlier code are freed first.  Enter 0 for ffPoly to have
+	//  the generator polynomial picked for the field.
 	//
-	//  ---Overview of the Berlekamp Trace Algorithm (BTA)---. The BTA
-	//  as defined by Berlekamp, splits the polynomial to be factored
-	//  into two factors using a polynomial greatest common divisor
-	//  (gcd) function.  Each resulting factor is also split into
-	//  two factors and so on until there exist only degree one factors.
-	//  To split a polynomial the greatest common divisor function is
-	//  performed on the polynomial and a trace polynomial that has as
-	//  its roots about half the elements of the finite field employed.
+	//  Returns 0 or an error flag.
+	//****************************************************************
+	int kx,errFlg;
+
+	bchCodecFree(pCdc);
+	if (mParm<MINMPARM || mParm>MAXMPARM || tParm<1 || tParm>MAXCORR){
+		return(BADCODEPARM);
+	}
+	pCdc->mParm=mParm;
+	pCdc->ffSize=1;
+	for (kx = 1; kx <= mParm; kx++){
+		pCdc->ffSize *= 2;
+	}
+	if (pCdc->ffSize > MAXFFSIZE || tParm*mParm>=pCdc->ffSize){
+		return(BADCODEPARM);
+	}
+	pCdc->mParmOdd = mParm % 2;
+	pCdc->nParm=pCdc->ffSize - 1;	// n = (2^m)-1
+	pCdc->logZVal=2*pCdc->nParm;
+	pCdc->tParm=tParm;
+	if (ffPoly!=0 && (ffPoly<=pCdc->ffSize || ffPoly>=2*pCdc->ffSize)){
+		return(BADCODEPARM);
+	}
+	pCdc->ffPoly=ffPoly;
+	if (pCdc->ffPoly==0){
+		pickFieldGenPoly(pCdc);
+	}
+	pCdc->alogTbl=(FfElem *)malloc(2*pCdc->ffSize*sizeof(FfElem));
+	pCdc->logTbl=(FfLog *)malloc(pCdc->ffSize*sizeof(FfLog));
+	if (pCdc->alogTbl==0 || pCdc->logTbl==0){
+		return(TBLALLOCERR);
+	}
+	bchInit(pCdc);
+	if (chkLogAlogTbls(pCdc)>ZERO){
+		return(LOGALOGBUILDERR);
+	}
+	errFlg=genCodeGenPoly(pCdc);
+	if (errFlg!=0){
+		return(errFlg);
+	}
+	pCdc->numRedunBits = pCdc->cgpDegree;
+	pCdc->numRedunBytes = (pCdc->cgpDegree+7)/8;
+	return(0);
+}
+
+static int bchCodecInit(struct BchCodec *pCdc,int mParm,int ffPoly,int tParm,
+						int numDataBytes,int rootFindOption,int keyEqSolver,
+						int bitSliceFlg)
+{
+	//****************************************************************
+	//	Function: bchCodecInit
 	//
-	//  It is faster to stop splitting when the degree of a factor falls
-	//  below a threshold and instead to find the roots of such factors
-	//  by even faster methods for low degree polynomials. In this
-	//  function I stop splitting at degree four for even “m” (“m” of
-	//  GF(2^m)) and at degree two for odd “m”.  I am currently using
-	//  special root finding algorithms for linear, quadratic, cubic
-	//  and quartic polynomials.  Perhaps more time could be squeezed
-	//  out of root finding by stopping the splitting process at degree
-	//  six or less by using special root finding algorithms for quintic
-	//  and sextic polynomials as well.
+	//  Function to fill in a codec context in one call - field tables,
+	//  code generator polynomial, data and redundancy sizes, then the
+	//  encode and decode tables.  Enter 0 for ffPoly to have the
+	//  generator polynomial picked for the field.  rootFindOption is
+	//  ROOTFINDCHIEN to ROOTFINDBATCH, keyEqSolver KEYEQBERMAS or
+	//  KEYEQRIBM (the riBM SIMD width is picked for it) and bitSliceFlg
+	//  "1" to have bchDecodeBatch decode bit-sliced.  The optional
+	//  tables that cannot be allocated are not built and their options
+	//  fall back to the paths that need no table.
 	//
-	//  This function uses several techniques to achieve speed.  For
-	//  example it does not call functions to do finite field multiplies
-	//  or divides, they are done inline.  And at one point a loop is
-	//  unrolled (straight line coded).  There are still some places in
-	//  the function where speed can be increased a bit.
+	//  Returns 0 if the context is ready for bchEncode/bchDecode,
+	//  otherwise an error flag.
+	//****************************************************************
+	int errFlg;
+
+	if (rootFindOption<ROOTFINDCHIEN || rootFindOption>=ROOTFINDOPTIONS ||
+		(keyEqSolver!=KEYEQBERMAS && keyEqSolver!=KEYEQRIBM) ||
+		bitSliceFlg<0 || bitSliceFlg>1){
+		bchCodecFree(pCdc);
+		return(BADCODEPARM);
+	}
+	errFlg=initFieldAndCgp(pCdc,mParm,ffPoly,tParm);
+	if (errFlg!=0){
+		return(errFlg);
+	}
+	if (numDataBytes<0 || numDataBytes>(pCdc->nParm-pCdc->cgpDegree)/8){
+		return(BADCODEPARM);
+	}
+	pCdc->rootFindOption=rootFindOption;
+	pCdc->numDataBytes = numDataBytes;
+	pCdc->numCodewordBytes = pCdc->numDataBytes+pCdc->numRedunBytes;
+	pCdc->numDataBits = pCdc->numDataBytes*8;
+	pCdc->kParm = pCdc->numDataBits;
+	pCdc->numRedunWords = (pCdc->numRedunBytes+3)/4;
+	pCdc->encodeSliceBytes = ENCODESLICEBYTES;
+	pCdc->remainderEngine = REMENGAUTO;
+	pCdc->encodeLanes = ENCODELANES;
+	pCdc->syndromeTblFlg = SYNDROMETBLS;
+	pCdc->chienShortenedFlg = CHIENSHORTENED;
+	pCdc->keyEqSolver = keyEqSolver;
+	pCdc->lowWeightFlg = LOWWEIGHTDECODE;
+	pCdc->directDecodeFlg = DIRECTDECODE;
+	pCdc->ffKernelFlg = FFKERNELSIMD;
+	pCdc->verifyCorrFlg = VERIFYCORR;
+	pCdc->affineElpDeg = AFFINEELPDEG;
+	pCdc->bitSliceFlg = bitSliceFlg;
+	pCdc->deltaTblFlg = DELTAENCODE;
+	cvtCgpBitToCgpWord(pCdc);
+	genEncodeTbls(pCdc);
+	genDecodeTbls(pCdc);
+	return(0);
+}
+
+static void clearWriteCW()
+{
 	//****************************************************************
+	//	Function: clearWriteCW
 	//
-	int errFlg,degCF,tmpLogQ,tmpN,tmpLogD;
-	int tmpVk,factorTblNxtEntryIdx,logALPHAi;
-	int skipFactorCurrIdxInc,tmp[MAXCORR+1];
-	int rootsFoundIdx,twoToKx1Pwr,specialCaseFlg;
-	int jx,kx,kx0,kx1,kx2,kx3,kx4,degA,degB,junk;
-	int TiCoeff,tmpDeg,tmpForSq;
-	int factorTblCurrPosIdx;
-	int tmpPoly[MAXCORR+1];
-	int p[MAXCORR+1];
-	int accumResidue[MAXCORR],v[MAXCORR];
-	int MDblShiftRowHasAZero[MAXCORR];
-	int MResiduesRowHasAZero[MAXMPARM];
-	int degTbl[MAXCORR],alphaTbl[MAXCORR],alphaFlgs[MAXMPARM];
-	int factorA[MAXCORR+1],factorB[MAXCORR+1],currFactor[MAXCORR+1];
-	int workTiModP[MAXCORR],roots[MAXCORR];
-	// Note +2.  Need 2 extra spaces cause poly multiplied by x^2
-	int tmpV[MAXCORR+2],tmpVBack[MAXCORR+2];
-	int MResidues[MAXMPARM][MAXCORR];
-	int MDblShift[MAXCORR][MAXCORR];
-	int TiModP[MAXCORR+1][MAXCORR+1];
-	int factorTbl[MAXCORR][MAXCORR+1];
+	//	Function to clear write data.
+	//****************************************************************
+	int kx;
 
-	errFlg=0; // Clear error flag
+	// Clears gblCodeword including pad bits
+	for (kx=0;kx<gblCodec.numCodewordBytes;kx++){
+		gblCodeword[kx] = 0; // Clear gblCodeword
+	}
+}
+
+static void genWriteData()
+{
+	//****************************************************************
+	//	Function: genWriteData
 	//
-	// Flip "sigmaN" & put in "p" to make input format compatible
-	// with this function
-	for (kx=0;kx<=LnOrig;kx++){
-		tmpPoly[kx]=sigmaN[kx];
+	//	Function to generate random data byte values for encoding.  No
+	//  Matter what size of finite field we are using, the encoder
+	//  operates on bytes in byte parallel.
+	//****************************************************************
+	int kx;
+
+	// Clear gblCodeword including pad bits
+	for (kx=0;kx<gblCodec.numCodewordBytes;kx++){
+		gblCodeword[kx] = 0; // Clear gblCodeword
 	}
-	for (kx=0;kx<=LnOrig;kx++){
-		p[kx]=tmpPoly[LnOrig-kx];
+	// Put random user data in gblCodeword - there are no pad bits in user data
+	for (kx=0;kx<gblCodec.numDataBytes;kx++){
+		gblCodeword[kx] = (unsigned char)(getRandom() % BYTESTATES);// Reduce random # to byte size
 	}
-	// ========== CONSTRUCT THE MDblShift MATRIX ===================
-	// Using this matrix does the same thing as shifting twice a finite
-	// field polynomial shift register implementing the poly "p".  Using
-	// the matrix allows the number of multiplies to be cut in about half
-	// compared to actual shifting of a software shift register twice.
+}
 
-	// Clear "row has a zero" flgs
-	for (kx=0;kx<=LnOrig-1;kx++) {
-		MDblShiftRowHasAZero[kx]=0;
-	}
-	// Create the matrix to be used for double shifts
-	for (kx=0;kx<=LnOrig-1;kx++) {
-		if (2*kx<LnOrig) {
-			// Initialize row to "0"s, then stuff a "1"
-			for (jx=0;jx<=LnOrig-1;jx++) {
-				MDblShift[kx][jx]=LogZVal; // RHS is log of zero
+static void shiftInDataBytesTbl(const struct BchCodec *pCdc,unsigned int SR[],
+								const unsigned char data[],int numBytes)
+{
+	//****************************************************************
+	//	Function: shiftInDataBytesTbl
+	//
+	//  Shifts numBytes data bytes, with feedback, into the software
+	//  shift register SR (numRedunWords words, highest order word
+	//  first) using the encode table.  This is the table remainder
+	//  engine used by both the encoder and computeRemainder.
+	//
+	//  With slicing tables (encodeSliceBytes 4 or 8) the shift register
+	//  is shifted once per 4 or 8 data bytes.  The feedback bytes are
+	//  the high order bytes of SR XORed with the data bytes.  Each
+	//  feedback byte addresses the table for its distance from the end
+	//  of the slice, and the table entries are XORed into the shifted
+	//  SR.  This gives the same result as the byte at a time method
+	//  because the shift register is linear.  Bytes left over at the
+	//  end are processed one at a time.
+	//****************************************************************
+	unsigned int fdbk,fdbkSav,fdbkWords[MAXSLICEBYTES/4];
+	const unsigned int *tblEntry;
+	const unsigned int *sliceTbls[MAXSLICEBYTES];
+	int jx,kx,dataAddr,wordShift;
+	const int numRedunWords=pCdc->numRedunWords;
+	const int sliceBytes=pCdc->encodeSliceBytes;
+	const unsigned int *encodeTbl=pCdc->encodeTbl;
+
+	dataAddr=0;
+	if (sliceBytes>1){
+		wordShift=sliceBytes/4; // Slice is a whole number of 32 bit words
+		// Table for each byte position of a slice - last byte uses encodeTbl
+		for (kx=0;kx<sliceBytes-1;kx++){
+			sliceTbls[kx]=&pCdc->sliceTbl[(sliceBytes-2-kx)*BYTESTATES*numRedunWords];
+		}
+		sliceTbls[sliceBytes-1]=encodeTbl;
+		for (; dataAddr+sliceBytes <= numBytes; dataAddr+=sliceBytes) {
+			// Feedback words - high order SR words XOR data bytes
+			for (kx=0;kx<wordShift;kx++){
+				fdbk=((unsigned int)data[dataAddr+4*kx]<<24) ^
+					((unsigned int)data[dataAddr+4*kx+1]<<16) ^
+					((unsigned int)data[dataAddr+4*kx+2]<<8) ^
+					(unsigned int)data[dataAddr+4*kx+3];
+				fdbkWords[kx]=(kx<numRedunWords) ? fdbk^SR[kx] : fdbk;
 			}
-			MDblShift[kx][2*kx]=0; // RHS is log of one
-			MDblShiftRowHasAZero[kx]=1; // Each of these rows has at least one "0"
-		}else{
-			// Next few lines - Start multiply residue poly by x^2
-			tmpV[0]=0;
-			tmpV[1]=0;
-			// Finish multiply residue poly by x^2
-			for (jx=0;jx<=LnOrig-1;jx++) {
-				if (MDblShift[kx-1][jx]==LogZVal) {
-					tmpV[jx+2]=0;
-				}else{
-					tmpV[jx+2]=alogTbl[MDblShift[kx-1][jx]];
-				}
+			for (jx=0; jx < numRedunWords;jx++){ // Shift SR by the whole slice
+				SR[jx] = (jx+wordShift < numRedunWords) ? SR[jx+wordShift] : 0;
 			}
-			// --------------
-			// Deg of residue is (LnOrig-1), "+2" is for the inserted zeros
-			tmpDeg=LnOrig+1; // This is (LnOrig-1)+2
-			errFlg |= ffPFastMod(tmpV,tmpDeg,p,LnOrig,tmpVBack,&junk,
-				alogTbl,logTbl,nParm);
-			if (errFlg>0){
-				return (errFlg);
+			for (kx=0;kx<sliceBytes;kx++){
+				tblEntry=sliceTbls[kx]+((fdbkWords[kx/4] >> (24-8*(kx%4))) & 0x000000ff)*numRedunWords;
+				for (jx=0; jx < numRedunWords;jx++){
+					SR[jx] ^= tblEntry[jx];
+				}
 			}
-			for (jx=0;jx<=LnOrig-1;jx++){
-				tmpV[jx]=tmpVBack[jx];
+		}
+	}
+	for (; dataAddr < numBytes; dataAddr++) {
+		fdbk = 0;
+		for (jx=numRedunWords-1; jx >=0 ;jx--){
+			// IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT.
+			// WILL HAVE TO PROCESS FROM HIGH ADDRESS BACK TOWARDS ZERO
+			fdbkSav = fdbk;
+			// 32 bits per int - but process 8 bits at a time (8 bits unrelated to "m")
+			fdbk = (SR[jx] >> 24) & 0x000000ff;
+			SR[jx] = (SR[jx] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
+		}
+		fdbk ^= (unsigned int)data[dataAddr];
+		// IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT
+		tblEntry=encodeTbl+fdbk*numRedunWords;
+		for (jx=0; jx < numRedunWords;jx++){
+			SR[jx] ^= tblEntry[jx];
+		}
+	}
+}
+
+#if BCHX86SIMD
+TARGETCLMUL static void shiftInDataVecsClmul(const struct BchCodec *pCdc,
+											unsigned int SR[],const struct BchIoVec vec[],
+											int numBytes)
+{
+	//****************************************************************
+	//	Function: shiftInDataVecsClmul
+	//
+	//  Carry-less multiply version of shiftInDataBytesTbl.  SR must be
+	//  zero on entry.  The data is folded 64 bits at a time into an
+	//  accumulator congruent to the data modulo g(x) (see
+	//  genClmulFoldConsts).  Then the accumulator, which is only one
+	//  word longer than the redundancy, is shifted into SR by the table
+	//  method.  Since the accumulator and the data are congruent modulo
+	//  g(x), SR ends up bit-identical to shifting in the data itself.
+	//
+	//  The numBytes data bytes are read from the segments in vec.  A
+	//  data word that lies in one segment is read directly, one that
+	//  straddles segments a byte at a time.
+	//****************************************************************
+	unsigned long long accum[MAXFOLDWORDS],prod[2],fdbk,dataWord;
+	unsigned char foldBytes[8*MAXFOLDWORDS];
+	const unsigned char *data;
+	int jx,kx,dataAddr,leadBytes,vx,segAddr;
+	const int foldWords=pCdc->clmulFoldWords;
+	const unsigned long long *foldConst=pCdc->clmulFoldConst;
+	__m128i fdbkVec,constVec;
+
+	for (kx=0;kx<foldWords;kx++){
+		accum[kx]=0;
+	}
+	vx=0;		// Segment and byte in it of the next data byte
+	segAddr=0;
+	// Bytes ahead of the first whole 64 bit data word
+	leadBytes=numBytes%8;
+	for (dataAddr=0;dataAddr<leadBytes;dataAddr++){
+		while (segAddr>=vec[vx].len){
+			vx++;
+			segAddr=0;
+		}
+		accum[0]=(accum[0] << 8) | (unsigned int)vec[vx].base[segAddr++];
+	}
+	for (; dataAddr < numBytes; dataAddr+=8) {
+		dataWord=0;
+		if (vec[vx].len-segAddr>=8){
+			data=vec[vx].base+segAddr;
+			for (kx=0;kx<8;kx++){
+				dataWord=(dataWord << 8) | (unsigned int)data[kx];
 			}
-			for (jx=0;jx<=LnOrig-1;jx++) {
-				if (tmpV[jx]==0) {
-					MDblShiftRowHasAZero[kx]=1; // Set "has a zero" flg
+			segAddr+=8;
+		}
+		else {
+			for (kx=0;kx<8;kx++){
+				while (segAddr>=vec[vx].len){
+					vx++;
+					segAddr=0;
 				}
-				MDblShift[kx][jx]=logTbl[tmpV[jx]];
+				dataWord=(dataWord << 8) | (unsigned int)vec[vx].base[segAddr++];
 			}
 		}
+		// Shift up one word, the data word enters at the bottom
+		fdbk=accum[foldWords-1];
+		for (kx=foldWords-1;kx>0;kx--){
+			accum[kx]=accum[kx-1];
+		}
+		accum[0]=dataWord;
+		// Fold the word shifted out back in
+		fdbkVec=_mm_set_epi64x(0,(long long)fdbk);
+		for (jx=0;jx<foldWords-1;jx++){
+			constVec=_mm_loadl_epi64((const __m128i *)&foldConst[jx]);
+			_mm_storeu_si128((__m128i *)prod,_mm_clmulepi64_si128(fdbkVec,constVec,0x00));
+			accum[jx]^=prod[0];
+			accum[jx+1]^=prod[1];
+		}
 	}
-	// ========== BEGIN USING THE MDblShift MATRIX TO COMPUTE RESIDUES ====================
-	// Residues means residues of Trace(Alpha*z) mod p.
-	// Clear temp vector for first TiModP which is computed as residues
-	// are computed. This is for first TiModP only, all other TiModP
-	// vectors are computed in the factor loop.
-	for (kx=0;kx<=LnOrig-1;kx++) {
-		workTiModP[kx]=0;
+	// Accumulator to bytes, high order first
+	for (kx=0;kx<foldWords;kx++){
+		for (jx=0;jx<8;jx++){
+			foldBytes[8*kx+jx]=(unsigned char)(accum[foldWords-1-kx] >> (56-8*jx));
+		}
 	}
-	// Clear "row has a zero" flgs
-	for (kx=0;kx<=mParm-1;kx++) {
-		MResiduesRowHasAZero[kx]=0;
+	shiftInDataBytesTbl(pCdc,SR,foldBytes,8*foldWords);
+}
+#endif
+
+static void shiftInDataVecs(const struct BchCodec *pCdc,unsigned int SR[],
+							const struct BchIoVec vec[],int numVecs,int numBytes)
+{
+	//****************************************************************
+	//	Function: shiftInDataVecs
+	//
+	//  Shifts the numBytes data bytes in the numVecs segments of vec,
+	//  with feedback, into the software shift register SR, which must
+	//  be zero on entry.  This is the inner loop of both the encoder
+	//  and computeRemainder.  It calls the remainder engine selected
+	//  at initialization.  The table engine carries SR from one
+	//  segment to the next.
+	//****************************************************************
+	int vx;
+
+#if BCHX86SIMD
+	if (pCdc->remainderEngine==REMENGCLMUL){
+		shiftInDataVecsClmul(pCdc,SR,vec,numBytes);
+		return;
 	}
-	// Initialize the "v" array
-	for (kx=0;kx<=LnOrig-1;kx++) {
-		v[kx]=0;
+#endif
+	for (vx=0;vx<numVecs;vx++){
+		shiftInDataBytesTbl(pCdc,SR,vec[vx].base,vec[vx].len);
 	}
-	v[1]=1; // stuff a "1" in the x^1 position
-	for (kx1=0;kx1<=mParm-1;kx1++) {  // Loop thru all the residues to be computed
-		if (v[0]==0  ) {// This decision for speed
-			MResiduesRowHasAZero[kx1]=1; // Set "has a zero" flg
-			// Loop # one - faster, no need to check all entries for 0
-			for (jx=0;jx<=LnOrig-1;jx++) {  // Add an entry to residue matrix
-				workTiModP[jx]=(workTiModP[jx]^v[jx]); // Developing first TiModP
-				// RHS is in log form
-				MResidues[kx1][jx]=logTbl[v[jx]];
-			}
-		}else{
-			// Loop # two - slower, must check all entries for 0
-			for (jx=0;jx<=LnOrig-1;jx++) {  // Add an entry to residue matrix
-				if (v[jx]==0) {
-					MResiduesRowHasAZero[kx1]=1; // Set "has a zero" flg
-				}
-				workTiModP[jx]=(workTiModP[jx]^v[jx]); // Developing first TiModP
-				// RHS is in log form
-				MResidues[kx1][jx]=logTbl[v[jx]];
-			}
+}
+
+static int ioVecLenErr(const struct BchIoVec vec[],int numVecs,int numBytes)
+{
+	//****************************************************************
+	//	Function: ioVecLenErr
+	//
+	//  Returns IOVECLENERR if the segments in vec do not hold exactly
+	//  numBytes bytes, else 0.
+	//****************************************************************
+	int vx,sum;
+
+	sum=0;
+	for (vx=0;vx<numVecs;vx++){
+		if (vec[vx].len<0){
+			return(IOVECLENERR);
 		}
-		// NEXT LINE - THE +1 NEEDED IN BOTH MATLAB AND "C"
-		if (kx1+1<mParm ) {// This "if" just skips to end of loop on last loop pass
-			for (jx=0;jx<=LnOrig-1;jx++) {
-				if (v[jx]!=0 ) {// Test for zero
-					// Compute square of v().  Input and output are in antilog form.
-					// You can get a further speedup here by using a table to do the
-					// squaring.  Use the element to address the table and read the
-					// square of the element from the table.
-					tmpForSq=logTbl[v[jx]]; // Fetch log
-					v[jx]=alogTbl[tmpForSq+tmpForSq]; // Add logs and fetch alog
-				}
-			}
-			// Initialize accumResidue to all zeros
-			for (jx=0;jx<=LnOrig-1;jx++) {
-				accumResidue[jx]=0;
-			}
-			for (kx2=0;kx2<=LnOrig-1;kx2++) {
-				if (2*kx2<LnOrig) {
-					accumResidue[2*kx2]=v[kx2];
-				}else{
-					if (v[kx2]>0  ) {// If this operand is "0" then block of code is skipped
-						// Must take log of RHS and use it for the two loops
-						tmpVk=logTbl[v[kx2]];
-						if (MDblShiftRowHasAZero[kx2]==1) {
-							// In this loop "need" to test for zero
-							for (kx3=0;kx3<=LnOrig-1;kx3++) {
-								if (MDblShift[kx2][kx3]!=LogZVal) {
-									accumResidue[kx3]=
-										(accumResidue[kx3]^alogTbl[tmpVk+MDblShift[kx2][kx3]]);
-								}
-							}
-						}else{
-							// In this loop do "not" need to test for zero
-							// WARNING - Cannot change # in next line
-							// without changing the number of lines of
-							// replication in the unrolled loop which
-							// follows the else
-							if (LnOrig>14){
-								for (kx3=0;kx3<=LnOrig-1;kx3++) {
-									accumResidue[kx3]^=alogTbl[tmpVk+MDblShift[kx2][kx3]];
-								}
-							}else{
-								switch (LnOrig-1)
-								{
-								case 13:accumResidue[13]^=alogTbl[tmpVk+MDblShift[kx2][13]];
-									//lint -fallthrough
-								case 12:accumResidue[12]^=alogTbl[tmpVk+MDblShift[kx2][12]];
-									//lint -fallthrough
-								case 11:accumResidue[11]^=alogTbl[tmpVk+MDblShift[kx2][11]];
-									//lint -fallthrough
-								case 10:accumResidue[10]^=alogTbl[tmpVk+MDblShift[kx2][10]];
-									//lint -fallthrough
-								case 9:accumResidue[9]^=alogTbl[tmpVk+MDblShift[kx2][9]];
-									//lint -fallthrough
-								case 8:accumResidue[8]^=alogTbl[tmpVk+MDblShift[kx2][8]];
-									//lint -fallthrough
-								case 7:accumResidue[7]^=alogTbl[tmpVk+MDblShift[kx2][7]];
-									//lint -fallthrough
-								case 6:accumResidue[6]^=alogTbl[tmpVk+MDblShift[kx2][6]];
-									//lint -fallthrough
-								case 5:accumResidue[5]^=alogTbl[tmpVk+MDblShift[kx2][5]];
-									//lint -fallthrough
-								case 4:accumResidue[4]^=alogTbl[tmpVk+MDblShift[kx2][4]];
-									//lint -fallthrough
-								case 3:accumResidue[3]^=alogTbl[tmpVk+MDblShift[kx2][3]];
-									//lint -fallthrough
-								case 2:accumResidue[2]^=alogTbl[tmpVk+MDblShift[kx2][2]];
-									//lint -fallthrough
-								case 1:accumResidue[1]^=alogTbl[tmpVk+MDblShift[kx2][1]];
-									//lint -fallthrough
-								case 0:accumResidue[0]^=alogTbl[tmpVk+MDblShift[kx2][0]];
-									//lint -fallthrough
-								default: break;
-								}
-							}
-						}
-					}
-				}
-			} // end kx2
-			// This loop does "v=accumResidue"
-			for (kx4=0;kx4<=LnOrig-1;kx4++) {
-				v[kx4]=accumResidue[kx4];
-			}
+		sum+=vec[vx].len;
+	}
+	return((sum==numBytes) ? 0 : IOVECLENERR);
+}
+
+static unsigned char *ioVecByte(const struct BchIoVec vec[],int numVecs,int byteAddr)
+{
+	//****************************************************************
+	//	Function: ioVecByte
+	//
+	//  Returns a pointer to byte byteAddr of the bytes in the segments
+	//  of vec taken in order, or 0 if there are not that many bytes.
+	//****************************************************************
+	int vx;
+
+	for (vx=0;vx<numVecs;vx++){
+		if (byteAddr<vec[vx].len){
+			return(vec[vx].base+byteAddr);
 		}
-	} // end of computing all residues
-	// Place very first TiModP vector in the table
-	// All other TiModP vectors will be computed in factor loop
-	for (kx=0;kx<=LnOrig-1;kx++) {
-		TiModP[0][kx]=workTiModP[kx];
+		byteAddr-=vec[vx].len;
 	}
-	// ========== ONCE PER CASE INITIALIZATION =========================
-	// Initialize some arrays
-	for (jx=0;jx<=LnOrig-1;jx++) {
-		alphaTbl[jx]=0;
-		degTbl[jx]=0;
+	return(0);
+}
+
+static int bchEncodeSg(const struct BchCodec *pCdc,const struct BchIoVec dataVec[],
+					   int numDataVecs,const struct BchIoVec parityVec[],int numParityVecs)
+{
+	//****************************************************************
+	//	Function: bchEncodeSg
+	//
+	//  This is the encoder.  It performs its function byte parallel using
+	//  an encode table that is built during initialization.  It processes
+	//  one byte at a time regardless of the size of the finite field.
+	//
+	//  The parallel approach shifts a software shift register implementing the
+	//  code generator polynomial once per codeword byte even though the binary
+	//  BCH code generator polynomial is over GF(2).  The shift occurs once per
+	//  byte regardless of the size of the finite field.  The value of the
+	//  codeword byte being processed addresses a large table to get the next
+	//  value of the software shift register.  See page 243 (k-bit serial techniques)
+	//  of "Practical Error Correction Design for Engineers" (revised second
+	//  edition 1991) by Neal Glover and Trent Dudley.  Page 347 of this book
+	//  describes tables for an early implementation of k-bit serial for
+	//  a binary code (a computer generated code).  The k-bit serial
+	//  method described there would be the same as for a binary
+	//  BCH code.  I learned early on that it was possible to implement
+	//  a parallel shift register for a binary code.  I may have learned this
+	//  from a paper by Hsiao and Sih titled "Serial-to-Parrallel Transformation
+	//  of Linear-Feedback Shift-Register Circuits" which appeared in
+	//  IEEE. Trans. on Elec. Comp., 738-740 (Dec. 1964).
+	//
+	//  The code is described by the codec structure, which is only read,
+	//  so several threads may encode with the same codec at once.
+	//
+	//  The numDataBytes data bytes are read from the numDataVecs
+	//  segments of dataVec (which are not written) and the numRedunBytes
+	//  redundancy bytes are scattered to the segments of parityVec.
+	//  The segments are owned by the caller, so for example a page with
+	//  the user data in its main area and the parity in its spare area
+	//  is encoded where it lies.  Returns IOVECLENERR, with nothing
+	//  written, if the segment lengths do not add up, else 0.
+	//****************************************************************
+	unsigned int SR[MAXREDUNWDS], tmp;
+	// +5 So that we can temporarily keep remainder bytes in whole words
+	int redunByteArray[(MAXCORR*MAXMPARM)/8+5];
+	int kx,vx,segAddr;
+	const int numRedunWords=pCdc->numRedunWords;
+	const int numRedunBytes=pCdc->numRedunBytes;
+	const int numDataBytes=pCdc->numDataBytes;
+
+	if ((ioVecLenErr(dataVec,numDataVecs,numDataBytes) |
+		ioVecLenErr(parityVec,numParityVecs,numRedunBytes))!=0){
+		return(IOVECLENERR);
 	}
-	// Initialize flags that tell if a TiModP has already been computed
-	// The first entryTiModP vector was computed as residues were computed
-	alphaFlgs[0]=1;
-	for (jx=1;jx<=mParm-1;jx++) {
-		alphaFlgs[jx]=0;
+	for (kx=0; kx < numRedunWords;kx++){ // Clear encode shift register
+		SR[kx] = 0;
 	}
-	degTbl[0]=LnOrig;
-	// Initialize factorTbl
-	factorTblCurrPosIdx=0; // Point to 1st entry of factor table
-	for (kx=0;kx<=LnOrig;kx++) {
-		// Initialize first row of factorTbl to input poly
-		factorTbl[0][kx]=p[kx];
+	shiftInDataVecs(pCdc,SR,dataVec,numDataVecs,numDataBytes);
+	// Copy redundancy bytes from shift register (SR) word array
+	for (kx=0;kx<numRedunWords;kx++){
+		tmp=SR[kx]; // Fetch a 32 bit word
+		redunByteArray[4*kx] = tmp>>24;
+		redunByteArray[4*kx+1] = (tmp>>16) & 0x000000ff;
+		redunByteArray[4*kx+2] = (tmp>>8) & 0x000000ff;
+		redunByteArray[4*kx+3] = tmp & 0x000000ff;
 	}
-	factorTblNxtEntryIdx=1; // Init
-	rootsFoundIdx=0;  // Init
-	// ========== BEGIN PROCESSING FACTORS =============================
-	while (factorTblCurrPosIdx<factorTblNxtEntryIdx) {
-		// ---------- Once per factor initialization ---------------------
-		// Get, from the table, a factor to split
-		for (kx=0;kx<=degTbl[factorTblCurrPosIdx];kx++) { // n+1 coeffs in degree n poly
-			currFactor[kx]=factorTbl[factorTblCurrPosIdx][kx];
+	// Scatter redundancy to the parity segments.  Don't copy pad bytes
+	// of SR word array
+	kx=0;
+	for (vx=0;vx<numParityVecs;vx++){
+		for (segAddr=0;segAddr<parityVec[vx].len;segAddr++){
+			parityVec[vx].base[segAddr]=(unsigned char)redunByteArray[kx++];
 		}
-		logALPHAi=alphaTbl[factorTblCurrPosIdx];
-		if (logALPHAi>=mParm) {
-			// This is an uncorrectable error - BREAK
-			return (LOGALPHAIGTHMPARM);
+	}
+	return(0);
+}
+
+static void bchEncodeSpan(const struct BchCodec *pCdc,const unsigned char data[],
+						  unsigned char parity[])
+{
+	//****************************************************************
+	//	Function: bchEncodeSpan
+	//
+	//  Encodes the numDataBytes bytes at data and writes the
+	//  numRedunBytes redundancy bytes to parity (see bchEncodeSg).  The
+	//  two spans are owned by the caller and need not be contiguous.
+	//****************************************************************
+	struct BchIoVec dataVec,parityVec;
+
+	dataVec.base=(unsigned char *)data; // Only read
+	dataVec.len=pCdc->numDataBytes;
+	parityVec.base=parity;
+	parityVec.len=pCdc->numRedunBytes;
+	(void)bchEncodeSg(pCdc,&dataVec,1,&parityVec,1);
+}
+
+static void bchEncode(const struct BchCodec *pCdc,unsigned char codeword[])
+{
+	//****************************************************************
+	//	Function: bchEncode
+	//
+	//  Encodes a codeword in byte format - numDataBytes data bytes
+	//  followed by the numRedunBytes redundancy bytes (see bchEncodeSpan).
+	//****************************************************************
+	bchEncodeSpan(pCdc,codeword,codeword+pCdc->numDataBytes);
+}
+
+static int bchUpdateParity(const struct BchCodec *pCdc,unsigned char parity[],
+						   const struct BchDelta ranges[],int numRanges)
+{
+	//****************************************************************
+	//	Function: bchUpdateParity
+	//
+	//  Updates the numRedunBytes parity bytes at parity for a partial
+	//  rewrite of the data, without the rest of the data.  Each range
+	//  gives the old XOR new value of some changed data bytes.  The code
+	//  is linear, so the new parity is the old parity XOR the parity of
+	//  the changes (with zeros everywhere else).
+	//
+	//  With deltaTbl built, a range no longer than the parity is done
+	//  bit by bit - each set bit of the changes XORs its row of deltaTbl
+	//  into the sum.  A longer range is shifted into a shift register
+	//  by shiftInDataBytesTbl, which leaves the parity the range would
+	//  have at the end of the data.  That is moved to where the range
+	//  is by XORing, for each set bit x^i of it, the row for x^(i+8z)
+	//  (z the # data bytes after the range).  Either way the work grows
+	//  with the size of the changes and not with numDataBytes.
+	//
+	//  Without deltaTbl the range is shifted in followed by a zero byte
+	//  for every data byte after it.
+	//
+	//  Returns DELTARANGEERR, with parity unchanged, if a range is not
+	//  inside the data, else 0.
+	//****************************************************************
+	static const unsigned char zeroBytes[64]={0};
+	unsigned int SR[MAXREDUNWDS],rangeSR[MAXREDUNWDS];
+	const unsigned int *row;
+	const unsigned char *delta;
+	int rx,kx,bx,jx,zeroCnt,stepBytes,ex;
+	unsigned int dVal,mask,acc,bitMasks[8];
+	const int numRedunWords=pCdc->numRedunWords;
+	const int numRedunBits=pCdc->numRedunBits;
+	const int numDataBytes=pCdc->numDataBytes;
+
+	for (rx=0;rx<numRanges;rx++){
+		if (ranges[rx].byteAddr<0 || ranges[rx].len<0 ||
+			ranges[rx].len>numDataBytes-ranges[rx].byteAddr){
+			return(DELTARANGEERR);
 		}
-		// ========== COMPUTE TiModP - JUST IN TIME, IF NEEDED ===============
-		// Note that we already computed the first entry of the TiModP table.  We
-		// did that as we were computing residues
-		if (alphaFlgs[logALPHAi]==0 ) {// If have not computed this TiModP yet
-			// Get TiModP by equiv of multiply vector times matrix
-			// Initialize array
-			for (kx0=0;kx0<=LnOrig-1;kx0++) {
-				workTiModP[kx0]=0;
+	}
+	for (jx=0;jx<numRedunWords;jx++){
+		SR[jx]=0;
+	}
+	for (rx=0;rx<numRanges;rx++){
+		delta=ranges[rx].delta;
+		zeroCnt=numDataBytes-ranges[rx].byteAddr-ranges[rx].len;
+		if (pCdc->deltaTblFlg!=0 && ranges[rx].len<=pCdc->numRedunBytes){
+			for (kx=0;kx<ranges[rx].len;kx++){
+				dVal=delta[kx];
+				if (dVal==0){
+					continue;
+				}
+				// Rows are masked, not branched around - the bits are random
+				row=&pCdc->deltaTbl[(ranges[rx].byteAddr+kx)*8*numRedunWords];
+				for (bx=0;bx<8;bx++){
+					bitMasks[bx]=0-((dVal >> (7-bx)) & 1);
+				}
+				for (jx=0;jx<numRedunWords;jx++){
+					acc=SR[jx];
+					for (bx=0;bx<8;bx++){
+						acc^=row[bx*numRedunWords+jx] & bitMasks[bx];
+					}
+					SR[jx]=acc;
+				}
 			}
-			// TiCoeff must be in log form
-			TiCoeff=logALPHAi;
-			twoToKx1Pwr=1;
-			for (kx1=0;kx1<=mParm-1;kx1++) {
-				if (twoToKx1Pwr<LnOrig) {
-					// Need to convert TiCoeff to alog form (will never be zero)
-					workTiModP[twoToKx1Pwr]=alogTbl[TiCoeff];
-				}else{
-					if (MResiduesRowHasAZero[kx1]==1) {
-						// In this loop "need" to test MResidues(,) for zero
-						// TiCoeff will never be zero - no need to test
-						for (kx2=0;kx2<=LnOrig-1;kx2++) {
-							// The symbol "TiModP" stands for (Trace(ALPHAi*z)) mod p
-							// TiCoeff and MResidues must be logs
-							// Add logs and fetch alog
-							if (MResidues[kx1][kx2]!=LogZVal) {
-								workTiModP[kx2]=
-									(workTiModP[kx2]^alogTbl[TiCoeff+MResidues[kx1][kx2]]);
-							}
-						}
-					}else{
-						// In this loop do "not" need to test MResidues(,) for zero
-						// TiCoeff will never be zero - no need to test
-						for (kx2=0;kx2<=LnOrig-1;kx2++) {
-							// The symbol "TiModP" stands for (Trace(ALPHAi*z)) mod p
-							// TiCoeff and MResidues must be logs
-							// Add logs and fetch alog
-							workTiModP[kx2]=
-								(workTiModP[kx2]^alogTbl[TiCoeff+MResidues[kx1][kx2]]);
-						}
+		}
+		else if (pCdc->deltaTblFlg!=0){
+			for (jx=0;jx<numRedunWords;jx++){
+				rangeSR[jx]=0;
+			}
+			shiftInDataBytesTbl(pCdc,rangeSR,delta,ranges[rx].len);
+			// Bit kx from the top of rangeSR is x^i, i=numRedunBits-1-kx.
+			// Times x^(8*zeroCnt) it is the bit numRedunBits-1-ex from the
+			// top of SR, or if ex is numRedunBits or more, it is the row of
+			// data bit numDataBits-1+numRedunBits-ex.
+			for (kx=0;kx<numRedunBits;kx++){
+				mask=0-((rangeSR[kx/32] >> (31-kx%32)) & 1);
+				ex=numRedunBits-1-kx+8*zeroCnt;
+				if (ex<numRedunBits){
+					SR[(numRedunBits-1-ex)/32]^=(0x80000000 >> ((numRedunBits-1-ex)%32)) & mask;
+				}
+				else {
+					row=&pCdc->deltaTbl[(pCdc->numDataBits-1+numRedunBits-ex)*numRedunWords];
+					for (jx=0;jx<numRedunWords;jx++){
+						SR[jx]^=row[jx] & mask;
 					}
 				}
-				for (kx2=0;kx2<=LnOrig-1;kx2++) {
-					TiModP[logALPHAi][kx2]=workTiModP[kx2];
+			}
+		}
+		else {
+			for (jx=0;jx<numRedunWords;jx++){
+				rangeSR[jx]=0;
+			}
+			shiftInDataBytesTbl(pCdc,rangeSR,delta,ranges[rx].len);
+			for (;zeroCnt>0;zeroCnt-=stepBytes){
+				stepBytes=(zeroCnt<64) ? zeroCnt : 64;
+				shiftInDataBytesTbl(pCdc,rangeSR,zeroBytes,stepBytes);
+			}
+			for (jx=0;jx<numRedunWords;jx++){
+				SR[jx]^=rangeSR[jx];
+			}
+		}
+	}
+	// Shift register words to parity bytes, high order first
+	for (kx=0;kx<pCdc->numRedunBytes;kx++){
+		parity[kx]^=(unsigned char)(SR[kx/4] >> (24-8*(kx%4)));
+	}
+	return(0);
+}
+
+#if BCHX86SIMD
+TARGETAVX2 static void bchEncodeLanesAvx2(const struct BchCodec *pCdc,unsigned char *codewords[])
+{
+	//****************************************************************
+	//	Function: bchEncodeLanesAvx2
+	//
+	//  Encodes 8 codewords in lockstep.  This is shiftInDataBytesTbl
+	//  with the shift register word jx of codeword kx held in lane kx
+	//  of SRv[jx].  With slicing tables (encodeSliceBytes 4 or 8) each
+	//  step takes 4 or 8 data bytes of every lane - the feedback words
+	//  are the high order SR words XOR the data, SR moves up by whole
+	//  words and each feedback byte gathers its row of the table for
+	//  its distance from the end of the slice.  The bytes left over
+	//  are shifted in one at a time with the encode table.  The 8
+	//  shift registers are independent so the loop-carried dependency
+	//  of one codeword is spread over 8.
+	//****************************************************************
+	__m256i SRv[MAXREDUNWDS],fdbkv[MAXSLICEBYTES/4],dataVec,tblIdx;
+	unsigned int lanes[8],tmp;
+	const unsigned char *data;
+	const int *sliceTbls[MAXSLICEBYTES];
+	int jx,kx,lx,writeCWAddr,redunAddr,wordShift;
+	const int numRedunWords=pCdc->numRedunWords;
+	const int numRedunBytes=pCdc->numRedunBytes;
+	const int numDataBytes=pCdc->numDataBytes;
+	const int sliceBytes=pCdc->encodeSliceBytes;
+	const int *encodeTbl=(const int *)pCdc->encodeTbl;
+	const __m256i tblStride=_mm256_set1_epi32(numRedunWords);
+	const __m256i byteMask=_mm256_set1_epi32(0xff);
+
+	for (jx=0; jx < numRedunWords;jx++){ // Clear encode shift registers
+		SRv[jx]=_mm256_setzero_si256();
+	}
+	writeCWAddr=0;
+	if (sliceBytes>1){
+		wordShift=sliceBytes/4;
+		for (kx=0;kx<sliceBytes-1;kx++){
+			sliceTbls[kx]=(const int *)&pCdc->sliceTbl[(sliceBytes-2-kx)*BYTESTATES*numRedunWords];
+		}
+		sliceTbls[sliceBytes-1]=encodeTbl;
+		for (; writeCWAddr+sliceBytes <= numDataBytes; writeCWAddr+=sliceBytes) {
+			// Feedback words - high order SR words XOR data words
+			for (kx=0;kx<wordShift;kx++){
+				for (lx=0;lx<8;lx++){
+					data=codewords[lx]+writeCWAddr+4*kx;
+					lanes[lx]=((unsigned int)data[0]<<24) ^ ((unsigned int)data[1]<<16) ^
+						((unsigned int)data[2]<<8) ^ (unsigned int)data[3];
 				}
-				// This code adds logs modulo (ffSize-1)
-				TiCoeff=TiCoeff+TiCoeff; // Add logs to square
-				if (TiCoeff>=(ffSize-1)) {
-					TiCoeff=TiCoeff-(ffSize-1);
+				fdbkv[kx]=_mm256_loadu_si256((const __m256i *)lanes);
+				if (kx<numRedunWords){
+					fdbkv[kx]=_mm256_xor_si256(fdbkv[kx],SRv[kx]);
 				}
-				twoToKx1Pwr=2*twoToKx1Pwr;
-			} // end for kx1
-			alphaFlgs[logALPHAi]=1;
+			}
+			for (jx=0; jx < numRedunWords;jx++){ // Shift SR by the whole slice
+				SRv[jx]=(jx+wordShift < numRedunWords) ? SRv[jx+wordShift] : _mm256_setzero_si256();
+			}
+			for (kx=0;kx<sliceBytes;kx++){
+				switch (kx%4){
+				case 0:
+					tblIdx=_mm256_srli_epi32(fdbkv[kx/4],24);
+					break;
+				case 1:
+					tblIdx=_mm256_and_si256(_mm256_srli_epi32(fdbkv[kx/4],16),byteMask);
+					break;
+				case 2:
+					tblIdx=_mm256_and_si256(_mm256_srli_epi32(fdbkv[kx/4],8),byteMask);
+					break;
+				default:
+					tblIdx=_mm256_and_si256(fdbkv[kx/4],byteMask);
+					break;
+				}
+				tblIdx=_mm256_mullo_epi32(tblIdx,tblStride);
+				for (jx=0; jx < numRedunWords;jx++){
+					SRv[jx]=_mm256_xor_si256(SRv[jx],
+						_mm256_i32gather_epi32(sliceTbls[kx]+jx,tblIdx,4));
+				}
+			}
+		}
+	}
+	for (; writeCWAddr < numDataBytes; writeCWAddr++) {
+		dataVec=_mm256_set_epi32(codewords[7][writeCWAddr],codewords[6][writeCWAddr],
+			codewords[5][writeCWAddr],codewords[4][writeCWAddr],
+			codewords[3][writeCWAddr],codewords[2][writeCWAddr],
+			codewords[1][writeCWAddr],codewords[0][writeCWAddr]);
+		// Feedback byte of each lane addresses the encode table
+		tblIdx=_mm256_mullo_epi32(_mm256_xor_si256(_mm256_srli_epi32(SRv[0],24),
+			dataVec),tblStride);
+		for (jx=0; jx < numRedunWords-1;jx++){
+			SRv[jx]=_mm256_or_si256(_mm256_slli_epi32(SRv[jx],8),
+				_mm256_srli_epi32(SRv[jx+1],24));
+			SRv[jx]=_mm256_xor_si256(SRv[jx],
+				_mm256_i32gather_epi32(encodeTbl+jx,tblIdx,4));
+		}
+		SRv[jx]=_mm256_xor_si256(_mm256_slli_epi32(SRv[jx],8),
+			_mm256_i32gather_epi32(encodeTbl+jx,tblIdx,4));
+	}
+	// Copy redundancy bytes from the shift registers to the codewords
+	for (jx=0;jx<numRedunWords;jx++){
+		_mm256_storeu_si256((__m256i *)lanes,SRv[jx]);
+		for (kx=0;kx<8;kx++){
+			tmp=lanes[kx];
+			for (redunAddr=4*jx;redunAddr<4*jx+4 && redunAddr<numRedunBytes;redunAddr++){
+				codewords[kx][numDataBytes+redunAddr]=(unsigned char)(tmp>>24);
+				tmp<<=8;
+			}
+		}
+	}
+}
+
+TARGETAVX512 static void bchEncodeLanesAvx512(const struct BchCodec *pCdc,unsigned char *codewords[])
+{
+	//****************************************************************
+	//	Function: bchEncodeLanesAvx512
+	//
+	//  Encodes 16 codewords in lockstep.  Same as bchEncodeLanesAvx2
+	//  but with 16 lanes.
+	//****************************************************************
+	__m512i SRv[MAXREDUNWDS],fdbkv[MAXSLICEBYTES/4],dataVec,tblIdx;
+	unsigned int lanes[16],tmp;
+	const unsigned char *data;
+	const int *sliceTbls[MAXSLICEBYTES];
+	int jx,kx,lx,writeCWAddr,redunAddr,wordShift;
+	const int numRedunWords=pCdc->numRedunWords;
+	const int numRedunBytes=pCdc->numRedunBytes;
+	const int numDataBytes=pCdc->numDataBytes;
+	const int sliceBytes=pCdc->encodeSliceBytes;
+	const int *encodeTbl=(const int *)pCdc->encodeTbl;
+	const __m512i tblStride=_mm512_set1_epi32(numRedunWords);
+	const __m512i byteMask=_mm512_set1_epi32(0xff);
+
+	for (jx=0; jx < numRedunWords;jx++){ // Clear encode shift registers
+		SRv[jx]=_mm512_setzero_si512();
+	}
+	writeCWAddr=0;
+	if (sliceBytes>1){
+		wordShift=sliceBytes/4;
+		for (kx=0;kx<sliceBytes-1;kx++){
+			sliceTbls[kx]=(const int *)&pCdc->sliceTbl[(sliceBytes-2-kx)*BYTESTATES*numRedunWords];
+		}
+		sliceTbls[sliceBytes-1]=encodeTbl;
+		for (; writeCWAddr+sliceBytes <= numDataBytes; writeCWAddr+=sliceBytes) {
+			// Feedback words - high order SR words XOR data words
+			for (kx=0;kx<wordShift;kx++){
+				for (lx=0;lx<16;lx++){
+					data=codewords[lx]+writeCWAddr+4*kx;
+					lanes[lx]=((unsigned int)data[0]<<24) ^ ((unsigned int)data[1]<<16) ^
+						((unsigned int)data[2]<<8) ^ (unsigned int)data[3];
+				}
+				fdbkv[kx]=_mm512_loadu_si512((const void *)lanes);
+				if (kx<numRedunWords){
+					fdbkv[kx]=_mm512_xor_si512(fdbkv[kx],SRv[kx]);
+				}
+			}
+			for (jx=0; jx < numRedunWords;jx++){ // Shift SR by the whole slice
+				SRv[jx]=(jx+wordShift < numRedunWords) ? SRv[jx+wordShift] : _mm512_setzero_si512();
+			}
+			for (kx=0;kx<sliceBytes;kx++){
+				switch (kx%4){
+				case 0:
+					tblIdx=_mm512_srli_epi32(fdbkv[kx/4],24);
+					break;
+				case 1:
+					tblIdx=_mm512_and_si512(_mm512_srli_epi32(fdbkv[kx/4],16),byteMask);
+					break;
+				case 2:
+					tblIdx=_mm512_and_si512(_mm512_srli_epi32(fdbkv[kx/4],8),byteMask);
+					break;
+				default:
+					tblIdx=_mm512_and_si512(fdbkv[kx/4],byteMask);
+					break;
+				}
+				tblIdx=_mm512_mullo_epi32(tblIdx,tblStride);
+				for (jx=0; jx < numRedunWords;jx++){
+					SRv[jx]=_mm512_xor_si512(SRv[jx],
+						_mm512_i32gather_epi32(tblIdx,sliceTbls[kx]+jx,4));
+				}
+			}
+		}
+	}
+	for (; writeCWAddr < numDataBytes; writeCWAddr++) {
+		dataVec=_mm512_set_epi32(codewords[15][writeCWAddr],codewords[14][writeCWAddr],
+			codewords[13][writeCWAddr],codewords[12][writeCWAddr],
+			codewords[11][writeCWAddr],codewords[10][writeCWAddr],
+			codewords[9][writeCWAddr],codewords[8][writeCWAddr],
+			codewords[7][writeCWAddr],codewords[6][writeCWAddr],
+			codewords[5][writeCWAddr],codewords[4][writeCWAddr],
+			codewords[3][writeCWAddr],codewords[2][writeCWAddr],
+			codewords[1][writeCWAddr],codewords[0][writeCWAddr]);
+		// Feedback byte of each lane addresses the encode table
+		tblIdx=_mm512_mullo_epi32(_mm512_xor_si512(_mm512_srli_epi32(SRv[0],24),
+			dataVec),tblStride);
+		for (jx=0; jx < numRedunWords-1;jx++){
+			SRv[jx]=_mm512_or_si512(_mm512_slli_epi32(SRv[jx],8),
+				_mm512_srli_epi32(SRv[jx+1],24));
+			SRv[jx]=_mm512_xor_si512(SRv[jx],
+				_mm512_i32gather_epi32(tblIdx,encodeTbl+jx,4));
+		}
+		SRv[jx]=_mm512_xor_si512(_mm512_slli_epi32(SRv[jx],8),
+			_mm512_i32gather_epi32(tblIdx,encodeTbl+jx,4));
+	}
+	// Copy redundancy bytes from the shift registers to the codewords
+	for (jx=0;jx<numRedunWords;jx++){
+		_mm512_storeu_si512((void *)lanes,SRv[jx]);
+		for (kx=0;kx<16;kx++){
+			tmp=lanes[kx];
+			for (redunAddr=4*jx;redunAddr<4*jx+4 && redunAddr<numRedunBytes;redunAddr++){
+				codewords[kx][numDataBytes+redunAddr]=(unsigned char)(tmp>>24);
+				tmp<<=8;
+			}
+		}
+	}
+}
+#endif
+
+static void bchEncodeBatch(const struct BchCodec *pCdc,unsigned char *codewords[],int numCWs)
+{
+	//****************************************************************
+	//	Function: bchEncodeBatch
+	//
+	//  Encodes numCWs independent codewords.  codewords[kx] points to
+	//  a codeword in the same format as for bchEncode.  Groups of
+	//  codewords are encoded in lockstep in SIMD lanes (see encodeLanes
+	//  in the codec) and any left over are encoded one at a time.  The
+	//  result is the same as calling bchEncode for each codeword.
+	//****************************************************************
+	int kx;
+
+	kx=0;
+#if BCHX86SIMD
+	if (pCdc->encodeLanes==16){
+		for (;kx+16<=numCWs;kx+=16){
+			bchEncodeLanesAvx512(pCdc,&codewords[kx]);
+		}
+	}
+	if (pCdc->encodeLanes>=8){
+		for (;kx+8<=numCWs;kx+=8){
+			bchEncodeLanesAvx2(pCdc,&codewords[kx]);
+		}
+	}
+#endif
+	for (;kx<numCWs;kx++){
+		bchEncode(pCdc,codewords[kx]);
+	}
+}
+
+static void savCodeword()
+{
+	//****************************************************************
+	//	Function: savCodeword
+	//
+	//	Function to save the original codeword resulting from encoding,
+	//  so that it can be compared later with the corrected codeword.
+	//****************************************************************
+	int kx;
+
+	for (kx=0;kx<gblCodec.numCodewordBytes;kx++){
+		gblCodewordSav[kx]=gblCodeword[kx];
+	}
+}
+
+static int chkUpdateParity()
+{
+	//****************************************************************
+	//	Function: chkUpdateParity
+	//
+	//	Function to rewrite a random range of the data in gblCodeword,
+	//  update the parity for it with bchUpdateParity and check the
+	//  parity against bchEncode of the new data.  gblCodeword is left
+	//  holding the new codeword.  Returns 1 if the parity differs, 0
+	//  if it matches or if the code has no data bytes to rewrite.
+	//****************************************************************
+	static unsigned char delta[MAXCODEWDBYTES],encodedCW[MAXCODEWDBYTES];
+	struct BchDelta range;
+	int kx;
+
+	if (gblCodec.numDataBytes==0){
+		return(0);
+	}
+	range.byteAddr=rand()%gblCodec.numDataBytes;
+	range.len=rand()%(gblCodec.numDataBytes-range.byteAddr)+1;
+	range.delta=delta;
+	for (kx=0;kx<range.len;kx++){
+		delta[kx]=(unsigned char)(rand()%BYTESTATES);
+		gblCodeword[range.byteAddr+kx]^=delta[kx];
+	}
+	if (bchUpdateParity(&gblCodec,&gblCodeword[gblCodec.numDataBytes],&range,1)!=0){
+		return(1);
+	}
+	for (kx=0;kx<gblCodec.numCodewordBytes;kx++){
+		encodedCW[kx]=gblCodeword[kx];
+	}
+	bchEncode(&gblCodec,encodedCW);
+	for (kx=gblCodec.numDataBytes;kx<gblCodec.numCodewordBytes;kx++){
+		if (encodedCW[kx]!=gblCodeword[kx]){
+			return(1);
+		}
+	}
+	return(0);
+}
+
+static int applyErrors(int lowNumErrs,int hiNumErrs)
+{
+	//****************************************************************
+	//	Function: applyErrors
+	//
+	//	Function to apply errors to the codeword before decoding.  The
+	//  minimum and maximum number of errors to apply are established
+	//  by input from the user.  Errors are being put in a codeword of
+	//  bytes regardless of finite field size.
+	//****************************************************************
+	int jx,kx,bitLoc,byteLoc,byteValue;
+	int byteBitNum,uniqueFlg;
+
+	gblNumErrsApplied = ((int)getRandom()%((hiNumErrs-lowNumErrs)+1))+lowNumErrs;
+	for (kx=0;kx<gblNumErrsApplied;kx++){
+		// Highest bit err Loc will be numDataBits+numRedunBits-1,
+		// which is the last gblCodeword bit location.  NOTE: Last
+		// gblCodeword bit not necessarialy on a byte boundary.  But
+		// this code works on bytes so there are possibly zero fill
+		// bits in the last gblCodeword byte.  If we put errs in the
+		// fill positions they could appear to be in the front
+		// part of the gblCodeword and miscorrection could result.
+		do {
+			// Working with bits because of pad bits
+			bitLoc = (int)getRandom()%(gblCodec.numDataBits+gblCodec.numRedunBits);
+			uniqueFlg=1;
+			for (jx=0;jx<kx;jx++){ // If kx==0 this loop will not do anything
+				if (bitLoc==gblRawLoc[jx]){
+					uniqueFlg=0;
+					break;
+				}
+			}
+		}while ( uniqueFlg ==0);
+		gblRawLoc[kx]=bitLoc;
+		byteLoc = bitLoc/8;
+		byteBitNum = 7 - (bitLoc % 8);
+		byteValue=1;
+		for (jx=byteBitNum;jx>=1;jx--){
+			byteValue *= 2;
+		}
+		gblCodeword[byteLoc] ^= byteValue;
+		gblAppliedErrLocs[kx]=byteLoc;
+		gblAppliedErrVals[kx]=byteValue;
+	}
+	return (gblNumErrsApplied);
+}
+
+static int computeRemainder(const struct BchCodec *pCdc,const struct BchIoVec dataVec[],
+							int numDataVecs,const struct BchIoVec parityVec[],
+							int numParityVecs,int remainBytes[])
+{
+	//****************************************************************
+	//	Function: computeRemainder
+	//
+	//  This function computes a remainder.  This remainder is the remainder
+	//  from dividing the received codeword by the full code generator polynomial
+	//  (not by factors of it).  This is the key to speeding up syndrome computation.
+	//  This remainder is computed using a parallel approach similar to that used
+	//  in encoding.  Once we have a full remainder we can compute syndromes from it.
+	//  This is faster than computing syndromes directly from the codeword because
+	//  the remainder is much shorter than the codeword.  The data bytes are
+	//  shifted in by shiftInDataVecs, 4 or 8 bytes per step if slicing
+	//  tables were built.  The data and redundancy bytes are read from
+	//  the segments of dataVec and parityVec.
+	//
+	//  This also gives us a fast way to determine if the syndromes would all be zero.
+	//  If the remainder is all zeros then there is no need to compute syndromes from
+	//  it as they would all be zeros also.  If the remainder is zero then the
+	//  codeword is assumed to be error free and no further decoding steps are
+	//  necessary.
+	//
+	//  The parallel approach shifts a software shift register implementing the
+	//  code generator polynomial once per codeword byte even though the binary
+	//  BCH code generator polynomial is over GF(2).  The shift occurs once per
+	//  byte regardless of the size of the finite field.  The value of the
+	//  codeword byte being processed addresses a large table to get the next
+	//  value of the software shift register.  See page 243 (k-bit serial techniques)
+	//  of "Practical Error Correction Design for Engineers" (revised second
+	//  edition 1991) by Neal Glover and Trent Dudley.  Page 347 of this book
+	//  describes tables for an early implementation of k-bit serial for
+	//  a binary code (a computer generated code).  The k-bit serial
+	//  method described there would be the same as for a binary
+	//  BCH code.  I learned early on that it was possible to implement
+	//  a parallel shift register for a binary code.  I may have learned this
+	//  from a paper by Hsiao and Sih titled "Serial-to-Parrallel Transformation
+	//  of Linear-Feedback Shift-Register Circuits" which appeared in
+	//  IEEE. Trans. on Elec. Comp., 738-740 (Dec. 1964).
+	//****************************************************************
+	unsigned int fdbk,fdbkSav,SR[MAXREDUNWDS];
+	int nnn,readParityAddr,remainderDetdErr,vx,segAddr;
+	const int numRedunWords=pCdc->numRedunWords;
+	const int numRedunBytes=pCdc->numRedunBytes;
+	const int numDataBytes=pCdc->numDataBytes;
+
+	for (nnn=0; nnn < numRedunWords;nnn++){ // Clear encode shift register
+		SR[nnn] = 0;
+	}
+	// SHIFTS WITH FEEDBACK
+	shiftInDataVecs(pCdc,SR,dataVec,numDataVecs,numDataBytes);
+	// SHIFTS WITHOUT FEEDBACK
+	// Line below - This flag will be set later if the remainder is non zero.
+	// Non-zero means either corr or uncorr err.  We will know which after decoding.
+	remainderDetdErr=0;
+	// index to parity segments
+	vx=0;
+	segAddr=0;
+	for (readParityAddr = 0; readParityAddr < numRedunBytes; readParityAddr++) {
+		while (segAddr>=parityVec[vx].len && vx<numParityVecs-1){
+			vx++;
+			segAddr=0;
+		}
+		fdbk = 0;
+		for (nnn=numRedunWords-1; nnn >=0 ;nnn--){
+			fdbkSav = fdbk;
+			fdbk = (SR[nnn] >> 24); // 32 - # bits in parallel (unrelated to "m")
+			SR[nnn] = (SR[nnn] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
+		}
+		fdbk ^= (unsigned int)parityVec[vx].base[segAddr++];
+		remainBytes[readParityAddr]=(int)fdbk;
+		if (fdbk!=0){
+			remainderDetdErr = 1;
+		}
+	}
+	return(remainderDetdErr);
+}
+
+static void computeSyndromes(int syndromes[],int numRedunBytes,const int remainBytes[],
+							 const FfElem alogTbl[],const FfLog logTbl[],int nParm,int tParm)
+{
+	//****************************************************************
+	//	Function: computeSyndromes
+	//
+	//  9-10-10 Made few changes for speed
+	//
+	//  Function to compute syndromes.  Syndromes are computed from a
+	//  remainder not from the codeword.  See the comments
+	//  for the ComputeRemainder function.
+	//
+	//  Note that even syndromes are computed from odd syndromes.
+	//  I have know that this is possible for a binary
+	//  BCH code for about 30 years.  I think that I learned
+	//  that this is possible from one of the early ECC books.
+	//  Possibly from an early book by Peterson, Berlekamp, or
+	//  Shu Lin.  I just found an early reference to this on
+	//  page 192 of "Algebraic Coding Theory" by Dr. Elwyn
+	//  Berlekamp.
+	//
+	//  An early reference for computing syndromes from
+	//  a remainder is page 160 of the Glover-Dudley 1991 book
+	//  "Practical Error Correction Design for Engineers"
+	//  REVISED SECOND EDITION.
+	//****************************************************************
+	int mask, data, evenSNum;
+	int jjj,iii,kkk,x,numSyndromes,accumVal,bumpVal;
+
+	// In a real implementation of one fixed code, numSyndromes would be a constant
+	numSyndromes=2*tParm;
+	// Clear syndromes
+	for (kkk=0;kkk<numSyndromes;kkk++){
+		syndromes[kkk] = 0;
+	}
+	for (iii=0;iii < numRedunBytes;iii++){
+		mask=0x01;
+		for (jjj=0;jjj<8;jjj++){
+			data = remainBytes[iii] & mask;
+			if (data>0){
+				// 9-10-10 Changed for speed
+				accumVal=(((numRedunBytes-1)-iii)*8+jjj); // Initialize
+				bumpVal=2*accumVal; // Initialize
+				// Note increment by 2
+				for (kkk=0;kkk<numSyndromes;kkk+=2){
+					//  "+1" is for syndrome offset
+					//	CAN UNROLL THIS LOOP FOR A LITTLE MORE SPEED
+					//  A SWITCH STATEMENT WILL BE REQUIRED.
+					//  CAN GET RID OF MOD (FOR SPEED) BY CARRYING A SUM THAT STARTS
+					//  OUT AS THE MAXIMUM VALUE OF ((kkk+1)*preComputeVal) AND
+					//  SUBTRACTING PRECOMPUTEVAL EACH TIME AND IF VALUE GOES
+					//  NEGATIVE ADD IN NPARM.  THE MAX VALUE ABOVE WILL VARY
+					//  BASED ON NUMBER OF REDUN BYTES FOR SELECTED PARMS
+					//  9-10-10 Changed next few lines for speed
+					syndromes[kkk] ^= alogTbl[accumVal];
+					accumVal+=bumpVal; // Add 2*preComputeVal
+					if (accumVal>=nParm){
+						accumVal-=nParm;
+						if (accumVal>=nParm){
+							accumVal-=nParm;
+						}
+					}
+				}
+			}
+			mask *=2;
+		}
+	}
+	// Compute even Syndromes from the odd Syndromes
+	for (kkk=0;kkk<numSyndromes;kkk+=2){
+		x=syndromes[kkk];
+		evenSNum=(2*(kkk+1));
+		while (evenSNum<=2*tParm){
+			// Square "x"
+			if (x>0){
+				x=alogTbl[2*logTbl[x]];
+			}
+			syndromes[evenSNum-1]=x;
+			evenSNum*=2;
+		}
+	}
+}
+
+static void computeSyndromesTbl(const struct BchCodec *pCdc,int syndromes[],
+								const int remainBytes[])
+{
+	//****************************************************************
+	//	Function: computeSyndromesTbl
+	//
+	//  Table driven version of computeSyndromes.  The odd syndromes are
+	//  the XOR, over the non-zero remainder bytes, of the syndrome
+	//  table entry for the byte position and value (see
+	//  genSyndromeTbls).  That is t XORs per remainder byte rather
+	//  than up to 8*t.  Even syndromes are computed from the odd
+	//  syndromes as in computeSyndromes.
+	//****************************************************************
+	unsigned short oddSyndromes[MAXCORR];
+	const unsigned short *tblEntry;
+	int iii,kkk,x,evenSNum;
+	const int numRedunBytes=pCdc->numRedunBytes;
+	const int tParm=pCdc->tParm;
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+
+	for (kkk=0;kkk<tParm;kkk++){
+		oddSyndromes[kkk]=0;
+	}
+	for (iii=0;iii < numRedunBytes;iii++){
+		if (remainBytes[iii]!=0){
+			tblEntry=&pCdc->synTbl[(iii*BYTESTATES+remainBytes[iii])*tParm];
+			for (kkk=0;kkk<tParm;kkk++){
+				oddSyndromes[kkk]^=tblEntry[kkk];
+			}
+		}
+	}
+	for (kkk=0;kkk<tParm;kkk++){
+		syndromes[2*kkk]=oddSyndromes[kkk];
+	}
+	// Compute even Syndromes from the odd Syndromes
+	for (kkk=0;kkk<2*tParm;kkk+=2){
+		x=syndromes[kkk];
+		evenSNum=(2*(kkk+1));
+		while (evenSNum<=2*tParm){
+			// Square "x"
+			if (x>0){
+				x=alogTbl[2*logTbl[x]];
+			}
+			syndromes[evenSNum-1]=x;
+			evenSNum*=2;
+		}
+	}
+}
+
+template<class Cdc>
+static int berMas(const Cdc *pCdc,int sigmaN[],const int syndromes[],
+				  int *pErrFlg)
+//***************************************************************
+//	Function: BerMas
+//
+//  10-3-08 One line was changed and one line was added to change the
+//  the code over from supporting a Reed-Solomon code to supporting a
+//  binary BCH code.
+//
+//	This function computes the coefficient's of the ELP using the Berlekamp-
+//	Massey algorithm. The reference for this algorithm is
+//	"Shift-Register Synthesis and BCH Decoding", IEEE Transactions
+//	on Information Theory, IT-15, 122-127, 1969.  This paper can also be
+//  found in Blake's 1973 book, "Algebraic Coding Theory"
+//  (a collection of papers).  When I wrote the 1999 version of this
+//  function, I evaluated several variations of the Berlekamp-Massey
+//  algorithm. The variations vary mostly in the initialization of "nn"
+//  (0 or 1) and in the algebra used for the decisions.
+//
+//	I wrote this code originally in 1999 for a Reed-Solomon code.
+//  I added the error evaluator polynomial at that time.  My reference
+//  for adding the error evaluator polynomial was the thesis
+//  by Doug Whiting.  I removed the error evaluator polynomial 10-3-08
+//  for a binary BCH, since we do not compute error values for a binary
+//  BCH code.  Variable names used here are related to the variable names
+//  used in the original Massey article as shown below.
+//
+//   This Code   Massey Paper
+//   ---------   ------------
+//	 sigmaTmp    T(D)  D of T(D) is from signal processing and is equiv to using T(x)
+//   SigmaN      C(D)
+//   sigmaK      B(D)
+//   n           N
+//   nminusk     x
+//   dk          b
+//   dn          d
+//   Ln          L
+//
+//  For implementations where the time spent in this function is a
+//  dominating factor in performance, a technique due to C.L. Chen can
+//  be used for a speed up. If you are interested see "High-Speed
+//  Decoding of BCH Codes" by C.L. Chen - IEEE Info Theory VOL. IT-27,
+//  NO. 2, March 1981.  Before implementing this technique you need
+//  to understand its impact on your miscorrection rate.
+//***************************************************************
+{
+	int logTmpQ,sigmaK[MAXCORR+1];
+	int sigmaTmp[MAXCORR+1];
+	int dn,dk,Ln;
+	int nn,j,lk,nminusk;
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int nParm=pCdc->nParm;
+	const int tParm=pCdc->tParm;
+
+	sigmaN[0]=1;sigmaK[0]=1;
+	for (nn=1;nn<=tParm;nn++){
+		sigmaN[nn]=0;
+		sigmaK[nn]=0;
+	}
+	nminusk=1;dk=1;lk=0;Ln=0;
+	// Next cmd line - 2*tParm is number of syndromes
+	// Next cmd line - *****incr was changed from 1 (RS) to 2 (bin BCH)*****
+	for (nn=0;nn<2*tParm;nn+=2){
+		dn=0;
+		for (j=0;j<=Ln;j++){
+			dn^=ffMult(pCdc,sigmaN[j],syndromes[nn-j]);
+		}
+		if (dn==0){
+			nminusk++;
+		}
+		else {
+			if (2*Ln>nn){
+				if (nn-Ln>(tParm-1)){
+					*pErrFlg|=BERMASERR;
+					break;
+				}
+				// Next 2 "if" blks chgd to not use ffMult and ffDiv funs 9-9-2010
+				if (dk==0){
+					return (DIVZRODIV); // Divide by zero error
+				}
+				if (dn>0){
+					logTmpQ=logTbl[dn]-logTbl[dk];
+					if (logTmpQ<0){
+						logTmpQ+=nParm;
+					}
+					for (j=0;j<=lk;j++) {
+						if (sigmaK[j]>0){
+							sigmaN[nminusk+j]^=alogTbl[logTbl[sigmaK[j]]+logTmpQ];
+						}
+					}
+				}
+				nminusk++;
+			}
+			else {
+				if (nn-Ln>(tParm-1)) {
+					*pErrFlg|=BERMASERR;break;
+				}
+				for (j=0;j<=Ln;j++){
+					sigmaTmp[j]=sigmaN[j];
+				}
+				// Next 2 "if" blks chgd to not use ffMult and ffDiv funs 9-9-2010
+				if (dk==0){
+					return (DIVZRODIV); // Divide by zero error
+				}
+				if (dn>0){
+					logTmpQ=logTbl[dn]-logTbl[dk];
+					if (logTmpQ<0){
+						logTmpQ+=nParm;
+					}
+					for (j=0;j<=lk;j++) {
+						if (sigmaK[j]>0){
+							sigmaN[nminusk+j]^=alogTbl[logTbl[sigmaK[j]]+logTmpQ];
+						}					}
+				}
+				for (j=0;j<=Ln;j++){
+					sigmaK[j]=sigmaTmp[j];
+				}
+				lk=Ln;
+				Ln=nn+1-Ln;
+				dk=dn;
+				nminusk=1;
+			}
+		}
+		nminusk++;// *****This line added for binary BCH*****
+	} // end for
+	if (sigmaN[Ln]==0){
+		*pErrFlg|=BERMASERR;
+	}
+	return (Ln);
+}
+
+#if BCHX86SIMD
+TARGETAVX2 static inline void riBMConstTbls(const struct BchCodec *pCdc,int c,__m128i tbl[4][2])
+{
+	//****************************************************************
+	//	Function: riBMConstTbls
+	//
+	//  Builds the split nibble (PSHUFB) tables that multiply by the
+	//  constant c - byte n of tbl[q][h] is byte h of c*(n<<4q).  The
+	//  products of c with x^0..x^15 are 16 consecutive alogTbl entries
+	//  (x^k is alpha^k for k<m, higher bits never occur).  The 16
+	//  entries of a table are the XOR of those products, masked by the
+	//  bits of n, computed 16 at a time.
+	//****************************************************************
+	int basis[16],kx,qx,logC,zeroMask;
+	__m256i nIdx,bitMask[4],prod,byteMask;
+
+	logC=(c==0) ? 0 : pCdc->logTbl[c];
+	zeroMask=-(c!=0);
+	for (kx=0;kx<16;kx++){
+		basis[kx]=pCdc->alogTbl[logC+kx] & zeroMask;
+	}
+	nIdx=_mm256_setr_epi16(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15);
+	for (kx=0;kx<4;kx++){
+		bitMask[kx]=_mm256_cmpeq_epi16(_mm256_and_si256(nIdx,_mm256_set1_epi16((short)(1<<kx))),
+			_mm256_set1_epi16((short)(1<<kx)));
+	}
+	byteMask=_mm256_set1_epi16(0xff);
+	for (qx=0;qx<4;qx++){
+		prod=_mm256_and_si256(bitMask[0],_mm256_set1_epi16((short)basis[4*qx]));
+		prod=_mm256_xor_si256(prod,_mm256_and_si256(bitMask[1],_mm256_set1_epi16((short)basis[4*qx+1])));
+		prod=_mm256_xor_si256(prod,_mm256_and_si256(bitMask[2],_mm256_set1_epi16((short)basis[4*qx+2])));
+		prod=_mm256_xor_si256(prod,_mm256_and_si256(bitMask[3],_mm256_set1_epi16((short)basis[4*qx+3])));
+		// Low bytes of the 16 products, then high bytes
+		prod=_mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_and_si256(prod,byteMask),
+			_mm256_srli_epi16(prod,8)),0xd8);
+		tbl[qx][0]=_mm256_castsi256_si128(prod);
+		tbl[qx][1]=_mm256_extracti128_si256(prod,1);
+	}
+}
+
+TARGETAVX2 static int riBMPassesAvx2(const struct BchCodec *pCdc,
+									unsigned char dLo[],unsigned char dHi[],
+									unsigned char tLo[],unsigned char tHi[])
+{
+	//****************************************************************
+	//	Function: riBMPassesAvx2
+	//
+	//  The t passes of riBM on delta(x) and theta(x) kept as field
+	//  elements, split in low and high byte arrays, 32 terms per step.
+	//  The arrays are held as whole vectors; delta(i+1), delta(i+2) and
+	//  theta(i+1) are made by shifting bytes in from the next vector.
+	//  gamma*delta(i+2) and delta(0)*theta(i+1) are multiplies by
+	//  constants, done with the tables of riBMConstTbls.  On entry the
+	//  arrays must be zero past term 3t.  Returns kk.
+	//****************************************************************
+	__m128i zTbl[4][2];
+	__m256i vDLo[MAXRIBMTERMS/32],vDHi[MAXRIBMTERMS/32],vTLo[MAXRIBMTERMS/32],vTHi[MAXRIBMTERMS/32];
+	__m256i gT[4][2],zT[4][2],nibMask,vSel,nxt,aLo,aHi,bLo,bHi,sLo,sHi,pLo,pHi,nib;
+	int qx,ix,hx,kk,delta0,sel;
+	const int numVecs=(3*pCdc->tParm+1+31)/32;
+
+	for (ix=0;ix<=numVecs;ix++){
+		vDLo[ix]=_mm256_loadu_si256((const __m256i *)(dLo+32*ix));
+		vDHi[ix]=_mm256_loadu_si256((const __m256i *)(dHi+32*ix));
+		vTLo[ix]=_mm256_loadu_si256((const __m256i *)(tLo+32*ix));
+		vTHi[ix]=_mm256_loadu_si256((const __m256i *)(tHi+32*ix));
+	}
+	nibMask=_mm256_set1_epi8(0x0f);
+	kk=0;
+	riBMConstTbls(pCdc,1,zTbl); // gamma=1
+	for (ix=0;ix<4;ix++){
+		for (hx=0;hx<2;hx++){
+			gT[ix][hx]=_mm256_broadcastsi128_si256(zTbl[ix][hx]);
+		}
+	}
+	for (qx=0;qx<pCdc->tParm;qx++){
+		delta0=(_mm_cvtsi128_si32(_mm256_castsi256_si128(vDLo[0])) & 0xff) |
+			((_mm_cvtsi128_si32(_mm256_castsi256_si128(vDHi[0])) & 0xff) << 8);
+		sel=-(int)((delta0!=0) & (kk>=0));
+		riBMConstTbls(pCdc,delta0,zTbl);
+		for (ix=0;ix<4;ix++){
+			for (hx=0;hx<2;hx++){
+				zT[ix][hx]=_mm256_broadcastsi128_si256(zTbl[ix][hx]);
+			}
+		}
+		vSel=_mm256_set1_epi8((char)sel);
+		for (ix=0;ix<numVecs;ix++){
+			nxt=_mm256_permute2x128_si256(vDLo[ix],vDLo[ix+1],0x21);
+			sLo=_mm256_alignr_epi8(nxt,vDLo[ix],1);		// delta(i+1)
+			aLo=_mm256_alignr_epi8(nxt,vDLo[ix],2);		// delta(i+2)
+			nxt=_mm256_permute2x128_si256(vDHi[ix],vDHi[ix+1],0x21);
+			sHi=_mm256_alignr_epi8(nxt,vDHi[ix],1);
+			aHi=_mm256_alignr_epi8(nxt,vDHi[ix],2);
+			nxt=_mm256_permute2x128_si256(vTLo[ix],vTLo[ix+1],0x21);
+			bLo=_mm256_alignr_epi8(nxt,vTLo[ix],1);		// theta(i+1)
+			nxt=_mm256_permute2x128_si256(vTHi[ix],vTHi[ix+1],0x21);
+			bHi=_mm256_alignr_epi8(nxt,vTHi[ix],1);
+			pLo=_mm256_setzero_si256();
+			pHi=_mm256_setzero_si256();
+			for (hx=0;hx<4;hx++){
+				nib=_mm256_and_si256((hx==0) ? aLo : (hx==1) ? _mm256_srli_epi16(aLo,4) :
+					(hx==2) ? aHi : _mm256_srli_epi16(aHi,4),nibMask);
+				pLo=_mm256_xor_si256(pLo,_mm256_shuffle_epi8(gT[hx][0],nib));
+				pHi=_mm256_xor_si256(pHi,_mm256_shuffle_epi8(gT[hx][1],nib));
+				nib=_mm256_and_si256((hx==0) ? bLo : (hx==1) ? _mm256_srli_epi16(bLo,4) :
+					(hx==2) ? bHi : _mm256_srli_epi16(bHi,4),nibMask);
+				pLo=_mm256_xor_si256(pLo,_mm256_shuffle_epi8(zT[hx][0],nib));
+				pHi=_mm256_xor_si256(pHi,_mm256_shuffle_epi8(zT[hx][1],nib));
+			}
+			// theta(i) = delta(i+1) if the length changes, else theta(i)
+			vTLo[ix]=_mm256_or_si256(_mm256_and_si256(vSel,sLo),_mm256_andnot_si256(vSel,vTLo[ix]));
+			vTHi[ix]=_mm256_or_si256(_mm256_and_si256(vSel,sHi),_mm256_andnot_si256(vSel,vTHi[ix]));
+			vDLo[ix]=pLo;
+			vDHi[ix]=pHi;
+		}
+		// gamma becomes delta(0) if the length changes - so do its tables
+		for (ix=0;ix<4;ix++){
+			for (hx=0;hx<2;hx++){
+				gT[ix][hx]=_mm256_or_si256(_mm256_and_si256(vSel,zT[ix][hx]),_mm256_andnot_si256(vSel,gT[ix][hx]));
+			}
+		}
+		kk=((-kk) & sel) | ((kk+2) & ~sel);
+	}
+	for (ix=0;ix<numVecs;ix++){
+		_mm256_storeu_si256((__m256i *)(dLo+32*ix),vDLo[ix]);
+		_mm256_storeu_si256((__m256i *)(dHi+32*ix),vDHi[ix]);
+	}
+	return(kk);
+}
+
+TARGETAVX512BW static int riBMPassesAvx512(const struct BchCodec *pCdc,
+										  unsigned char dLo[],unsigned char dHi[],
+										  unsigned char tLo[],unsigned char tHi[])
+{
+	//****************************************************************
+	//	Function: riBMPassesAvx512
+	//
+	//  Same as riBMPassesAvx2 but 64 terms per step.
+	//****************************************************************
+	__m128i zTbl[4][2];
+	__m512i vDLo[MAXRIBMTERMS/64],vDHi[MAXRIBMTERMS/64],vTLo[MAXRIBMTERMS/64],vTHi[MAXRIBMTERMS/64];
+	__m512i gT[4][2],zT[4][2],nibMask,vSel,nxt,aLo,aHi,bLo,bHi,sLo,sHi,pLo,pHi,nib;
+	int qx,ix,hx,kk,delta0,sel;
+	const int numVecs=(3*pCdc->tParm+1+63)/64;
+
+	for (ix=0;ix<=numVecs;ix++){
+		vDLo[ix]=_mm512_loadu_si512((const void *)(dLo+64*ix));
+		vDHi[ix]=_mm512_loadu_si512((const void *)(dHi+64*ix));
+		vTLo[ix]=_mm512_loadu_si512((const void *)(tLo+64*ix));
+		vTHi[ix]=_mm512_loadu_si512((const void *)(tHi+64*ix));
+	}
+	nibMask=_mm512_set1_epi8(0x0f);
+	kk=0;
+	riBMConstTbls(pCdc,1,zTbl); // gamma=1
+	for (ix=0;ix<4;ix++){
+		for (hx=0;hx<2;hx++){
+			gT[ix][hx]=_mm512_broadcast_i32x4(zTbl[ix][hx]);
+		}
+	}
+	for (qx=0;qx<pCdc->tParm;qx++){
+		delta0=(_mm_cvtsi128_si32(_mm512_castsi512_si128(vDLo[0])) & 0xff) |
+			((_mm_cvtsi128_si32(_mm512_castsi512_si128(vDHi[0])) & 0xff) << 8);
+		sel=-(int)((delta0!=0) & (kk>=0));
+		riBMConstTbls(pCdc,delta0,zTbl);
+		for (ix=0;ix<4;ix++){
+			for (hx=0;hx<2;hx++){
+				zT[ix][hx]=_mm512_broadcast_i32x4(zTbl[ix][hx]);
+			}
+		}
+		vSel=_mm512_set1_epi8((char)sel);
+		for (ix=0;ix<numVecs;ix++){
+			nxt=_mm512_alignr_epi32(vDLo[ix+1],vDLo[ix],4);
+			sLo=_mm512_alignr_epi8(nxt,vDLo[ix],1);		// delta(i+1)
+			aLo=_mm512_alignr_epi8(nxt,vDLo[ix],2);		// delta(i+2)
+			nxt=_mm512_alignr_epi32(vDHi[ix+1],vDHi[ix],4);
+			sHi=_mm512_alignr_epi8(nxt,vDHi[ix],1);
+			aHi=_mm512_alignr_epi8(nxt,vDHi[ix],2);
+			nxt=_mm512_alignr_epi32(vTLo[ix+1],vTLo[ix],4);
+			bLo=_mm512_alignr_epi8(nxt,vTLo[ix],1);		// theta(i+1)
+			nxt=_mm512_alignr_epi32(vTHi[ix+1],vTHi[ix],4);
+			bHi=_mm512_alignr_epi8(nxt,vTHi[ix],1);
+			pLo=_mm512_setzero_si512();
+			pHi=_mm512_setzero_si512();
+			for (hx=0;hx<4;hx++){
+				nib=_mm512_and_si512((hx==0) ? aLo : (hx==1) ? _mm512_srli_epi16(aLo,4) :
+					(hx==2) ? aHi : _mm512_srli_epi16(aHi,4),nibMask);
+				pLo=_mm512_xor_si512(pLo,_mm512_shuffle_epi8(gT[hx][0],nib));
+				pHi=_mm512_xor_si512(pHi,_mm512_shuffle_epi8(gT[hx][1],nib));
+				nib=_mm512_and_si512((hx==0) ? bLo : (hx==1) ? _mm512_srli_epi16(bLo,4) :
+					(hx==2) ? bHi : _mm512_srli_epi16(bHi,4),nibMask);
+				pLo=_mm512_xor_si512(pLo,_mm512_shuffle_epi8(zT[hx][0],nib));
+				pHi=_mm512_xor_si512(pHi,_mm512_shuffle_epi8(zT[hx][1],nib));
+			}
+			// theta(i) = delta(i+1) if the length changes, else theta(i)
+			vTLo[ix]=_mm512_or_si512(_mm512_and_si512(vSel,sLo),_mm512_andnot_si512(vSel,vTLo[ix]));
+			vTHi[ix]=_mm512_or_si512(_mm512_and_si512(vSel,sHi),_mm512_andnot_si512(vSel,vTHi[ix]));
+			vDLo[ix]=pLo;
+			vDHi[ix]=pHi;
+		}
+		// gamma becomes delta(0) if the length changes - so do its tables
+		for (ix=0;ix<4;ix++){
+			for (hx=0;hx<2;hx++){
+				gT[ix][hx]=_mm512_or_si512(_mm512_and_si512(vSel,zT[ix][hx]),_mm512_andnot_si512(vSel,gT[ix][hx]));
+			}
+		}
+		kk=((-kk) & sel) | ((kk+2) & ~sel);
+	}
+	for (ix=0;ix<numVecs;ix++){
+		_mm512_storeu_si512((void *)(dLo+64*ix),vDLo[ix]);
+		_mm512_storeu_si512((void *)(dHi+64*ix),vDHi[ix]);
+	}
+	return(kk);
+}
+#endif
+
+static int riBMElp(const struct BchCodec *pCdc,int sigmaN[],const int logDelta[],
+				   int kk,int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: riBMElp
+	//
+	//  Last step of riBM (and of the bit-sliced riBM of the batch
+	//  decoder).  The ELP is delta(t..2t), in log form, and kk is
+	//  2*passes - 2*Ln.  The ELP is normalized by 1/delta(t) so that
+	//  sigmaN[0]=1.  Returns Ln, with BERMASERR set as in berMas.
+	//****************************************************************
+	int ix,Ln,val,logNorm;
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const int nParm=pCdc->nParm;
+	const int tParm=pCdc->tParm;
+	const int logZVal=pCdc->logZVal;
+
+	Ln=(2*tParm-kk)/2;
+	// Normalize by 1/delta(t) so that sigmaN[0]=1
+	logNorm=(logDelta[tParm]==logZVal) ? 0 : nParm-logDelta[tParm];
+	for (ix=0;ix<=tParm;ix++){
+		val=logDelta[tParm+ix]+logNorm;
+		sigmaN[ix]=alogTbl[(val<logZVal) ? val : logZVal];
+	}
+	if (Ln>tParm || logDelta[tParm]==logZVal){
+		*pErrFlg|=BERMASERR;
+		return(Ln);
+	}
+	if (sigmaN[Ln]==0){
+		*pErrFlg|=BERMASERR;
+	}
+	return (Ln);
+}
+
+static int riBM(const struct BchCodec *pCdc,int sigmaN[],const int syndromes[],
+				int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: riBM
+	//
+	//  Alternative to berMas - the reformulated inversionless
+	//  Berlekamp-Massey algorithm (riBM) of Sarwate and Shanbhag,
+	//  "High-Speed Architectures for Reed-Solomon Decoders", IEEE
+	//  Transactions on VLSI Systems, vol. 9, no. 5, Oct. 2001.  The
+	//  discrepancy is not computed as a sum of products - it is always
+	//  delta(0) of the 3t+1 term array delta(x), which holds the ELP
+	//  times the syndromes, and which is updated with theta(x) as
+	//
+	//     delta(i) = gamma*delta(i+1) + delta(0)*theta(i)
+	//
+	//  For a binary BCH code every second discrepancy is zero, so two
+	//  steps are done per pass (delta(i+2) and theta(i+1) above) and t
+	//  passes are made.  Dropping the zero steps only scales the ELP.
+	//
+	//  Every pass runs the same loop over all 3t+1 terms, with no
+	//  divisions and no branches that depend on the data.  The "length
+	//  change" decision of berMas becomes a select.  With AVX2 or
+	//  AVX-512BW the loop runs 32 or 64 terms per step (riBMPassesAvx2
+	//  and riBMPassesAvx512).  Otherwise the arrays are kept in the log
+	//  domain, and a product with a zero operand is made zero by
+	//  clamping the sum of logs to logZVal (alogTbl has an entry there),
+	//  which is a min rather than a branch.
+	//
+	//  The ELP is delta(t..2t) at the end, normalized by riBMElp so
+	//  that sigmaN[0]=1 - the same ELP berMas computes.  Ln and
+	//  BERMASERR are as in berMas.
+	//****************************************************************
+	int logDelta[3*MAXCORR+3],logTheta[3*MAXCORR+3];
+	int qx,ix,kk,prodA,prodB,logGamma,logDelta0,sel,val;
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int tParm=pCdc->tParm;
+	const int logZVal=pCdc->logZVal;
+	const int numTerms=3*tParm+1;
+#if BCHX86SIMD
+	unsigned char dLo[MAXRIBMTERMS],dHi[MAXRIBMTERMS],tLo[MAXRIBMTERMS],tHi[MAXRIBMTERMS];
+
+	if (pCdc->keyEqLanes>1){
+		for (ix=0;ix<MAXRIBMTERMS;ix++){
+			dLo[ix]=dHi[ix]=0;
+		}
+		for (ix=0;ix<2*tParm;ix++){
+			dLo[ix]=(unsigned char)(syndromes[ix] & 0xff);
+			dHi[ix]=(unsigned char)(syndromes[ix] >> 8);
+		}
+		dLo[3*tParm]=1; // The number "1"
+		for (ix=0;ix<MAXRIBMTERMS;ix++){
+			tLo[ix]=dLo[ix];
+			tHi[ix]=dHi[ix];
+		}
+		if (pCdc->keyEqLanes==64){
+			kk=riBMPassesAvx512(pCdc,dLo,dHi,tLo,tHi);
+		}
+		else {
+			kk=riBMPassesAvx2(pCdc,dLo,dHi,tLo,tHi);
+		}
+		for (ix=tParm;ix<=2*tParm;ix++){
+			val=dLo[ix] | (dHi[ix] << 8);
+			logDelta[ix]=(val!=0) ? logTbl[val] : logZVal;
+		}
+	}
+	else
+#endif
+	{
+		for (ix=0;ix<numTerms+2;ix++){
+			logDelta[ix]=logZVal;
+		}
+		for (ix=0;ix<2*tParm;ix++){
+			logDelta[ix]=(syndromes[ix]!=0) ? logTbl[syndromes[ix]] : logZVal;
+		}
+		logDelta[3*tParm]=0; // The number "1"
+		for (ix=0;ix<numTerms+2;ix++){
+			logTheta[ix]=logDelta[ix];
+		}
+		kk=0;		// 2*passes - 2*Ln, berMas changes length if kk>=0
+		logGamma=0;	// gamma=1
+		for (qx=0;qx<tParm;qx++){
+			logDelta0=logDelta[0];
+			// sel is all ones if the length changes on this pass
+			sel=-(int)((logDelta0!=logZVal) & (kk>=0));
+			for (ix=0;ix<numTerms;ix++){
+				prodA=logGamma+logDelta[ix+2];
+				prodB=logDelta0+logTheta[ix+1];
+				prodA=(prodA<logZVal) ? prodA : logZVal;
+				prodB=(prodB<logZVal) ? prodB : logZVal;
+				logTheta[ix]=(logDelta[ix+1] & sel) | (logTheta[ix] & ~sel);
+				val=alogTbl[prodA]^alogTbl[prodB];
+				logDelta[ix]=(val!=0) ? logTbl[val] : logZVal;
+			}
+			logGamma=(logDelta0 & sel) | (logGamma & ~sel);
+			kk=((-kk) & sel) | ((kk+2) & ~sel);
+		}
+	}
+	return(riBMElp(pCdc,sigmaN,logDelta,kk,pErrFlg));
+}
+
+static int chienSearchRange(const struct BchCodec *pCdc,int *pStartPos)
+{
+	//****************************************************************
+	//	Function: chienSearchRange
+	//
+	//  Returns the position one past the last position the Chien
+	//  searches evaluate, and sets *pStartPos to the first one.  The
+	//  code is shortened, so only positions below numCodewordBytes*8
+	//  are codeword bits.  The lowest positions are the pad bits at the
+	//  end of the last redundancy byte.  fixErrors rejects a root there
+	//  (CORROUTSIDE), so if chienShortenedFlg is set they are skipped.
+	//****************************************************************
+	*pStartPos=0;
+	if (pCdc->chienShortenedFlg!=0){
+		*pStartPos=pCdc->numCodewordBytes*8-pCdc->numDataBits-pCdc->numRedunBits;
+	}
+	return(pCdc->numCodewordBytes*8);
+}
+
+static void chienElpAtPos(const struct BchCodec *pCdc,const int sigmaN[],int Ln,
+						  int pos,int coef[])
+{
+	//****************************************************************
+	//	Function: chienElpAtPos
+	//
+	//  Sets coef(j) to sigma(j)*alpha^(-j*pos), the ELP coefficients
+	//  the Chien search has when it reaches position pos.
+	//****************************************************************
+	int jx;
+	const int nParm=pCdc->nParm;
+
+	coef[0]=1;
+	for (jx=1;jx<=Ln;jx++){
+		coef[jx]=0;
+		if (sigmaN[jx]!=0){
+			coef[jx]=pCdc->alogTbl[(pCdc->logTbl[sigmaN[jx]]+nParm-(jx*pos)%nParm)%nParm];
+		}
+	}
+}
+
+static int chienSearch(const struct BchCodec *pCdc,int sigmaN[],int Loc[],const int LnOrig)
+{
+	//****************************************************************
+	//  Function:	ChienSearch
+	//
+	//  This is an enhanced version of the Chien search algorithm.  As
+	//  coded here the function finds roots until the degree (Ln) of
+	//  the Error Locator Polynomial (ELP) has been reduced to elpStopDeg,
+	//  six with affineElp, otherwise four if "m" is even, or two if "m"
+	//  is odd.  lowDegreeElp finds the last roots.  This function is not
+	//  called if the degree of the original ELP is elpStopDeg or less.
+	//  To optimize speed two different techniques are
+	//  used to advance the ELP for its next evaluation.
+	//
+	//  For this code a fast technique is used when there are no zero
+	//  coefficients in the ELP.  A slower technique is used when there are
+	//  zero coefficients in the ELP. The probability that there are zero
+	//  coefficients in the ELP is relatively low.  Also for speed the ELP
+	//  is divided down each time a root is found.  Also for speed the inner
+	//  most loop of the faster technique is unrolled.  Again for speed, mod
+	//  operations are replaced with equivalent but faster operations.
+	//  My original knowledge of unrolling loops came from the Earl
+	//  Cohen Ph.D. thesis (Berkeley).  See also the Glover-Dudley patent
+	//  4,839,896.
+	//
+	//  The fastest Chien search technique that I am aware of is to
+	//  keep the coefficient values in alog form and to use a table
+	//  in memory to implement each constant multiplier of the Chien
+	//  search.  With this technique combined with loop unrolling
+	//  I think you would see a speed up by about a factor of two
+	//  for root finding.  The memory space requirement will be very
+	//  large for large finite fields.  The large memory requirement
+	//  may not be a problem for decoders that run on a PC.
+	//
+	//  There are software root finding techniques that beat the
+	//  speed of even very well written Chien search software.
+	//  Some of these techniques are for particular cases such
+	//  as for quintic and sextic polynomials (see affineElp).  But
+	//  others are for the general case.  Contact the author for more
+	//  information.
+	//
+	//  The original reference for the most basic Chien search is
+	//  "Cyclic Decoding Procedures for Bose-Chaudhuri-
+	//  Hocquenghem Codes", IEEE Transactions on Information Theory,
+	//  vol. IT-10, pp 357-363, Oct. 1964.
+	//
+	//  If chienShortenedFlg is set the search starts at the first
+	//  codeword bit (see chienSearchRange) and quits, with ROOTSNEQLN,
+	//  as soon as the positions left are fewer than the roots still
+	//  needed.  The ELP of an uncorrectable codeword seldom has its
+	//  roots in the codeword, so this returns UNCORR early.
+	//
+	//****************************************************************
+	int nn,jj,kx,coeffContainsAZero;
+	int accum,reg,tmp,errFlg,Ln,startPos,endPos,lastPos,stopDeg;
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int nParm=pCdc->nParm;
+	//
+	errFlg=0;
+	Ln=LnOrig;
+	stopDeg=elpStopDeg(pCdc);
+	endPos=chienSearchRange(pCdc,&startPos);
+	lastPos=endPos;
+	if (pCdc->chienShortenedFlg!=0){
+		lastPos=endPos-(Ln-stopDeg)+1; // From here on the missing roots cannot fit
+	}
+	// Check for a zero coeff before converting to log domain and if find one, set flag
+	coeffContainsAZero = 0;
+	for (kx=1;kx<=Ln;kx++){
+		if (sigmaN[kx]==0){
+			coeffContainsAZero = 1;
+			break;
+		}
+	}
+	// Convert error locator poly to log domain for Chien Search
+	for (nn=1;nn<=Ln;nn++){
+		sigmaN[nn] = (sigmaN[nn]!=0) ? logTbl[sigmaN[nn]] : pCdc->logZVal;
+		if (sigmaN[nn] != pCdc->logZVal){ // Advance to the first position
+			sigmaN[nn] = (sigmaN[nn]+nParm-(nn*startPos)%nParm)%nParm;
+		}
+	}
+	for (nn=startPos;nn<lastPos;nn++){
+		accum = 0;
+		// Do simple Chien Search if zero coeffs or if Ln>8.  YOU CANNOT
+		// CHANGE THE # 8 IN "Ln>8" WITHOUT ADDING MORE ENTRIES FOR THE
+		// UNROLLED LOOP
+		if (coeffContainsAZero == 1 || Ln>8){
+			for (jj=1;jj<=Ln;jj++){ // One step of Simple Chien Search in this loop
+				if (sigmaN[jj] != pCdc->logZVal){ // Test for log of zero
+					accum ^= alogTbl[sigmaN[jj]];
+					sigmaN[jj] -= jj;
+					if (sigmaN[jj] < 0){ // Compare & subtract is faster than mod
+						sigmaN[jj] += nParm;
+					}
+				}
+			}
+		}
+		else{
+			// Unrolled loop
+			switch (Ln)
+			{
+			case 8:accum ^= alogTbl[sigmaN[8]];  // accum is XOR sum of all alogs
+				sigmaN[8] -= 8;
+				if (sigmaN[8] < 0){
+					sigmaN[8] += nParm;
+				}
+				//lint -fallthrough
+			case 7:accum ^= alogTbl[sigmaN[7]];  // accum is XOR sum of all alogs
+				sigmaN[7] -= 7;
+				if (sigmaN[7] < 0){
+					sigmaN[7] += nParm;
+				}
+				//lint -fallthrough
+			case 6:accum ^= alogTbl[sigmaN[6]];  // accum is XOR sum of all alogs
+				sigmaN[6] -= 6;
+				if (sigmaN[6] < 0){
+					sigmaN[6] += nParm;
+				}
+				//lint -fallthrough
+			case 5:accum ^= alogTbl[sigmaN[5]];  // accum is XOR sum of all alogs
+				sigmaN[5] -= 5;
+				if (sigmaN[5] < 0){
+					sigmaN[5] += nParm;
+				}
+				//lint -fallthrough
+			case 4:accum ^= alogTbl[sigmaN[4]];  // accum is XOR sum of all alogs
+				sigmaN[4] -= 4;
+				if (sigmaN[4] < 0){
+					sigmaN[4] += nParm;
+				}
+				//lint -fallthrough
+			case 3:accum ^= alogTbl[sigmaN[3]];  // accum is XOR sum of all alogs
+				sigmaN[3] -= 3;
+				if (sigmaN[3] < 0){
+					sigmaN[3] += nParm;
+				}
+				//lint -fallthrough
+			case 2:accum ^= alogTbl[sigmaN[2]];  // accum is XOR sum of all alogs
+				sigmaN[2] -= 2;
+				if (sigmaN[2] < 0){
+					sigmaN[2] += nParm;
+				}
+				//lint -fallthrough
+			case 1:accum ^= alogTbl[sigmaN[1]];  // accum is XOR sum of all alogs
+				sigmaN[1] -= 1;
+				if (sigmaN[1] < 0){
+					sigmaN[1] += nParm;
+				}
+				//lint -fallthrough
+			default: break;
+			}
+		}
+		if (accum==1){
+			Loc[Ln-1]=alogTbl[nn];
+			// Convert back to alog domain so we can divide down
+			for (kx=1;kx<=Ln;kx++){
+				sigmaN[kx] = alogTbl[sigmaN[kx]];
+			}
+			// Divide down the ELP to eliminate the root just found
+			reg=0;
+			for (kx=Ln;kx>=0;kx--){
+				tmp=ffMult(pCdc,reg,alogTbl[1]);// The number "1"
+				reg=sigmaN[kx]^tmp;
+				sigmaN[kx]=tmp;
+			}
+			Ln--; // Ln must be decremented right here - do not move
+			if (pCdc->chienShortenedFlg!=0){
+				lastPos++; // One less root is missing
+			}
+			// Check if any coefficients are zero and set flag appropriately
+			coeffContainsAZero = 0;
+			for (kx=1;kx<=Ln;kx++){
+				if (sigmaN[kx]==0){
+					coeffContainsAZero = 1;
+					break;
+				}
+			}
+			// If degree reduced, special cases will take it from here
+			if (Ln==stopDeg)
+			{
+				// We are still in alog domain so,
+				// position the ELP back to its starting point for special cases
+				for (kx=1;kx<=Ln;kx++){
+					sigmaN[kx]=ffMult(pCdc,sigmaN[kx],alogTbl[((nn+1)*kx)%nParm]);
+				}
+				break;
+			}
+			// Convert back to log domain so we can continue root search
+			for (kx=1;kx<=Ln;kx++){
+				sigmaN[kx] = (sigmaN[kx]!=0) ? logTbl[sigmaN[kx]] : pCdc->logZVal;
+			}
+		}
+	}
+	// If degree of ELP has not been reduced properly
+	if (Ln!=stopDeg){
+		errFlg|=ROOTSNEQLN;
+	}
+	return (errFlg);
+}
+
+static int rootFindChien(const struct BchCodec *pCdc,int sigmaN[],int Loc[],const int LnOrig)
+{
+	//****************************************************************
+	//	Function: rootFindChien
+	//
+	//  NOTE: There are seperate rootFind functions for Chien and BTA.
+	//
+	//  This function is the highest level root finding function.  It calls
+	//  lower level root finding functions.  There are special functions
+	//  called for error locator polynomial (ELP) degrees 1 to elpStopDeg
+	//  (see lowDegreeElp).  If the degree of the ELP is greater than
+	//  elpStopDeg the Chien search function is called.
+	//****************************************************************
+	int errFlg;
+	const int stopDeg=elpStopDeg(pCdc);
+
+	if (LnOrig<=stopDeg){
+		errFlg=lowDegreeElp(pCdc,sigmaN,Loc,LnOrig);
+	}
+	else
+	{
+		errFlg=chienSearch(pCdc,sigmaN,Loc,LnOrig);
+		if (errFlg==0){
+			// Chien will have divided down to degree stopDeg
+			errFlg|=lowDegreeElp(pCdc,sigmaN,Loc,stopDeg);
+		}
+	}
+	return (errFlg);
+}
+
+static void chienLaneInit(const struct BchCodec *pCdc,const int sigmaN[],int Ln,
+						  unsigned char laneLo[][MAXCHIENLANES],
+						  unsigned char laneHi[][MAXCHIENLANES])
+{
+	//****************************************************************
+	//	Function: chienLaneInit
+	//
+	//  Sets up the lanes for the SIMD Chien search.  Lane p of
+	//  coefficient j gets sigma(j)*alpha^(-j*p), split in a low byte
+	//  and a high byte.  This is the value the Chien search adds for
+	//  coefficient j at position p.
+	//****************************************************************
+	int jx,px,logSigma,logVal,val;
+	const int nParm=pCdc->nParm;
+
+	for (jx=1;jx<=Ln;jx++){
+		logSigma=(sigmaN[jx]==0) ? -1 : pCdc->logTbl[sigmaN[jx]];
+		for (px=0;px<pCdc->chienLanes;px++){
+			val=0;
+			if (logSigma>=0){
+				logVal=logSigma-(int)(((long long)jx*px)%nParm);
+				if (logVal<0){
+					logVal+=nParm;
+				}
+				val=pCdc->alogTbl[logVal];
+			}
+			laneLo[jx][px]=(unsigned char)(val & 0xff);
+			laneHi[jx][px]=(unsigned char)(val >> 8);
+		}
+	}
+}
+
+#if BCHX86SIMD
+TARGETAVX2 static int chienSearchAvx2(const struct BchCodec *pCdc,const int sigmaN[],
+									 int Loc[],const int Ln)
+{
+	//****************************************************************
+	//	Function: chienSearchAvx2
+	//
+	//  SIMD Chien search for any Ln up to MAXCORR.  32 consecutive
+	//  positions are evaluated per step.  The lanes of coefficient j
+	//  are kept as a vector of low bytes and a vector of high bytes
+	//  (see chienLaneInit).  The ELP value for the 32 positions is the
+	//  XOR of the coefficient vectors (plus 1 for sigma(0)), so a root
+	//  is a lane whose XOR is 1.  Each step every coefficient vector is
+	//  multiplied by its constant with split nibble PSHUFB tables (see
+	//  genChienStepTbls).  The ELP is not divided down, all Ln roots
+	//  are found here and the search stops as soon as they are found.
+	//  chienShortenedFlg works as in chienSearch.
+	//
+	//  Loc gets alpha^p for each root position p, as for chienSearch.
+	//****************************************************************
+	__m256i vLo[MAXCORR+1],vHi[MAXCORR+1],accLo,accHi,nibMask,prodLo,prodHi;
+	__m256i n0,n1,n2,n3,tbl;
+	unsigned char laneLo[MAXCORR+1][MAXCHIENLANES],laneHi[MAXCORR+1][MAXCHIENLANES];
+	unsigned int rootMask;
+	int jx,px,qx,base,numRoots,startPos,endPos,coef[MAXCORR+1];
+
+	endPos=chienSearchRange(pCdc,&startPos);
+	chienElpAtPos(pCdc,sigmaN,Ln,startPos,coef);
+	chienLaneInit(pCdc,coef,Ln,laneLo,laneHi);
+	for (jx=1;jx<=Ln;jx++){
+		vLo[jx]=_mm256_loadu_si256((const __m256i *)laneLo[jx]);
+		vHi[jx]=_mm256_loadu_si256((const __m256i *)laneHi[jx]);
+	}
+	nibMask=_mm256_set1_epi8(0x0f);
+	numRoots=0;
+	for (base=startPos;base<endPos;base+=32){
+		if (pCdc->chienShortenedFlg!=0 && endPos-base<Ln-numRoots){
+			break; // The missing roots cannot fit
+		}
+		accLo=_mm256_setzero_si256();
+		accHi=_mm256_setzero_si256();
+		for (jx=1;jx<=Ln;jx++){
+			accLo=_mm256_xor_si256(accLo,vLo[jx]);
+			accHi=_mm256_xor_si256(accHi,vHi[jx]);
+		}
+		// Roots - low byte 1 and high byte 0
+		rootMask=(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(accLo,_mm256_set1_epi8(1)))
+			& (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(accHi,_mm256_setzero_si256()));
+		if (endPos-base<32){
+			rootMask&=(1U<<(endPos-base))-1;
+		}
+		for (px=0;rootMask!=0;px++,rootMask>>=1){
+			if (rootMask & 1){
+				if (numRoots<Ln){
+					Loc[numRoots]=pCdc->alogTbl[base+px];
+				}
+				numRoots++;
+			}
+		}
+		if (numRoots>=Ln){
+			break;
+		}
+		// Advance every coefficient by 32 positions
+		for (jx=1;jx<=Ln;jx++){
+			n0=_mm256_and_si256(vLo[jx],nibMask);
+			n1=_mm256_and_si256(_mm256_srli_epi16(vLo[jx],4),nibMask);
+			n2=_mm256_and_si256(vHi[jx],nibMask);
+			n3=_mm256_and_si256(_mm256_srli_epi16(vHi[jx],4),nibMask);
+			prodLo=_mm256_setzero_si256();
+			prodHi=_mm256_setzero_si256();
+			for (qx=0;qx<4;qx++){
+				const __m256i nib=(qx==0) ? n0 : (qx==1) ? n1 : (qx==2) ? n2 : n3;
+				tbl=_mm256_broadcastsi128_si256(_mm_loadu_si128(
+					(const __m128i *)pCdc->chienStepTbl[jx][qx][0]));
+				prodLo=_mm256_xor_si256(prodLo,_mm256_shuffle_epi8(tbl,nib));
+				tbl=_mm256_broadcastsi128_si256(_mm_loadu_si128(
+					(const __m128i *)pCdc->chienStepTbl[jx][qx][1]));
+				prodHi=_mm256_xor_si256(prodHi,_mm256_shuffle_epi8(tbl,nib));
+			}
+			vLo[jx]=prodLo;
+			vHi[jx]=prodHi;
+		}
+	}
+	if (numRoots!=Ln){
+		return(ROOTSNEQLN);
+	}
+	return(0);
+}
+
+TARGETAVX512BW static int chienSearchAvx512(const struct BchCodec *pCdc,const int sigmaN[],
+										   int Loc[],const int Ln)
+{
+	//****************************************************************
+	//	Function: chienSearchAvx512
+	//
+	//  Same as chienSearchAvx2 but 64 positions are evaluated per step.
+	//****************************************************************
+	__m512i vLo[MAXCORR+1],vHi[MAXCORR+1],accLo,accHi,nibMask,prodLo,prodHi;
+	__m512i n0,n1,n2,n3,tbl;
+	unsigned char laneLo[MAXCORR+1][MAXCHIENLANES],laneHi[MAXCORR+1][MAXCHIENLANES];
+	unsigned long long rootMask;
+	int jx,px,qx,base,numRoots,startPos,endPos,coef[MAXCORR+1];
+
+	endPos=chienSearchRange(pCdc,&startPos);
+	chienElpAtPos(pCdc,sigmaN,Ln,startPos,coef);
+	chienLaneInit(pCdc,coef,Ln,laneLo,laneHi);
+	for (jx=1;jx<=Ln;jx++){
+		vLo[jx]=_mm512_loadu_si512((const void *)laneLo[jx]);
+		vHi[jx]=_mm512_loadu_si512((const void *)laneHi[jx]);
+	}
+	nibMask=_mm512_set1_epi8(0x0f);
+	numRoots=0;
+	for (base=startPos;base<endPos;base+=64){
+		if (pCdc->chienShortenedFlg!=0 && endPos-base<Ln-numRoots){
+			break; // The missing roots cannot fit
+		}
+		accLo=_mm512_setzero_si512();
+		accHi=_mm512_setzero_si512();
+		for (jx=1;jx<=Ln;jx++){
+			accLo=_mm512_xor_si512(accLo,vLo[jx]);
+			accHi=_mm512_xor_si512(accHi,vHi[jx]);
+		}
+		// Roots - low byte 1 and high byte 0
+		rootMask=(unsigned long long)(_mm512_cmpeq_epi8_mask(accLo,_mm512_set1_epi8(1))
+			& _mm512_cmpeq_epi8_mask(accHi,_mm512_setzero_si512()));
+		if (endPos-base<64){
+			rootMask&=(1ULL<<(endPos-base))-1;
+		}
+		for (px=0;rootMask!=0;px++,rootMask>>=1){
+			if (rootMask & 1){
+				if (numRoots<Ln){
+					Loc[numRoots]=pCdc->alogTbl[base+px];
+				}
+				numRoots++;
+			}
+		}
+		if (numRoots>=Ln){
+			break;
+		}
+		// Advance every coefficient by 64 positions
+		for (jx=1;jx<=Ln;jx++){
+			n0=_mm512_and_si512(vLo[jx],nibMask);
+			n1=_mm512_and_si512(_mm512_srli_epi16(vLo[jx],4),nibMask);
+			n2=_mm512_and_si512(vHi[jx],nibMask);
+			n3=_mm512_and_si512(_mm512_srli_epi16(vHi[jx],4),nibMask);
+			prodLo=_mm512_setzero_si512();
+			prodHi=_mm512_setzero_si512();
+			for (qx=0;qx<4;qx++){
+				const __m512i nib=(qx==0) ? n0 : (qx==1) ? n1 : (qx==2) ? n2 : n3;
+				tbl=_mm512_broadcast_i32x4(_mm_loadu_si128(
+					(const __m128i *)pCdc->chienStepTbl[jx][qx][0]));
+				prodLo=_mm512_xor_si512(prodLo,_mm512_shuffle_epi8(tbl,nib));
+				tbl=_mm512_broadcast_i32x4(_mm_loadu_si128(
+					(const __m128i *)pCdc->chienStepTbl[jx][qx][1]));
+				prodHi=_mm512_xor_si512(prodHi,_mm512_shuffle_epi8(tbl,nib));
+			}
+			vLo[jx]=prodLo;
+			vHi[jx]=prodHi;
+		}
+	}
+	if (numRoots!=Ln){
+		return(ROOTSNEQLN);
+	}
+	return(0);
+}
+#endif
+
+#if BCHX86SIMD
+TARGETGFNI static int chienSearchGfni(const struct BchCodec *pCdc,const int sigmaN[],
+									 int Loc[],const int Ln)
+{
+	//****************************************************************
+	//	Function: chienSearchGfni
+	//
+	//  Same as chienSearchAvx512 but each step multiplies a coefficient
+	//  by its constant with four GF2P8AFFINEQB (chienStepMat, see
+	//  ffLinearMats) in place of the eight nibble table PSHUFBs.
+	//****************************************************************
+	__m512i vLo[MAXCORR+1],vHi[MAXCORR+1],accLo,accHi;
+	unsigned char laneLo[MAXCORR+1][MAXCHIENLANES],laneHi[MAXCORR+1][MAXCHIENLANES];
+	unsigned long long rootMask;
+	int jx,px,base,numRoots,startPos,endPos,coef[MAXCORR+1];
+	const unsigned long long (*mat)[2];
+
+	endPos=chienSearchRange(pCdc,&startPos);
+	chienElpAtPos(pCdc,sigmaN,Ln,startPos,coef);
+	chienLaneInit(pCdc,coef,Ln,laneLo,laneHi);
+	for (jx=1;jx<=Ln;jx++){
+		vLo[jx]=_mm512_loadu_si512((const void *)laneLo[jx]);
+		vHi[jx]=_mm512_loadu_si512((const void *)laneHi[jx]);
+	}
+	numRoots=0;
+	for (base=startPos;base<endPos;base+=64){
+		if (pCdc->chienShortenedFlg!=0 && endPos-base<Ln-numRoots){
+			break; // The missing roots cannot fit
+		}
+		accLo=_mm512_setzero_si512();
+		accHi=_mm512_setzero_si512();
+		for (jx=1;jx<=Ln;jx++){
+			accLo=_mm512_xor_si512(accLo,vLo[jx]);
+			accHi=_mm512_xor_si512(accHi,vHi[jx]);
+		}
+		// Roots - low byte 1 and high byte 0
+		rootMask=(unsigned long long)(_mm512_cmpeq_epi8_mask(accLo,_mm512_set1_epi8(1))
+			& _mm512_cmpeq_epi8_mask(accHi,_mm512_setzero_si512()));
+		if (endPos-base<64){
+			rootMask&=(1ULL<<(endPos-base))-1;
+		}
+		for (px=0;rootMask!=0;px++,rootMask>>=1){
+			if (rootMask & 1){
+				if (numRoots<Ln){
+					Loc[numRoots]=pCdc->alogTbl[base+px];
+				}
+				numRoots++;
+			}
+		}
+		if (numRoots>=Ln){
+			break;
+		}
+		// Advance every coefficient by 64 positions
+		for (jx=1;jx<=Ln;jx++){
+			mat=pCdc->chienStepMat[jx];
+			accLo=_mm512_xor_si512(
+				_mm512_gf2p8affine_epi64_epi8(vLo[jx],_mm512_set1_epi64((long long)mat[0][0]),0),
+				_mm512_gf2p8affine_epi64_epi8(vHi[jx],_mm512_set1_epi64((long long)mat[0][1]),0));
+			accHi=_mm512_xor_si512(
+				_mm512_gf2p8affine_epi64_epi8(vLo[jx],_mm512_set1_epi64((long long)mat[1][0]),0),
+				_mm512_gf2p8affine_epi64_epi8(vHi[jx],_mm512_set1_epi64((long long)mat[1][1]),0));
+			vLo[jx]=accLo;
+			vHi[jx]=accHi;
+		}
+	}
+	if (numRoots!=Ln){
+		return(ROOTSNEQLN);
+	}
+	return(0);
+}
+#endif
+
+static int rootFindChienSimd(const struct BchCodec *pCdc,int sigmaN[],int Loc[],const int LnOrig)
+{
+	//****************************************************************
+	//	Function: rootFindChienSimd
+	//
+	//  Root finder for option ROOTFINDSIMD.  The special cases for
+	//  small ELP degrees are the same as in rootFindChien.  Larger
+	//  degrees use the GFNI, AVX-512BW or AVX2 Chien search, whichever
+	//  was selected by genChienStepTbls.
+	//****************************************************************
+	int errFlg;
+	const int stopDeg=elpStopDeg(pCdc);
+
+	if (LnOrig<=stopDeg){
+		errFlg=lowDegreeElp(pCdc,sigmaN,Loc,LnOrig);
+	}
+#if BCHX86SIMD
+	else if (pCdc->chienLanes==64 && (pCdc->ffKernelFeatures & CPUGFNI)!=0){
+		errFlg=chienSearchGfni(pCdc,sigmaN,Loc,LnOrig);
+	}
+	else if (pCdc->chienLanes==64){
+		errFlg=chienSearchAvx512(pCdc,sigmaN,Loc,LnOrig);
+	}
+	else if (pCdc->chienLanes==32){
+		errFlg=chienSearchAvx2(pCdc,sigmaN,Loc,LnOrig);
+	}
+#endif
+	else {
+		errFlg=rootFindChien(pCdc,sigmaN,Loc,LnOrig); // Tables not built
+	}
+	return (errFlg);
+}
+static void chienTblLanes(const struct BchCodec *pCdc,const int coef[],int Ln,
+						  unsigned short reg[][CHIENTBLPOS])
+{
+	//****************************************************************
+	//	Function: chienTblLanes
+	//
+	//  Sets up the registers of the table Chien search.  Register px of
+	//  coefficient j gets coef(j)*alpha^(-j*px), the value the Chien
+	//  search adds for coefficient j at position px of the group.
+	//****************************************************************
+	int jj,px;
+	const int nParm=pCdc->nParm;
+
+	for (jj=1;jj<=Ln;jj++){
+		for (px=0;px<CHIENTBLPOS;px++){
+			reg[jj-1][px]=0;
+			if (coef[jj]!=0){
+				reg[jj-1][px]=(unsigned short)pCdc->alogTbl[(pCdc->logTbl[coef[jj]]+
+					nParm-(jj*px)%nParm)%nParm];
+			}
+		}
+	}
+}
+
+static int chienSearchTbl(const struct BchCodec *pCdc,int sigmaN[],int Loc[],const int LnOrig)
+{
+	//****************************************************************
+	//	Function: chienSearchTbl
+	//
+	//  The Chien search of chienSearch, but with the ELP coefficients
+	//  kept as field elements (alog form) and stepped with the constant
+	//  multiplier tables of genChienMultTbls.  CHIENTBLPOS consecutive
+	//  positions are evaluated per step, each with its own copy of the
+	//  coefficients, and each copy is advanced CHIENTBLPOS positions by
+	//  one table read.  The table reads are independent of each other
+	//  so they overlap in the CPU, and zero coefficients need no special
+	//  handling.
+	//
+	//  As in chienSearch the ELP is divided down each time a root is
+	//  found, until its degree is elpStopDeg.  The reduced ELP is left
+	//  in sigmaN for lowDegreeElp.
+	//  chienShortenedFlg works as in chienSearch.
+	//****************************************************************
+	int nn,jj,px,Ln,stopDeg,errFlg,r0,r1,r2,r3,aInv,startPos,endPos,lastPos;
+	int accum[CHIENTBLPOS],coef[MAXCORR+1];
+	unsigned short reg[MAXCORR][CHIENTBLPOS];
+	const unsigned short *multTbl;
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int nParm=pCdc->nParm;
+
+	errFlg=0;
+	Ln=LnOrig;
+	stopDeg=elpStopDeg(pCdc);
+	endPos=chienSearchRange(pCdc,&startPos);
+	lastPos=endPos;
+	if (pCdc->chienShortenedFlg!=0){
+		lastPos=endPos-(Ln-stopDeg)+1; // From here on the missing roots cannot fit
+	}
+	chienElpAtPos(pCdc,sigmaN,Ln,startPos,coef);
+	chienTblLanes(pCdc,coef,Ln,reg);
+	for (nn=startPos;nn<lastPos && Ln>stopDeg;nn+=CHIENTBLPOS){
+		accum[0]=accum[1]=accum[2]=accum[3]=0;
+		for (jj=0;jj<Ln;jj++){
+			multTbl=&pCdc->chienMultTbl[jj*pCdc->ffSize];
+			r0=reg[jj][0];
+			r1=reg[jj][1];
+			r2=reg[jj][2];
+			r3=reg[jj][3];
+			accum[0]^=r0;
+			accum[1]^=r1;
+			accum[2]^=r2;
+			accum[3]^=r3;
+			reg[jj][0]=multTbl[r0];
+			reg[jj][1]=multTbl[r1];
+			reg[jj][2]=multTbl[r2];
+			reg[jj][3]=multTbl[r3];
+		}
+		if ((accum[0]^1)!=0 && (accum[1]^1)!=0 && (accum[2]^1)!=0 && (accum[3]^1)!=0){
+			continue; // No root in this group - the usual case
+		}
+		// Register 0 now holds the ELP coefficients for position nn+4.
+		// A root at position nn+px is the root alpha^(4-px) of that ELP.
+		for (jj=1;jj<=Ln;jj++){
+			coef[jj]=reg[jj-1][0];
+		}
+		for (px=0;px<CHIENTBLPOS && Ln>stopDeg;px++){
+			if (accum[px]!=1 || nn+px>=endPos){
+				continue;
+			}
+			Loc[Ln-1]=alogTbl[nn+px];
+			// Divide down by (1+x/alpha^(4-px)) - the quotient coefficients
+			// are coef(j)+coef(j-1)/alpha^(4-px), with coef(0)=1
+			aInv=alogTbl[(px-CHIENTBLPOS+nParm)%nParm];
+			coef[0]=1;
+			for (jj=1;jj<Ln;jj++){
+				coef[jj]^=ffMult(pCdc,coef[jj-1],aInv);
+			}
+			Ln--; // Ln must be decremented right here - do not move
+			if (pCdc->chienShortenedFlg!=0){
+				lastPos++; // One less root is missing
+			}
+		}
+		chienTblLanes(pCdc,coef,Ln,reg);
+		if (Ln==stopDeg){
+			// Position the ELP back to its starting point for special cases
+			sigmaN[0]=1;
+			for (jj=1;jj<=Ln;jj++){
+				sigmaN[jj]=0;
+				if (coef[jj]!=0){
+					sigmaN[jj]=alogTbl[(logTbl[coef[jj]]+
+						(int)(((long long)jj*(nn+CHIENTBLPOS))%nParm))%nParm];
+				}
+			}
+		}
+	}
+	// If degree of ELP has not been reduced properly
+	if (Ln!=stopDeg){
+		errFlg|=ROOTSNEQLN;
+	}
+	return (errFlg);
+}
+
+static int rootFindChienTbl(const struct BchCodec *pCdc,int sigmaN[],int Loc[],const int LnOrig)
+{
+	//****************************************************************
+	//	Function: rootFindChienTbl
+	//
+	//  Root finder for option ROOTFINDTABLE.  The special cases for
+	//  small ELP degrees are the same as in rootFindChien.  Larger
+	//  degrees use the constant multiplier table Chien search.
+	//****************************************************************
+	int errFlg;
+	const int stopDeg=elpStopDeg(pCdc);
+
+	if (LnOrig<=stopDeg){
+		errFlg=lowDegreeElp(pCdc,sigmaN,Loc,LnOrig);
+	}
+	else if (pCdc->chienTblBytes!=0){
+		errFlg=chienSearchTbl(pCdc,sigmaN,Loc,LnOrig);
+		if (errFlg==0){
+			// Divided down to degree stopDeg
+			errFlg|=lowDegreeElp(pCdc,sigmaN,Loc,stopDeg);
+		}
+	}
+	else {
+		errFlg=rootFindChien(pCdc,sigmaN,Loc,LnOrig); // Tables not built
+	}
+	return (errFlg);
+}
+
+static int ffPFastQuotient(const int mIn[],int mDegIn,const int nIn[],
+						   int nDegIn,int quotient[],
+						   const FfElem alogTbl[],const FfLog logTbl[],
+						   const int nParm)
+{
+	//****************************************************************
+	//	Function: ffPFastQuotient
+	//
+	//  Function to compute a polynomial quotient in GF(2^m).
+	//
+	//  mDeg and nDeg are degrees.
+	//
+	//****************************************************************
+	//
+	int k,logQDigit,errFlg,mDeg,nDeg;
+	int m[MAXCORR+1],n[MAXCORR+1];
+
+	errFlg=0; // Clear error flag
+
+	// Copy the input degrees and arrays so not to modify them
+	mDeg=mDegIn;
+	nDeg=nDegIn;
+	for (k=0;k<=mDeg;k++){
+		m[k]=mIn[k];
+	}
+	for (k=0;k<=nDeg;k++){
+		n[k]=nIn[k];
+	}
+	if ((mDeg==0 && m[0]==0) || (nDeg==0 && n[0]==0)) {
+		// '-----zero on entry to ffPFastQuotient-----'
+		return (QUOZROONENTRYERR); // Return error
+	}
+	while (n[nDeg]==0 && nDeg>0) {
+		nDeg=nDeg-1;
+	}
+	while (m[mDeg]==0 && mDeg>0) {
+		mDeg=mDeg-1;
+	}
+	for (k=0;k<=mDeg-nDeg;k++) {  // For q array, # coeffs one gth degree
+		quotient[k]=0; // This init loop necessary - do not remove
+	}
+	while (1) {
+		if (mDeg<nDeg) {
+			// Quotient will be returned
+			break;
+		}else{
+			// Divide high coeffs to get tmp
+			if (n[nDeg]==0){
+				return (DIVZRODIV); // Divide by zero error
+			}
+			if (m[mDeg]>0){
+				logQDigit=logTbl[m[mDeg]]-logTbl[n[nDeg]];
+				if (logQDigit<0){
+					logQDigit+=nParm;
+				}
+				quotient[mDeg-nDeg]=alogTbl[logQDigit];
+				for (k=0;k<=mDeg;k++) {
+					if ((k>=mDeg-nDeg) && (n[k-(mDeg-nDeg)]>0)) {
+						m[k]=alogTbl[logTbl[n[k-(mDeg-nDeg)]]+logQDigit]^m[k];
+					}
+				}
+			}
+			while (m[mDeg]==0 && mDeg>0) {
+				mDeg=mDeg-1;
+			}
+			if (mDeg==0 && m[0]==0) {
+				// Quotient will be returned
+				break;
+			}
+		}
+	}
+	return (0);
+}
+
+static int ffPFastMod(const int mIn[],int mDegIn,const int nIn[],
+					  int nDegIn,int remainder[],int *pRDeg,
+					  const FfElem alogTbl[],const FfLog logTbl[],
+					  const int nParm)
+{
+	//****************************************************************
+	//	Function: ffPFastMod
+	//
+	//  Function to compute a polynomial remainder in GF(2^m).
+	//  Computes the poly m modulo the poly n over GF(2^m).
+	//
+	//  mDeg and nDeg are degrees.
+	//
+	//****************************************************************
+	//
+	int k,logQDigit,errFlg,mDeg,nDeg;
+	// "+2" because input poly of deg MAXCORR is multiplied by x^2
+	int m[MAXCORR+2];
+	int n[MAXCORR+1];
+
+	errFlg=0; // Clear error flag
+	// Copy the input degrees and arrays so not to modify them
+	mDeg=mDegIn;
+	nDeg=nDegIn;
+	for (k=0;k<=mDeg;k++){
+		m[k]=mIn[k];
+	}
+	for (k=0;k<=nDeg;k++){
+		n[k]=nIn[k];
+	}
+	if ((mDeg==0 && m[0]==0) || (nDeg==0 && n[0]==0)) {
+		// '-----zero on entry to ffPFastMod-----'
+		return (MODZROONENTRYERR); // Return error
+	}
+	while (n[nDeg]==0 && nDeg>0) {
+		nDeg=nDeg-1;
+	}
+	while (m[mDeg]==0 && mDeg>0) {
+		mDeg=mDeg-1;
+	}
+	while (1) {
+		if (mDeg<nDeg) {
+			for (k=0;k<=nDeg-1;k++) {
+				if (k<=mDeg) {
+					remainder[k]=m[k];
+				}else{
+					remainder[k]=0;
+				}
+			}
+			*pRDeg=mDeg;
+			break;
+		}else{
+			// Divide high coeffs to get tmp
+			if (n[nDeg]==0){
+				return (DIVZRODIV); // Divide by zero error
+			}
+			if (m[mDeg]>0){
+				logQDigit=logTbl[m[mDeg]]-logTbl[n[nDeg]];
+				if (logQDigit<0){
+					logQDigit+=nParm;
+				}
+				for (k=0;k<=mDeg;k++) {
+					if ((k>=mDeg-nDeg) && (n[k-(mDeg-nDeg)]>0)) {
+						n[k-(mDeg-nDeg)]=
+							alogTbl[logTbl[n[k-(mDeg-nDeg)]]+logQDigit];
+						m[k]=(n[k-(mDeg-nDeg)]^m[k]); // add vectors
+					}
+				}
+			}
+			while (m[mDeg]==0 && mDeg>0) {
+				mDeg=mDeg-1;
+			}
+			if (mDeg==0 && m[0]==0) {
+				for (k=0;k<=nDeg-1;k++) {
+					remainder[k]=0;
+				}
+				*pRDeg=0;
+				break;
+			}
+		}
+	}
+	return (0);
+}
+
+static int ffPFastGcd(const int mIn[],int mDegIn,const int nIn[],
+					  int nDegIn,int gcdresult[],int *pDegOut,
+					  const FfElem alogTbl[],const FfLog logTbl[],const int nParm)
+{
+	//****************************************************************
+	//	Function: ffPFastGcd
+	//
+	//  Function to compute a polynomial greatest common divisor
+	//  in GF(2^m).  m and n are the GF(2^m) polynomials for which
+	//  the gcd is required.
+	//
+	//  mDeg and nDeg are degrees.
+	//
+	//  This function implements Euclids algorithm.  MY reference is
+	//  page 149 of the Berlekamp book.
+	//
+	//  E. Berlekamp (1968), Algebraic Coding Theory, McGraw-Hill.
+	//
+	//****************************************************************
+	//
+	int k,logQDigit,errFlg,mDeg,nDeg;
+	int m[MAXCORR+1],n[MAXCORR+1];
+
+	// Copy the input degrees and arrays so not to modify them
+	mDeg=mDegIn;
+	nDeg=nDegIn;
+	errFlg=0;
+	for (k=0;k<=mDeg;k++){
+		m[k]=mIn[k];
+	}
+	for (k=0;k<=nDeg;k++){
+		n[k]=nIn[k];
+	}
+	if ((mDeg==0 && m[0]==0) || (nDeg==0 && n[0]==0)) {
+		// '-----zero on entry to ffPFastGcd-----'
+		return (GCDZROONENTRYERR); // Return error
+	}
+	while (n[nDeg]==0 && nDeg>0) {
+		nDeg=nDeg-1;
+	}
+	while (m[mDeg]==0 && mDeg>0) {
+		mDeg=mDeg-1;
+	}
+	while (1) {
+		if (nDeg<=mDeg) {
+			// Divide high coeffs to get tmp
+			if (n[nDeg]==0){
+				return (DIVZRODIV); // Divide by zero error
+			}
+			if (m[mDeg]>0){
+				logQDigit=logTbl[m[mDeg]]-logTbl[n[nDeg]];
+				if (logQDigit<0){
+					logQDigit+=nParm;
+				}
+				for (k=0;k<=mDeg;k++) {
+					if ((k>=mDeg-nDeg) && (n[k-(mDeg-nDeg)]>0)) {
+						n[k-(mDeg-nDeg)]=
+							alogTbl[logTbl[n[k-(mDeg-nDeg)]]+logQDigit];
+						m[k]=(n[k-(mDeg-nDeg)]^m[k]); // add vectors
+					}
+				}
+			}
+			while (m[mDeg]==0 && mDeg>0) {
+				mDeg=mDeg-1;
+			}
+			if (mDeg==0 && m[0]==0) {
+				for (k=0;k<=nDeg;k++) {
+					gcdresult[k]=n[k];
+				}
+				*pDegOut=nDeg;
+				break;
+			}
+		}else{
+			// Divide high coeffs to get tmp
+			if (m[mDeg]==0){
+				return (DIVZRODIV); // Divide by zero error
+			}
+			if (n[nDeg]>0){
+				logQDigit=logTbl[n[nDeg]]-logTbl[m[mDeg]];
+				if (logQDigit<0){
+					logQDigit+=nParm;
+				}
+				for (k=0;k<=nDeg;k++) {
+					if ((k>=nDeg-mDeg) && (m[k-(nDeg-mDeg)])){
+						m[k-(nDeg-mDeg)]=alogTbl[logTbl[m[k-(nDeg-mDeg)]]+logQDigit];
+						n[k]=(m[k-(nDeg-mDeg)]^n[k]); // add vectors
+					}
+				}
+			}
+			while (n[nDeg]==0 && nDeg>0) {
+				nDeg=nDeg-1;
+			}
+			if (nDeg==0 && n[0]==0) {
+				for (k=0;k<=mDeg;k++) {
+					gcdresult[k]=m[k];
+				}
+				*pDegOut=mDeg;
+				break;
+			}
+		}
+	}
+	return (0);
+}
+
+static int BTA(const struct BchCodec *pCdc,const int sigmaN[],int Loc[],const int LnOrig)
+{
+	//****************************************************************
+	//	Function: BTA
+	//
+	//  Function that implements the Berlekamp trace method for
+	//	finding roots of finite field polynomials.  The finite
+	//  field supported by this function is GF(2^m).
+	//
+	//  My references for the BTA algorithm are a paper [4] by
+	//  Berlekamp and three papers [1,2,3] that discuss a BTA derivative
+	//  algorithm called BTZ.  In this program I implemented much of the
+	//  math from BTZ, but instead of implementing the special root
+	//  finding methods of low degree polynomials by Zinoviev, I
+	//  implemented alternative methods.  References [1-4] can be found
+	//  on the internet, but there may be a fee for some of them.
+	//
+	//  1) V. Herbert. Efficient root finding of polynomials over fields
+	//  of characteristic 2, WEWoRC 2009, INRIA Paris-Rocquencourt.
+	//  2) V. Herbert. Efficient root finding of polynomials over fields
+	//  of characteristic 2, INRIA Paris-Rocquencourt.
+	//  3) B. Biswas, V. Herbert. Efficient root finding of polynomials
+	//  over fields of characteristic 2, CRI INRIA Paris-Rocquencourt.
+	//  4) E. Berlekamp (1970), Factoring polynomials over large finite
+	//  fields, Mathematics of Computation, v. 24, 1970, pp. 713-735.
+	//
+	//  ---Overview of the Berlekamp Trace Algorithm (BTA)---. The BTA
+	//  as defined by Berlekamp, splits the polynomial to be factored
+	//  into two factors using a polynomial greatest common divisor
+	//  (gcd) function.  Each resulting factor is also split into
+	//  two factors and so on until there exist only degree one factors.
+	//  To split a polynomial the greatest common divisor function is
+	//  performed on the polynomial and a trace polynomial that has as
+	//  its roots about half the elements of the finite field employed.
+	//
+	//  It is faster to stop splitting when the degree of a factor falls
+	//  below a threshold and instead to find the roots of such factors
+	//  by even faster methods for low degree polynomials. In this
+	//  function I stop splitting at degree elpStopDeg.  That is six
+	//  when affineElp is used (affineElpDeg), which solves quintic and
+	//  sextic polynomials and, for odd “m” (“m” of GF(2^m)), cubic
+	//  and quartic ones.  Without affineElp it is degree four for even
+	//  “m” and degree two for odd “m”.  The special root finding
+	//  algorithms for linear, quadratic, cubic and quartic polynomials
+	//  are used below those degrees (see lowDegreeElp).
+	//
+	//  This function uses several techniques to achieve speed.  For
+	//  example it does not call functions to do finite field multiplies
+	//  or divides, they are done inline.  And at one point a loop is
+	//  unrolled (straight line coded).  There are still some places in
+	//  the function where speed can be increased a bit.
+	//****************************************************************
+	//
+	int errFlg,degCF,tmpLogQ,tmpN,tmpLogD;
+	int tmpVk,factorTblNxtEntryIdx,logALPHAi;
+	int skipFactorCurrIdxInc,tmp[MAXCORR+1];
+	int rootsFoundIdx,twoToKx1Pwr,specialCaseFlg;
+	int jx,kx,kx0,kx1,kx2,kx3,kx4,degA,degB,junk;
+	int TiCoeff,tmpDeg;
+	int factorTblCurrPosIdx;
+	int tmpPoly[MAXCORR+1];
+	int p[MAXCORR+1];
+	int accumResidue[MAXCORR];
+	FfElem v[MAXCORR];
+	int MDblShiftRowHasAZero[MAXCORR];
+	int MResiduesRowHasAZero[MAXMPARM];
+	int degTbl[MAXCORR],alphaTbl[MAXCORR],alphaFlgs[MAXMPARM];
+	int factorA[MAXCORR+1],factorB[MAXCORR+1],currFactor[MAXCORR+1];
+	int workTiModP[MAXCORR],roots[MAXCORR];
+	// Note +2.  Need 2 extra spaces cause poly multiplied by x^2
+	int tmpV[MAXCORR+2],tmpVBack[MAXCORR+2];
+	int MResidues[MAXMPARM][MAXCORR];
+	int MDblShift[MAXCORR][MAXCORR];
+	int TiModP[MAXCORR+1][MAXCORR+1];
+	int factorTbl[MAXCORR][MAXCORR+1];
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int nParm=pCdc->nParm;
+	const int stopDeg=elpStopDeg(pCdc);
+	const int mParm=pCdc->mParm;
+	const int LogZVal=pCdc->logZVal;
+	const int ffSize=pCdc->ffSize;
+
+	errFlg=0; // Clear error flag
+	//
+	// Flip "sigmaN" & put in "p" to make input format compatible
+	// with this function
+	for (kx=0;kx<=LnOrig;kx++){
+		tmpPoly[kx]=sigmaN[kx];
+	}
+	for (kx=0;kx<=LnOrig;kx++){
+		p[kx]=tmpPoly[LnOrig-kx];
+	}
+	// ========== CONSTRUCT THE MDblShift MATRIX ===================
+	// Using this matrix does the same thing as shifting twice a finite
+	// field polynomial shift register implementing the poly "p".  Using
+	// the matrix allows the number of multiplies to be cut in about half
+	// compared to actual shifting of a software shift register twice.
+
+	// Clear "row has a zero" flgs
+	for (kx=0;kx<=LnOrig-1;kx++) {
+		MDblShiftRowHasAZero[kx]=0;
+	}
+	// Create the matrix to be used for double shifts
+	for (kx=0;kx<=LnOrig-1;kx++) {
+		if (2*kx<LnOrig) {
+			// Initialize row to "0"s, then stuff a "1"
+			for (jx=0;jx<=LnOrig-1;jx++) {
+				MDblShift[kx][jx]=LogZVal; // RHS is log of zero
+			}
+			MDblShift[kx][2*kx]=0; // RHS is log of one
+			MDblShiftRowHasAZero[kx]=1; // Each of these rows has at least one "0"
+		}else{
+			// Next few lines - Start multiply residue poly by x^2
+			tmpV[0]=0;
+			tmpV[1]=0;
+			// Finish multiply residue poly by x^2
+			for (jx=0;jx<=LnOrig-1;jx++) {
+				if (MDblShift[kx-1][jx]==LogZVal) {
+					tmpV[jx+2]=0;
+				}else{
+					tmpV[jx+2]=alogTbl[MDblShift[kx-1][jx]];
+				}
+			}
+			// --------------
+			// Deg of residue is (LnOrig-1), "+2" is for the inserted zeros
+			tmpDeg=LnOrig+1; // This is (LnOrig-1)+2
+			errFlg |= ffPFastMod(tmpV,tmpDeg,p,LnOrig,tmpVBack,&junk,
+				alogTbl,logTbl,nParm);
+			if (errFlg>0){
+				return (errFlg);
+			}
+			for (jx=0;jx<=LnOrig-1;jx++){
+				tmpV[jx]=tmpVBack[jx];
+			}
+			for (jx=0;jx<=LnOrig-1;jx++) {
+				if (tmpV[jx]==0) {
+					MDblShiftRowHasAZero[kx]=1; // Set "has a zero" flg
+				}
+				MDblShift[kx][jx]=(tmpV[jx]!=0) ? logTbl[tmpV[jx]] : LogZVal;
+			}
+		}
+	}
+	// ========== BEGIN USING THE MDblShift MATRIX TO COMPUTE RESIDUES ====================
+	// Residues means residues of Trace(Alpha*z) mod p.
+	// Clear temp vector for first TiModP which is computed as residues
+	// are computed. This is for first TiModP only, all other TiModP
+	// vectors are computed in the factor loop.
+	for (kx=0;kx<=LnOrig-1;kx++) {
+		workTiModP[kx]=0;
+	}
+	// Clear "row has a zero" flgs
+	for (kx=0;kx<=mParm-1;kx++) {
+		MResiduesRowHasAZero[kx]=0;
+	}
+	// Initialize the "v" array
+	for (kx=0;kx<=LnOrig-1;kx++) {
+		v[kx]=0;
+	}
+	v[1]=1; // stuff a "1" in the x^1 position
+	for (kx1=0;kx1<=mParm-1;kx1++) {  // Loop thru all the residues to be computed
+		if (v[0]==0  ) {// This decision for speed
+			MResiduesRowHasAZero[kx1]=1; // Set "has a zero" flg
+			// Loop # one - faster, no need to check all entries for 0
+			for (jx=0;jx<=LnOrig-1;jx++) {  // Add an entry to residue matrix
+				workTiModP[jx]=(workTiModP[jx]^v[jx]); // Developing first TiModP
+				// RHS is in log form
+				MResidues[kx1][jx]=(v[jx]!=0) ? logTbl[v[jx]] : LogZVal;
+			}
+		}else{
+			// Loop # two - slower, must check all entries for 0
+			for (jx=0;jx<=LnOrig-1;jx++) {  // Add an entry to residue matrix
+				if (v[jx]==0) {
+					MResiduesRowHasAZero[kx1]=1; // Set "has a zero" flg
+				}
+				workTiModP[jx]=(workTiModP[jx]^v[jx]); // Developing first TiModP
+				// RHS is in log form
+				MResidues[kx1][jx]=(v[jx]!=0) ? logTbl[v[jx]] : LogZVal;
+			}
+		}
+		// NEXT LINE - THE +1 NEEDED IN BOTH MATLAB AND "C"
+		if (kx1+1<mParm ) {// This "if" just skips to end of loop on last loop pass
+			// Compute square of v().  Input and output are in antilog form.
+			// ffSquareBatch squares with GFNI when the CPU has it and there
+			// are enough coefficients, else it adds logs and fetches alogs.
+			ffSquareBatch(pCdc,v,v,LnOrig);
+			// Initialize accumResidue to all zeros
+			for (jx=0;jx<=LnOrig-1;jx++) {
+				accumResidue[jx]=0;
+			}
+			for (kx2=0;kx2<=LnOrig-1;kx2++) {
+				if (2*kx2<LnOrig) {
+					accumResidue[2*kx2]=v[kx2];
+				}else{
+					if (v[kx2]>0  ) {// If this operand is "0" then block of code is skipped
+						// Must take log of RHS and use it for the two loops
+						tmpVk=logTbl[v[kx2]];
+						if (MDblShiftRowHasAZero[kx2]==1) {
+							// In this loop "need" to test for zero
+							for (kx3=0;kx3<=LnOrig-1;kx3++) {
+								if (MDblShift[kx2][kx3]!=LogZVal) {
+									accumResidue[kx3]=
+										(accumResidue[kx3]^alogTbl[tmpVk+MDblShift[kx2][kx3]]);
+								}
+							}
+						}else{
+							// In this loop do "not" need to test for zero
+							// WARNING - Cannot change # in next line
+							// without changing the number of lines of
+							// replication in the unrolled loop which
+							// follows the else
+							if (LnOrig>14){
+								for (kx3=0;kx3<=LnOrig-1;kx3++) {
+									accumResidue[kx3]^=alogTbl[tmpVk+MDblShift[kx2][kx3]];
+								}
+							}else{
+								switch (LnOrig-1)
+								{
+								case 13:accumResidue[13]^=alogTbl[tmpVk+MDblShift[kx2][13]];
+									//lint -fallthrough
+								case 12:accumResidue[12]^=alogTbl[tmpVk+MDblShift[kx2][12]];
+									//lint -fallthrough
+								case 11:accumResidue[11]^=alogTbl[tmpVk+MDblShift[kx2][11]];
+									//lint -fallthrough
+								case 10:accumResidue[10]^=alogTbl[tmpVk+MDblShift[kx2][10]];
+									//lint -fallthrough
+								case 9:accumResidue[9]^=alogTbl[tmpVk+MDblShift[kx2][9]];
+									//lint -fallthrough
+								case 8:accumResidue[8]^=alogTbl[tmpVk+MDblShift[kx2][8]];
+									//lint -fallthrough
+								case 7:accumResidue[7]^=alogTbl[tmpVk+MDblShift[kx2][7]];
+									//lint -fallthrough
+								case 6:accumResidue[6]^=alogTbl[tmpVk+MDblShift[kx2][6]];
+									//lint -fallthrough
+								case 5:accumResidue[5]^=alogTbl[tmpVk+MDblShift[kx2][5]];
+									//lint -fallthrough
+								case 4:accumResidue[4]^=alogTbl[tmpVk+MDblShift[kx2][4]];
+									//lint -fallthrough
+								case 3:accumResidue[3]^=alogTbl[tmpVk+MDblShift[kx2][3]];
+									//lint -fallthrough
+								case 2:accumResidue[2]^=alogTbl[tmpVk+MDblShift[kx2][2]];
+									//lint -fallthrough
+								case 1:accumResidue[1]^=alogTbl[tmpVk+MDblShift[kx2][1]];
+									//lint -fallthrough
+								case 0:accumResidue[0]^=alogTbl[tmpVk+MDblShift[kx2][0]];
+									//lint -fallthrough
+								default: break;
+								}
+							}
+						}
+					}
+				}
+			} // end kx2
+			// This loop does "v=accumResidue"
+			for (kx4=0;kx4<=LnOrig-1;kx4++) {
+				v[kx4]=(FfElem)accumResidue[kx4];
+			}
+		}
+	} // end of computing all residues
+	// Place very first TiModP vector in the table
+	// All other TiModP vectors will be computed in factor loop
+	for (kx=0;kx<=LnOrig-1;kx++) {
+		TiModP[0][kx]=workTiModP[kx];
+	}
+	// ========== ONCE PER CASE INITIALIZATION =========================
+	// Initialize some arrays
+	for (jx=0;jx<=LnOrig-1;jx++) {
+		alphaTbl[jx]=0;
+		degTbl[jx]=0;
+	}
+	// Initialize flags that tell if a TiModP has already been computed
+	// The first entryTiModP vector was computed as residues were computed
+	alphaFlgs[0]=1;
+	for (jx=1;jx<=mParm-1;jx++) {
+		alphaFlgs[jx]=0;
+	}
+	degTbl[0]=LnOrig;
+	// Initialize factorTbl
+	factorTblCurrPosIdx=0; // Point to 1st entry of factor table
+	for (kx=0;kx<=LnOrig;kx++) {
+		// Initialize first row of factorTbl to input poly
+		factorTbl[0][kx]=p[kx];
+	}
+	factorTblNxtEntryIdx=1; // Init
+	rootsFoundIdx=0;  // Init
+	// ========== BEGIN PROCESSING FACTORS =============================
+	while (factorTblCurrPosIdx<factorTblNxtEntryIdx) {
+		// ---------- Once per factor initialization ---------------------
+		// Get, from the table, a factor to split
+		for (kx=0;kx<=degTbl[factorTblCurrPosIdx];kx++) { // n+1 coeffs in degree n poly
+			currFactor[kx]=factorTbl[factorTblCurrPosIdx][kx];
+		}
+		logALPHAi=alphaTbl[factorTblCurrPosIdx];
+		if (logALPHAi>=mParm) {
+			// This is an uncorrectable error - BREAK
+			return (LOGALPHAIGTHMPARM);
+		}
+		// ========== COMPUTE TiModP - JUST IN TIME, IF NEEDED ===============
+		// Note that we already computed the first entry of the TiModP table.  We
+		// did that as we were computing residues
+		if (alphaFlgs[logALPHAi]==0 ) {// If have not computed this TiModP yet
+			// Get TiModP by equiv of multiply vector times matrix
+			// Initialize array
+			for (kx0=0;kx0<=LnOrig-1;kx0++) {
+				workTiModP[kx0]=0;
+			}
+			// TiCoeff must be in log form
+			TiCoeff=logALPHAi;
+			twoToKx1Pwr=1;
+			for (kx1=0;kx1<=mParm-1;kx1++) {
+				if (twoToKx1Pwr<LnOrig) {
+					// Need to convert TiCoeff to alog form (will never be zero)
+					workTiModP[twoToKx1Pwr]=alogTbl[TiCoeff];
+				}else{
+					if (MResiduesRowHasAZero[kx1]==1) {
+						// In this loop "need" to test MResidues(,) for zero
+						// TiCoeff will never be zero - no need to test
+						for (kx2=0;kx2<=LnOrig-1;kx2++) {
+							// The symbol "TiModP" stands for (Trace(ALPHAi*z)) mod p
+							// TiCoeff and MResidues must be logs
+							// Add logs and fetch alog
+							if (MResidues[kx1][kx2]!=LogZVal) {
+								workTiModP[kx2]=
+									(workTiModP[kx2]^alogTbl[TiCoeff+MResidues[kx1][kx2]]);
+							}
+						}
+					}else{
+						// In this loop do "not" need to test MResidues(,) for zero
+						// TiCoeff will never be zero - no need to test
+						for (kx2=0;kx2<=LnOrig-1;kx2++) {
+							// The symbol "TiModP" stands for (Trace(ALPHAi*z)) mod p
+							// TiCoeff and MResidues must be logs
+							// Add logs and fetch alog
+							workTiModP[kx2]=
+								(workTiModP[kx2]^alogTbl[TiCoeff+MResidues[kx1][kx2]]);
+						}
+					}
+				}
+				for (kx2=0;kx2<=LnOrig-1;kx2++) {
+					TiModP[logALPHAi][kx2]=workTiModP[kx2];
+				}
+				// This code adds logs modulo (ffSize-1)
+				TiCoeff=TiCoeff+TiCoeff; // Add logs to square
+				if (TiCoeff>=(ffSize-1)) {
+					TiCoeff=TiCoeff-(ffSize-1);
+				}
+				twoToKx1Pwr=2*twoToKx1Pwr;
+			} // end for kx1
+			alphaFlgs[logALPHAi]=1;
+		}
+		for (kx=0;kx<=LnOrig-1;kx++) {
+			workTiModP[kx]=TiModP[logALPHAi][kx];
+		}
+		// Detect spceial case - Detect TiModP equal all zeros
+		specialCaseFlg=1;
+		for (jx=0;jx<=LnOrig-1;jx++) {
+			if (workTiModP[jx]>0) {
+				specialCaseFlg=0;
+				break;
+			}
+		}
+		// Handle special case of residues summing to all zeros
+		// ========== EITHER SPLIT CURRENT FACTOR OR PASS IT ON ==========================
+		if (specialCaseFlg==1) {
+			// ========== CANNOT SPLIT BECAUSE OF SPECIAL CASE - PASS ON CURRENT FACTOR
+			degA=degTbl[factorTblCurrPosIdx];
+			degB=0;
+			for (kx=0;kx<=degA;kx++) { // n+1 coefficients in a degree n polynomial
+				factorA[kx]=currFactor[kx];
+			}
+			factorB[0]=1;
+		}else{
+			// ========== TRY SPLITTING THE FACTOR ========================================
+			// Use gcd to split currFactor into two factors (factorA and factorB).
+			// NOTE: Since TiModP is a residue its degree in the below
+			// call is one less than the degree of the input poly to this function
+			errFlg |= ffPFastGcd(currFactor,degTbl[factorTblCurrPosIdx],
+				workTiModP,LnOrig-1,factorA,&degA,alogTbl,logTbl,nParm);
+			if (errFlg>0){
+				return (errFlg);
+			}
+			degCF=degTbl[factorTblCurrPosIdx];
+			errFlg |= ffPFastQuotient(currFactor,degCF,factorA,degA,
+				factorB,alogTbl,logTbl,nParm);
+			if (errFlg>0){
+				return (errFlg);
+			}
+			degB=degTbl[factorTblCurrPosIdx]-degA;
+		}
+		// ========== PUT factorA IN THE FACTOR TABLE IF DEGREE >stopDeg ====================
+		skipFactorCurrIdxInc=0;
+		if (degA>stopDeg) {
+			// Put factorA in curr pos of factorTbl
+			for (kx=0;kx<=degA;kx++) { // n+1 coeffs for degree n poly
+				factorTbl[factorTblCurrPosIdx][kx]=factorA[kx];
+			}
+			alphaTbl[factorTblCurrPosIdx]=logALPHAi+1;
+			degTbl[factorTblCurrPosIdx]=degA;
+			skipFactorCurrIdxInc=1;
+		}else{
+			// Flip L-R and div thru by highest coeff. -------------------
+			// Note that loop starts at "1". This because we handle
+			// hi coeff (lowest in array) seperately.
+			// Does not use ffDiv for speed.
+			if (factorA[degA]==0){
+				return (DIVZRODIV); // Divide by zero error
+			}
+			tmpLogD=logTbl[factorA[degA]];
+			for (kx=1;kx<=degA;kx++) {  // n+1 coefficients in a degree n polynomial
+				tmpN=factorA[degA-kx];
+				if ((tmpN)!=0){
+					tmpLogQ=logTbl[tmpN]-tmpLogD;
+					if (tmpLogQ<0){
+						tmpLogQ=tmpLogQ+nParm;
+					}
+					tmp[kx]=alogTbl[tmpLogQ];
+				}else{
+					tmp[kx]=0;
+				}
+			}
+			tmp[0]=1; // Force highest coefficient to "1"
+			// End flip and divide through -------------------------------
+			// Call the low degree special cases to find roots
+			if (degA>0) {
+				errFlg|=lowDegreeElp(pCdc,tmp,roots,degA);
+			}
+			if (errFlg>0){
+				return (errFlg);
+			}
+			// Put roots in Loc array
+			for (kx=0;kx<=degA-1;kx++) {
+				Loc[rootsFoundIdx]=roots[kx];
+				rootsFoundIdx=rootsFoundIdx+1;
+			}
+		}
+		// ========== PUT factorB IN THE FACTOR TABLE IF DEGREE >stopDeg ====================
+		if (degB>stopDeg) {
+			if (skipFactorCurrIdxInc==0 ) {// If curr position of factor tbl not already taken for next loop
+				// Put factorB in curr pos of factorTbl
+				for (kx=0;kx<=degB;kx++) {  // n+1 coeffs for degree n poly
+					factorTbl[factorTblCurrPosIdx][kx]=factorB[kx];
+				}
+				alphaTbl[factorTblCurrPosIdx]=logALPHAi+1;
+				degTbl[factorTblCurrPosIdx]=degB;
+				skipFactorCurrIdxInc=1;
+			}else{
+				// Put factorB in next position of factorTbl
+				for (kx=0;kx<=degB;kx++) {  // n+1 coeffs for degree n poly
+					factorTbl[factorTblNxtEntryIdx][kx]=factorB[kx];
+				}
+				alphaTbl[factorTblNxtEntryIdx]=logALPHAi+1;
+				degTbl[factorTblNxtEntryIdx]=degB;
+				factorTblNxtEntryIdx=factorTblNxtEntryIdx+1;
+			}
+		}else{
+			if (factorB[degB]==0){
+				return (DIVZRODIV); // Divide by zero error
+			}
+			tmpLogD=logTbl[factorB[degB]];
+			for (kx=1;kx<=degB;kx++) {  // n+1 coefficients in a degree n polynomial
+				tmpN=factorB[degB-kx];
+				if ((tmpN)!=0){
+					tmpLogQ=logTbl[tmpN]-tmpLogD;
+					if (tmpLogQ<0){
+						tmpLogQ=tmpLogQ+nParm;
+					}
+					tmp[kx]=alogTbl[tmpLogQ];
+				}else{
+					tmp[kx]=0;
+				}
+			}
+			tmp[0]=1; // Force lowest coefficient to "1"
+			// Call the low degree special cases to find roots
+			if (degB>0) {
+				errFlg|=lowDegreeElp(pCdc,tmp,roots,degB);
+			}
+			if (errFlg>0){
+				return (errFlg);
+			}
+			// Put roots in Loc array
+			for (kx=0;kx<=degB-1;kx++) {
+				Loc[rootsFoundIdx]=roots[kx];
+				rootsFoundIdx=rootsFoundIdx+1;
+			}
+		}
+		// This "if" decides if use curr factor tbl pos again or advance
+		if (skipFactorCurrIdxInc==0) {
+			factorTblCurrPosIdx=factorTblCurrPosIdx+1;
+		}
+		if (factorTblCurrPosIdx>LnOrig) {
+			// Uncorrectable Err - factorTblCurrPosIdx exceeds LnOrig
+			return (BTAFACTORTBLERR);
+		}
+	} // ========== END WHILE - END OF FACTORING FOR CURRENT CASE =======================
+	// Check if correct number of roots found
+	if ((errFlg==0) && (rootsFoundIdx)!=LnOrig) {
+		errFlg |= BTANUMROOTSERR;
+	}
+	if (errFlg==0){
+		for (kx1=0;kx1<=LnOrig-1;kx1++) {
+			for (kx2=kx1+1;kx2<=LnOrig-1;kx2++) {
+				if (Loc[kx1]==Loc[kx2]) {
+					return (BTAREPEATEDROOTS);
+				}
+			}
+		}
+	}
+	return (errFlg);
+}
+
+static int rootFindBTA(const struct BchCodec *pCdc,int sigmaN[],int Loc[],const int LnOrig)
+{
+	//****************************************************************
+	//	Function: rootFindBTA
+	//
+	//  NOTE: There are seperate rootFind functions for Chien and BTA.
+	//
+	//  This function is the highest level root finding function.  It calls
+	//  lower level root finding functions.  There are special functions
+	//  called for error locator polynomial (ELP) degrees 1 to elpStopDeg
+	//  (see lowDegreeElp).  If the degree of the ELP is greater than
+	//  elpStopDeg the BTA function is called.
+	//****************************************************************
+	int errFlg;
+	const int stopDeg=elpStopDeg(pCdc);
+
+	if (LnOrig<=stopDeg){
+		errFlg=lowDegreeElp(pCdc,sigmaN,Loc,LnOrig);
+	}
+	else
+	{
+		errFlg=BTA(pCdc,sigmaN,Loc,LnOrig);
+	}
+	return (errFlg);
+}
+
+static void affineGrpMaps(const struct BchCodec *pCdc,const int f[],int Ln,
+						  int grpMap[][MAXMPARM])
+{
+	//****************************************************************
+	//	Function: affineGrpMaps
+	//
+	//  Sets grpMap(i)(b) to L(i) of the element with only bit b set,
+	//  where L(i)(x)=f(5i+1)*x+f(5i+2)*x^2+f(5i+4)*x^4+f(5i+8)*x^8
+	//  is the linearized part of group i of f (see rootFindAffine).
+	//  L(i) is linear over GF(2), so L(i)(x) is the XOR of the entries
+	//  for the bits set in x.  Coefficients past degree Ln are zero.
+	//****************************************************************
+	int gx,bx,jx,pwr,val,logZ,logF;
+	const int nParm=pCdc->nParm;
+
+	for (gx=0;gx<=Ln/5;gx++){
+		for (bx=0;bx<pCdc->mParm;bx++){
+			logZ=pCdc->logTbl[1<<bx];
+			val=0;
+			for (jx=0;jx<4;jx++){
+				pwr=5*gx+(1<<jx);
+				if (pwr<=Ln && f[pwr]!=0){
+					logF=pCdc->logTbl[f[pwr]];
+					val^=pCdc->alogTbl[logF+logZ]; // f(pwr)*z^(2^jx)
+				}
+				logZ+=logZ; // Square z
+				if (logZ>=nParm){
+					logZ-=nParm;
+				}
+			}
+			grpMap[gx][bx]=val;
+		}
+	}
+}
+
+static int rootFindAffine(const struct BchCodec *pCdc,int sigmaN[],int Loc[],const int LnOrig)
+{
+	//****************************************************************
+	//	Function: rootFindAffine
+	//
+	//  Root finder for option ROOTFINDAFFINE.  Degrees up to elpStopDeg
+	//  go to lowDegreeElp.  For larger degrees the roots of
+	//  f(z)=z^Ln+sigma1*z^(Ln-1)+...+sigmaLn are found by evaluating f
+	//  at every element of the field after splitting it into linearized
+	//  (affine) polynomials, as in the papers by Fedorenko and Trifonov
+	//  on finding roots of polynomials over GF(2^m):
+	//
+	//      f(z)=f(3)*z^3+sum over i of y^i*(f(5i)+L(i)(z)),  y=z^5
+	//
+	//  with L(i) as in affineGrpMaps.  There are only Ln/5+1 groups, so
+	//  for the degrees 5 to 16 that are the common case there are two
+	//  to four multiplies per element instead of Ln for a Chien search.
+	//  L(i) is linear over GF(2).  An element is split into its low
+	//  AFFINELOWBITS bits and the rest, L(i) of every low part is put in
+	//  lowTbl(i) and L(i) of the high part is built from grpMap, so each
+	//  L(i)(z) is one XOR of the two.  Elements whose log is not a
+	//  codeword position (see chienSearchRange) are not taken as roots.
+	//
+	//  As in chienSearch f is divided down each time a root is found,
+	//  the maps are rebuilt and the search goes on from the same
+	//  element.  lowDegreeElp finds the last elpStopDeg roots.  If
+	//  chienShortenedFlg is set the search quits when the codeword
+	//  positions not yet tried are fewer than the roots still needed.
+	//****************************************************************
+	int gx,bx,jx,hi,lo,x,lx,lx3,ly,acc,val,Ln,numGrps,logF3,reg,errFlg;
+	int startPos,endPos,posLeft,lowBits,numLow,rebuildFlg,hiFlg,ex,idx,inRange;
+	int f[MAXCORR+1],hv[MAXCORR/5+1];
+	int grpMap[MAXCORR/5+1][MAXMPARM];
+	int lowTbl[MAXCORR/5+1][1<<AFFINELOWBITS];
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int nParm=pCdc->nParm;
+	const int stopDeg=elpStopDeg(pCdc);
+
+	if (LnOrig<=stopDeg){
+		return (lowDegreeElp(pCdc,sigmaN,Loc,LnOrig));
+	}
+	errFlg=0;
+	Ln=LnOrig;
+	endPos=chienSearchRange(pCdc,&startPos);
+	posLeft=endPos-startPos;
+	lowBits=(pCdc->mParm<AFFINELOWBITS) ? pCdc->mParm : AFFINELOWBITS;
+	numLow=1<<lowBits;
+	for (jx=0;jx<=Ln;jx++){
+		f[jx]=sigmaN[Ln-jx];
+	}
+	rebuildFlg=1;
+	hiFlg=1;
+	numGrps=0;
+	logF3=0;
+	for (hi=0;hi<pCdc->ffSize && Ln>stopDeg;hi+=numLow){
+		for (lo=0;lo<numLow;lo++){
+			if (lo==0 || rebuildFlg!=0){
+				hiFlg=1; // L(i) of the high part is needed
+			}
+			if (rebuildFlg!=0){
+				// Maps for the current f
+				affineGrpMaps(pCdc,f,Ln,grpMap);
+				numGrps=Ln/5+1;
+				logF3=(f[3]!=0) ? logTbl[f[3]] : pCdc->logZVal;
+				for (gx=0;gx<numGrps;gx++){
+					lowTbl[gx][0]=0;
+					for (jx=1;jx<numLow;jx++){
+						for (bx=0;((jx>>bx)&1)==0;bx++){
+						}
+						lowTbl[gx][jx]=lowTbl[gx][jx&(jx-1)]^grpMap[gx][bx];
+					}
+				}
+				rebuildFlg=0;
+			}
+			if (hiFlg!=0){
+				hiFlg=0;
+				for (gx=0;gx<numGrps;gx++){
+					hv[gx]=f[5*gx];
+					for (bx=lowBits;bx<pCdc->mParm;bx++){
+						if (((hi>>bx)&1)!=0){
+							hv[gx]^=grpMap[gx][bx];
+						}
+					}
+				}
+			}
+			// Every element is evaluated, in the codeword or not, since
+			// a branch on a random position would often be mispredicted
+			x=hi|lo;
+			lx=logTbl[x];
+			inRange=(lx>=startPos && lx<endPos) ? 1 : 0; // 0 for x=0
+			posLeft-=inRange;
+			// ly is log of y=x^5, lx3 is log of x^3 - both mod nParm
+			lx3=lx+lx;
+			if (lx3>=nParm){
+				lx3-=nParm;
+			}
+			ly=lx3+lx3;
+			if (ly>=nParm){
+				ly-=nParm;
+			}
+			ly+=lx;
+			if (ly>=nParm){
+				ly-=nParm;
+			}
+			lx3+=lx;
+			if (lx3>=nParm){
+				lx3-=nParm;
+			}
+			// Sum of y^i*(f(5i)+L(i)(x)).  The terms do not depend on each
+			// other, so they overlap in the CPU (Horner's rule would chain
+			// them).  ex is log of y^i.  A log sum past logZVal is a zero
+			// operand, so it is clamped to logZVal, where alogTbl is zero.
+			acc=hv[0]^lowTbl[0][lo];
+			ex=0;
+			for (gx=1;gx<numGrps;gx++){
+				ex+=ly;
+				if (ex>=nParm){
+					ex-=nParm;
+				}
+				val=hv[gx]^lowTbl[gx][lo];
+				idx=((val!=0) ? logTbl[val] : pCdc->logZVal)+ex;
+				idx=(idx<pCdc->logZVal) ? idx : pCdc->logZVal;
+				acc^=alogTbl[idx];
+			}
+			idx=logF3+lx3;
+			idx=(idx<pCdc->logZVal) ? idx : pCdc->logZVal;
+			acc^=alogTbl[idx];
+			if (acc==0 && inRange!=0){
+				// x is a root - divide f by (z+x), the quotient is left in f
+				Loc[Ln-1]=x;
+				reg=f[Ln];
+				for (jx=Ln-1;jx>=0;jx--){
+					val=f[jx]^ffMult(pCdc,reg,x);
+					f[jx]=reg;
+					reg=val;
+				}
+				Ln--;
+				if (Ln==stopDeg){
+					break;
+				}
+				rebuildFlg=1;
+			}
+		}
+		if (pCdc->chienShortenedFlg!=0 && posLeft<Ln-stopDeg){
+			break; // The missing roots cannot fit
+		}
+	}
+	if (Ln!=stopDeg){
+		return (AFFINEFINDERR);
+	}
+	for (jx=0;jx<=Ln;jx++){
+		sigmaN[jx]=f[Ln-jx];
+	}
+	errFlg|=lowDegreeElp(pCdc,sigmaN,Loc,Ln);
+	return (errFlg);
+}
+
+static int rootFindBatch(const struct BchCodec *pCdc,int sigmaN[],int Loc[],const int LnOrig)
+{
+	//****************************************************************
+	//	Function: rootFindBatch
+	//
+	//  Root finder for option ROOTFINDBATCH.  Degrees up to elpStopDeg
+	//  go to lowDegreeElp.  For larger degrees
+	//  f(z)=z^Ln+sigma1*z^(Ln-1)+...+sigmaLn is evaluated at the
+	//  elements alpha^p of the codeword positions p (see
+	//  chienSearchRange), BATCHEVALPTS at a time, by ffPolyEvalBatch -
+	//  Horner's rule on the GF(2^m) batch kernels, 32 points per step
+	//  with VPCLMULQDQ.  The elements are read straight from alogTbl.
+	//
+	//  As in rootFindAffine f is divided down each time a root is found.
+	//  The rest of the block was evaluated with the f before the divide,
+	//  but that f has the same roots there as the quotient, so the
+	//  block is not evaluated again.  lowDegreeElp finds the last
+	//  elpStopDeg roots.  If chienShortenedFlg is set the search quits
+	//  when the positions not yet tried are fewer than the roots still
+	//  needed.
+	//****************************************************************
+	int jx,kx,x,Ln,pos,num,startPos,endPos,reg,val,errFlg;
+	int f[MAXCORR+1];
+	FfElem y[BATCHEVALPTS];
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const int stopDeg=elpStopDeg(pCdc);
+
+	if (LnOrig<=stopDeg){
+		return (lowDegreeElp(pCdc,sigmaN,Loc,LnOrig));
+	}
+	Ln=LnOrig;
+	endPos=chienSearchRange(pCdc,&startPos);
+	for (jx=0;jx<=Ln;jx++){
+		f[jx]=sigmaN[Ln-jx];
+	}
+	for (pos=startPos;pos<endPos && Ln>stopDeg;pos+=num){
+		if (pCdc->chienShortenedFlg!=0 && endPos-pos<Ln-stopDeg){
+			break; // The missing roots cannot fit
+		}
+		num=endPos-pos;
+		if (num>BATCHEVALPTS){
+			num=BATCHEVALPTS;
+		}
+		ffPolyEvalBatch(pCdc,f,Ln,&alogTbl[pos],y,num);
+		for (kx=0;kx<num && Ln>stopDeg;kx++){
+			if (y[kx]!=0){
+				continue;
+			}
+			// x is a root - divide f by (z+x), the quotient is left in f
+			x=alogTbl[pos+kx];
+			Loc[Ln-1]=x;
+			reg=f[Ln];
+			for (jx=Ln-1;jx>=0;jx--){
+				val=f[jx]^ffMult(pCdc,reg,x);
+				f[jx]=reg;
+				reg=val;
+			}
+			Ln--;
+		}
+	}
+	if (Ln!=stopDeg){
+		return (ROOTSNEQLN);
+	}
+	for (jx=0;jx<=Ln;jx++){
+		sigmaN[jx]=f[Ln-jx];
+	}
+	errFlg=lowDegreeElp(pCdc,sigmaN,Loc,Ln);
+	return (errFlg);
+}
+
+static int fixErrors(const struct BchIoVec dataVec[],int numDataVecs,
+					 const struct BchIoVec parityVec[],int numParityVecs,
+					 struct BchScratch *pScr,const FfLog logTbl[],int Ln,int numCodewordBytes,
+					 int numDataBits, int numRedunBits,int nParm)
+{
+	//****************************************************************
+	//	Function: fixErrors
+	//
+	//	Function to do the actual correction of errors after error
+	// locations have been found by the decode function.  The errors
+	// at pScr->Loc are fixed in the data or parity segments, and the
+	// byte and bit fixed for each are left in pScr->fixByte and fixMask.
+	// All the locations are range checked before any bit is flipped, so
+	// if one is outside the codeword (in the pad bits or the shortened
+	// part of the code) nothing is changed and CORROUTSIDE is returned.
+	//****************************************************************
+	int kx,jx,bitLoc[MAXCORR],byteLoc,byteValue,byteBitNum,errFlg;
+	const int *Loc=pScr->Loc;
+	const int numDataBytes=numDataBits/8; // Data is whole bytes
+
+	errFlg=0;
+	for (kx=0;kx<Ln;kx++){
+		pScr->fixByte[kx]=0;
+		bitLoc[kx] = (((numCodewordBytes*8 - logTbl[Loc[kx]])-1)%nParm);
+		// Bounds check fwd displacement because pad bits at end.
+		// Note to Neal.
+		if (bitLoc[kx]<0 || bitLoc[kx]>=numDataBits+numRedunBits){
+			errFlg |= CORROUTSIDE;
+		}
+	}
+	if (errFlg!=0){
+		return (errFlg);
+	}
+	for (kx=0;kx<Ln;kx++){
+		byteLoc = bitLoc[kx]/8;
+		byteBitNum = 7 - (bitLoc[kx] % 8);
+		byteValue=1;
+		for (jx=byteBitNum;jx>=1;jx--){
+			byteValue *=2;
+		}
+		pScr->fixByte[kx]=(byteLoc<numDataBytes) ?
+			ioVecByte(dataVec,numDataVecs,byteLoc) :
+			ioVecByte(parityVec,numParityVecs,byteLoc-numDataBytes);
+		pScr->fixMask[kx]=(unsigned char)byteValue;
+		*pScr->fixByte[kx] ^= (unsigned char)byteValue;
+	}
+	return (errFlg);
+}
+
+static int rootFindOpt(const struct BchCodec *pCdc,int option,int sigmaN[],int Loc[],
+					   const int Ln)
+{
+	//****************************************************************
+	//	Function: rootFindOpt
+	//
+	//  Calls the root finder for option - ROOTFINDCHIEN, BTA, SIMD,
+	//  TABLE, AFFINE or BATCH.
+	//****************************************************************
+	int errFlg;
+
+	if (option==ROOTFINDBTA){
+		errFlg=rootFindBTA(pCdc,sigmaN,Loc,Ln);
+	}else if (option==ROOTFINDSIMD){
+		errFlg=rootFindChienSimd(pCdc,sigmaN,Loc,Ln);
+	}else if (option==ROOTFINDTABLE){
+		errFlg=rootFindChienTbl(pCdc,sigmaN,Loc,Ln);
+	}else if (option==ROOTFINDAFFINE){
+		errFlg=rootFindAffine(pCdc,sigmaN,Loc,Ln);
+	}else if (option==ROOTFINDBATCH){
+		errFlg=rootFindBatch(pCdc,sigmaN,Loc,Ln);
+	}else{
+		errFlg=rootFindChien(pCdc,sigmaN,Loc,Ln);
+	}
+	return (errFlg);
+}
+
+static int rootFind(const struct BchCodec *pCdc,int sigmaN[],int Loc[],const int Ln)
+{
+	//****************************************************************
+	//	Function: rootFind
+	//
+	//  Calls the root finder selected by rootFindOption.  For
+	//  ROOTFINDTUNED that is the one genRootFindTbl timed fastest
+	//  for ELP degree Ln.
+	//****************************************************************
+	int option;
+
+	option=pCdc->rootFindOption;
+	if (option==ROOTFINDTUNED){
+		option=ROOTFINDCHIEN;
+		if (Ln>=0 && Ln<=pCdc->tParm){
+			option=pCdc->rootFindTbl[Ln];
+		}
+	}
+	return (rootFindOpt(pCdc,option,sigmaN,Loc,Ln));
+}
+
+static long long timerNs()
+{
+	//****************************************************************
+	//	Function: timerNs
+	//
+	//  Returns a monotonic time in nanoseconds.
+	//****************************************************************
+	return ((long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static void genRootFindTbl(struct BchCodec *pCdc)
+{
+	//****************************************************************
+	//	Function: genRootFindTbl
+	//
+	//  Function to calibrate the root finders for option ROOTFINDTUNED.
+	//  For each ELP degree Ln from 1 to tParm, TUNEELPS ELPs with Ln
+	//  roots at random codeword positions are built and each root
+	//  finder that has its tables is timed on all of them.  The
+	//  fastest is put in rootFindTbl(Ln) and the mean times, in ns, in
+	//  rootFindTuneNs(Ln) (-1 if not timed).  A root finder that does
+	//  not find the roots is not picked.  All root finders solve the
+	//  degrees up to elpStopDeg the same way (lowDegreeElp), so only
+	//  the Chien search is timed for them.
+	//
+	//  The time this takes grows with tParm and the codeword length -
+	//  about tParm*TUNEELPS decodes with each root finder.
+	//****************************************************************
+	int Ln,ex,jx,kx,option,pos,numPos,startPos,endPos,dupFlg,missFlg,errFlg,best;
+	int sigmaN[TUNEELPS][MAXCORR+1],roots[TUNEELPS][MAXCORR];
+	int sigWork[MAXCORR+1],Loc[MAXCORR];
+	unsigned int rnd;
+	long long tStart,tSum;
+
+	if (pCdc->rootFindOption!=ROOTFINDTUNED){
+		return;
+	}
+	// Codeword positions - the pad bits are not used
+	endPos=pCdc->numCodewordBytes*8;
+	startPos=endPos-pCdc->numDataBits-pCdc->numRedunBits;
+	numPos=endPos-startPos;
+	rnd=12345;
+	for (Ln=0;Ln<=pCdc->tParm;Ln++){
+		for (option=0;option<ROOTFINDOPTIONS;option++){
+			pCdc->rootFindTuneNs[Ln][option]=-1;
+		}
+		pCdc->rootFindTbl[Ln]=ROOTFINDCHIEN;
+	}
+	for (Ln=1;Ln<=pCdc->tParm;Ln++){
+		// ELPs with Ln distinct roots alpha^pos, sigma(x)=product of (1+X*x)
+		for (ex=0;ex<TUNEELPS;ex++){
+			sigmaN[ex][0]=1;
+			for (jx=0;jx<Ln;jx++){
+				do{
+					rnd=rnd*1103515245+12345;
+					pos=startPos+(int)((rnd>>8)%(unsigned int)numPos);
+					dupFlg=0;
+					for (kx=0;kx<jx;kx++){
+						if (roots[ex][kx]==pCdc->alogTbl[pos]){
+							dupFlg=1;
+						}
+					}
+				}while (dupFlg!=0);
+				roots[ex][jx]=pCdc->alogTbl[pos];
+				sigmaN[ex][jx+1]=0;
+				for (kx=jx+1;kx>=1;kx--){
+					sigmaN[ex][kx]^=ffMult(pCdc,roots[ex][jx],sigmaN[ex][kx-1]);
+				}
+			}
+		}
+		best=-1;
+		for (option=0;option<ROOTFINDOPTIONS;option++){
+			if (option==ROOTFINDAUTO || option==ROOTFINDTUNED
+				|| (option==ROOTFINDSIMD && pCdc->chienLanes==0)
+				|| (option==ROOTFINDTABLE && pCdc->chienTblBytes==0)
+				|| (option!=ROOTFINDCHIEN && Ln<=elpStopDeg(pCdc))){
+				continue;
+			}
+			errFlg=0;
+			tSum=0;
+			for (ex=0;ex<TUNEELPS;ex++){
+				for (jx=0;jx<=Ln;jx++){
+					sigWork[jx]=sigmaN[ex][jx];
+				}
+				tStart=timerNs();
+				errFlg|=rootFindOpt(pCdc,option,sigWork,Loc,Ln);
+				tSum+=timerNs()-tStart;
+				// Every root must be found
+				for (jx=0;jx<Ln;jx++){
+					missFlg=1;
+					for (kx=0;kx<Ln;kx++){
+						if (Loc[kx]==roots[ex][jx]){
+							missFlg=0;
+						}
+					}
+					errFlg|=missFlg;
+				}
+			}
+			if (errFlg!=0){
+				continue;
+			}
+			pCdc->rootFindTuneNs[Ln][option]=(int)(tSum/TUNEELPS);
+			if (best<0 || pCdc->rootFindTuneNs[Ln][option]<pCdc->rootFindTuneNs[Ln][best]){
+				best=option;
+			}
+		}
+		if (best>=0){
+			pCdc->rootFindTbl[Ln]=best;
+		}
+	}
+}
+
+static void printRootFindTbl(const struct BchCodec *pCdc,FILE *fp)
+{
+	//****************************************************************
+	//	Function: printRootFindTbl
+	//
+	//  Writes the root finder calibration table made by genRootFindTbl
+	//  to fp - stdout to print it, or a file opened for writing.
+	//****************************************************************
+	int Ln,option;
+	static const char *names[ROOTFINDOPTIONS]={"Chien","BTA","SIMD","Table","","Affine","",
+		"Batch"};
+
+	fprintf(fp,"\nRoot finder calibration, m=%d t=%d, %d data bytes, mean ns per ELP",
+		pCdc->mParm,pCdc->tParm,pCdc->numDataBytes);
+	fprintf(fp,"\n  Ln  Picked");
+	for (option=0;option<ROOTFINDOPTIONS;option++){
+		if (option!=ROOTFINDAUTO && option!=ROOTFINDTUNED){
+			fprintf(fp,"%9s",names[option]);
+		}
+	}
+	for (Ln=1;Ln<=pCdc->tParm;Ln++){
+		fprintf(fp,"\n%4d  %-6s",Ln,names[pCdc->rootFindTbl[Ln]]);
+		for (option=0;option<ROOTFINDOPTIONS;option++){
+			if (option==ROOTFINDAUTO || option==ROOTFINDTUNED){
+				continue;
+			}
+			if (pCdc->rootFindTuneNs[Ln][option]<0){
+				fprintf(fp,"%9s","-");
+			}
+			else{
+				fprintf(fp,"%9d",pCdc->rootFindTuneNs[Ln][option]);
+			}
+		}
+	}
+	fprintf(fp,"\n");
+}
+
+static int verifyCorr(const struct BchCodec *pCdc,const int syndromes[],const int Loc[],
+					  const int Ln)
+{
+	//****************************************************************
+	//	Function: verifyCorr
+	//
+	//  Checks that flipping the bits at the Ln error locations would
+	//  leave a codeword.  The contribution Loc^k of each location is
+	//  subtracted from odd syndrome S(k), k=1,3,..,2t-1 (for a binary
+	//  code S(2k)=S(k)^2, so the even syndromes follow), and the
+	//  corrected word is a codeword if all of them are then zero.
+	//  This costs Ln*t table lookups, where computing the remainder
+	//  of the corrected word again costs a pass over the codeword.
+	//  With the VPCLMULQDQ kernel and at least VERIFYBATCHLOCS locations
+	//  the powers are kept as elements and all of them are stepped to
+	//  the next odd power by one ffMultBatch call.
+	//
+	//  Returns 0 if the syndromes are cleared, else VERIFYERR.  A zero
+	//  location (no bit of the codeword) also gives VERIFYERR.
+	//****************************************************************
+	int kx,jx,sum,logPow[MAXCORR],logStep[MAXCORR];
+	FfElem pow[MAXCORR],step[MAXCORR];
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int nParm=pCdc->nParm;
+	const int tParm=pCdc->tParm;
+
+	if (Ln<0 || Ln>tParm){
+		return(VERIFYERR);
+	}
+	for (jx=0;jx<Ln;jx++){
+		if (Loc[jx]==0){
+			return(VERIFYERR);
+		}
+		logPow[jx]=logTbl[Loc[jx]];				// log of Loc^1
+		logStep[jx]=(2*logPow[jx])%nParm;		// log of Loc^2
+	}
+	if ((pCdc->ffKernelFeatures & CPUVPCLMUL)!=0 && Ln>=VERIFYBATCHLOCS){
+		for (jx=0;jx<Ln;jx++){
+			pow[jx]=(FfElem)Loc[jx];
+			step[jx]=alogTbl[logStep[jx]];
+		}
+		for (kx=0;kx<2*tParm;kx+=2){
+			sum=syndromes[kx];
+			for (jx=0;jx<Ln;jx++){
+				sum^=pow[jx];
+			}
+			if (sum!=0){
+				return(VERIFYERR);
+			}
+			ffMultBatch(pCdc,pow,step,pow,Ln);
+		}
+		return(0);
+	}
+	for (kx=0;kx<2*tParm;kx+=2){
+		sum=syndromes[kx];
+		for (jx=0;jx<Ln;jx++){
+			sum^=alogTbl[logPow[jx]];
+			logPow[jx]+=logStep[jx];
+			if (logPow[jx]>=nParm){
+				logPow[jx]-=nParm;
+			}
+		}
+		if (sum!=0){
+			return(VERIFYERR);
+		}
+	}
+	return(0);
+}
+
+static int lowWeightDecode(const struct BchCodec *pCdc,int sigmaN[],int Loc[],
+						   const int syndromes[])
+{
+	//****************************************************************
+	//	Function: lowWeightDecode
+	//
+	//  Fast path for 1 to 3 errors.  The ELP is computed in closed form
+	//  from S1, S3 and S5 (Peterson's direct solution), for a binary
+	//  code with D=S1^3+S3 -
+	//
+	//     1 error   sigma1=S1                  (D=0)
+	//     2 errors  sigma1=S1, sigma2=D/S1
+	//     3 errors  sigma1=S1, sigma2=(S1^2*S3+S5)/D, sigma3=D+S1*sigma2
+	//
+	//  (the 3 error solution gives sigma3=0 if there are 2 errors).
+	//  The roots are found by rootFind, which calls linearElp,
+	//  quadraticElp or cubicElp for these degrees.  The guess is then
+	//  checked against all t odd syndromes by verifyCorr.  This costs
+	//  Ln*t lookups, where berMas costs about t passes of Ln multiplies
+	//  plus its branches.
+	//
+	//  Returns Ln, with sigmaN and Loc filled in, if the check passes.
+	//  Returns 0 if there is no closed form solution or if the check
+	//  fails, and bchDecode then uses berMas.  A pattern of Ln<=t errors
+	//  that matches all the syndromes is the one berMas finds, so the
+	//  result is the same either way.
+	//****************************************************************
+	int s1,s3,s5,d,Ln,kx,errFlg;
+	int sigmaTmp[MAXCORR+1];
+	const int tParm=pCdc->tParm;
+
+	errFlg=0;
+	s1=syndromes[0];
+	s3=(tParm>=2) ? syndromes[2] : 0;
+	d=ffMult(pCdc,ffMult(pCdc,s1,s1),s1)^s3;
+	sigmaN[0]=1;
+	sigmaN[1]=s1;
+	if (d==0 || tParm==1){
+		Ln=1;
+	}
+	else if (tParm==2){
+		sigmaN[2]=ffDiv(pCdc,d,s1,&errFlg);
+		Ln=2;
+	}
+	else {
+		s5=syndromes[4];
+		sigmaN[2]=ffDiv(pCdc,ffMult(pCdc,ffMult(pCdc,s1,s1),s3)^s5,d,&errFlg);
+		sigmaN[3]=d^ffMult(pCdc,s1,sigmaN[2]);
+		Ln=(sigmaN[3]==0) ? 2 : 3;
+	}
+	if (s1==0 && Ln<3){
+		return(0); // Not 1 or 2 errors
+	}
+	for (kx=0;kx<=Ln;kx++){
+		sigmaTmp[kx]=sigmaN[kx]; // The root finders may change the ELP
+	}
+	errFlg|=rootFind(pCdc,sigmaTmp,Loc,Ln);
+	if (errFlg==0){
+		errFlg=verifyCorr(pCdc,syndromes,Loc,Ln); // Check the odd syndromes
+	}
+	if (errFlg!=0){
+		return(0);
+	}
+	return(Ln);
+}
+
+static int directDecode(const struct BchCodec *pCdc,int sigmaN[],int Loc[],
+						const int syndromes[],int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: directDecode
+	//
+	//	Maps the syndromes of a t=1 or t=2 code straight to the error
+	//  locations, with no key equation and no root finder.  For t=1
+	//  the location is S1.  For t=2 with D=S1^3+S3 -
+	//
+	//     D=0       one error at S1
+	//     else      two errors at S1*y, y from directLocTbl at the
+	//               log of S3/S1^3 (see genDirectLocTbl)
+	//
+	//  That is a few log and alog lookups.  The locations are then
+	//  range checked (a location in the pad bits or the shortened part
+	//  of the code means more than t errors) and, if verifyCorrFlg is
+	//  set, checked by verifyCorr like those of the other decoders,
+	//  all before locateAndFix flips a bit.  sigmaN is filled in from
+	//  the locations for testing.  Returns Ln, or 0 with E1QUADRATIC
+	//  (S1=0), E2QUADRATIC (no roots), CORROUTSIDE or VERIFYERR in
+	//  *pErrFlg if there is no pattern of t or fewer errors.
+	//****************************************************************
+	int s1,s3,logS1,ex,Ln,kx,bitLoc;
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const FfLog *tblEntry;
+	const int nParm=pCdc->nParm;
+
+	s1=syndromes[0];
+	s3=(pCdc->tParm==2) ? syndromes[2] : 0;
+	sigmaN[0]=1;
+	sigmaN[1]=s1;
+	if (s1==0){
+		*pErrFlg|=E1QUADRATIC;
+		return(0);
+	}
+	logS1=logTbl[s1];
+	ex=(s3!=0) ? logTbl[s3]-3*logS1 : nParm;
+	while (ex<0){
+		ex+=nParm;
+	}
+	if (pCdc->tParm==1 || ex==0){
+		Loc[0]=s1;
+		Ln=1;
+	}
+	else {
+		tblEntry=&pCdc->directLocTbl[2*ex];
+		if (tblEntry[0]==FFLOGZERO){
+			*pErrFlg|=E2QUADRATIC;
+			return(0);
+		}
+		Loc[0]=alogTbl[logS1+tblEntry[0]];
+		Loc[1]=alogTbl[logS1+tblEntry[1]];
+		sigmaN[2]=ffMult(pCdc,Loc[0],Loc[1]);
+		Ln=2;
+	}
+	// Same bit address as fixErrors
+	for (kx=0;kx<Ln;kx++){
+		bitLoc=((pCdc->numCodewordBytes*8-logTbl[Loc[kx]])-1)%nParm;
+		if (bitLoc<0 || bitLoc>=pCdc->numDataBits+pCdc->numRedunBits){
+			*pErrFlg|=CORROUTSIDE;
+			return(0);
+		}
+	}
+	if (pCdc->verifyCorrFlg!=0){
+		*pErrFlg|=verifyCorr(pCdc,syndromes,Loc,Ln);
+		if (*pErrFlg!=0){
+			return(0);
+		}
+	}
+	return(Ln);
+}
+
+static int solveKeyEq(const struct BchCodec *pCdc,int sigmaN[],int Loc[],
+					  const int syndromes[],int *pRootsFound,int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: solveKeyEq
+	//
+	//	Computes the ELP from the syndromes for bchDecode and the batch
+	//  decoders.  A t<=2 code with directDecodeFlg set is decoded by
+	//  directDecode.  Else the closed form for 1 to 3 errors is tried
+	//  first.  Both find the roots too, and *pRootsFound is then Ln.
+	//  Else the ELP is computed by berMas or riBM and *pRootsFound is 0.
+	//  Returns Ln.
+	//****************************************************************
+	int Ln;
+
+	if (pCdc->directDecodeFlg!=0 && pCdc->tParm<=2){
+		Ln=directDecode(pCdc,sigmaN,Loc,syndromes,pErrFlg);
+		*pRootsFound=Ln;
+		return(Ln);
+	}
+
+	//	Try the closed form for 1 to 3 errors (it finds the roots too),
+	//	else compute coeff's of ELP using Berlekamp/Massey
+	Ln=0;
+	if (pCdc->lowWeightFlg!=0){
+		Ln=lowWeightDecode(pCdc,sigmaN,Loc,syndromes);
+	}
+	*pRootsFound=Ln;
+	if (Ln==0 && pCdc->keyEqSolver==KEYEQRIBM){
+		Ln=riBM(pCdc,sigmaN,syndromes,pErrFlg);
+	}
+	else if (Ln==0){
+		Ln=berMas(pCdc,sigmaN,syndromes,pErrFlg);
+	}
+	return(Ln);
+}
+
+static void locateAndFix(const struct BchCodec *pCdc,const struct BchIoVec dataVec[],
+						 int numDataVecs,const struct BchIoVec parityVec[],int numParityVecs,
+						 int sigmaN[],int Ln,int rootsFound,struct BchScratch *pScr,int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: locateAndFix
+	//
+	//	Last steps of bchDecode and the batch decoders.  Unless the key
+	//  equation step failed, the roots of the ELP are found (if
+	//  rootsFound is 0) and the errors are fixed in the data and parity
+	//  segments.  Errors are ORed into *pErrFlg.
+	//
+	//  If verifyCorrFlg is set, the locations are checked against the
+	//  syndromes (verifyCorr) before any bit is flipped, so a
+	//  miscorrection is reported as UNCORR and the buffer is left as
+	//  it was.  Locations from lowWeightDecode and directDecode
+	//  (rootsFound not 0) have already been checked.
+	//****************************************************************
+	int kx;
+	int *Loc=pScr->Loc;
+
+	pScr->LnOrig=Ln; // Line for testing only ####################################
+	for (kx=0;kx<=Ln && kx<=MAXCORR;kx++){
+		pScr->sigmaOrig[kx]=sigmaN[kx]; // Loop for testing only #################
+	}
+	if (*pErrFlg!=0){
+		pScr->berMasUCECntr++; // Line for testing only ##########################
+		return;
+	}
+	//	Find the roots of the ELP
+	if (rootsFound==0){
+		*pErrFlg|=rootFind(pCdc,sigmaN,Loc,Ln);
+		if (*pErrFlg==0 && pCdc->verifyCorrFlg!=0){
+			*pErrFlg|=verifyCorr(pCdc,pScr->syndromes,Loc,Ln);
+		}
+	}
+	if (*pErrFlg!=0){
+		pScr->rootFindUCECntr++; // Line for testing only ########################
+		return;
+	}
+	//	Fix the errors in the data buffer
+	*pErrFlg|=fixErrors(dataVec,numDataVecs,parityVec,numParityVecs,pScr,
+		pCdc->logTbl,Ln,pCdc->numCodewordBytes,
+		pCdc->numDataBits,pCdc->numRedunBits,pCdc->nParm);
+	if (*pErrFlg!=0){
+		pScr->fixErrorsUCECntr++; // Line for testing only #######################
+	}
+}
+
+static int bchDecodeRemainder(const struct BchCodec *pCdc,const struct BchIoVec dataVec[],
+							  int numDataVecs,const struct BchIoVec parityVec[],int numParityVecs,
+							  struct BchScratch *pScr,int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: bchDecodeRemainder
+	//
+	//	The part of bchDecodeSg after the remainder - computes the
+	//  syndromes from the non-zero remainder in pScr->remainBytes, then
+	//  the ELP and the error locations, and corrects the codeword in
+	//  the segments.  Lets a caller that has already computed the
+	//  remainder (see bchDecodeRange) decode without computing it again.
+	//  Returns CORR, or UNCORR with *pErrFlg set.
+	//****************************************************************
+	int Ln,kx,rootsFound;
+	int sigmaN[MAXCORR+1];
+	int *Loc=pScr->Loc;
+	int *syndromes=pScr->syndromes;
+
+	for (kx=0;kx<MAXCORR;kx++){
+		// Changed to "LogZVal" 9-9-10
+		Loc[kx]=pCdc->logZVal; // Set to log of zero
+	}
+	if (pCdc->syndromeTblFlg!=0){
+		computeSyndromesTbl(pCdc,syndromes,pScr->remainBytes);
+	}
+	else {
+		computeSyndromes(syndromes,pCdc->numRedunBytes,pScr->remainBytes,
+			pCdc->alogTbl,pCdc->logTbl,pCdc->nParm,pCdc->tParm);
+	}
+	Ln=solveKeyEq(pCdc,sigmaN,Loc,syndromes,&rootsFound,pErrFlg);
+	locateAndFix(pCdc,dataVec,numDataVecs,parityVec,numParityVecs,
+		sigmaN,Ln,rootsFound,pScr,pErrFlg);
+	return((*pErrFlg!=0) ? UNCORR : CORR);
+}
+
+static int bchDecodeSg(const struct BchCodec *pCdc,const struct BchIoVec dataVec[],
+					   int numDataVecs,const struct BchIoVec parityVec[],int numParityVecs,
+					   struct BchScratch *pScr,int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: bchDecodeSg
+	//
+	//	This function performs decoding by calling -
+	//  - a function to compute a remainder
+	//  - a function to compute syndromes from the remainder
+	//  - a Berlekamp-Massey function to compute an error
+	//    locator polynomial
+	//  - a root finding function to find error locations
+	//    (roots of the error locator polynomial)
+	//
+	//  There is some test code in this function.  If you plan to implement
+	//  this function then you may want to remove the test code after
+	//  testing is complete.  All such code is commented "For testing only"
+	//
+	//  The codec context is only read, so one context may be shared by
+	//  any number of threads.  Error locations, remainder bytes and
+	//  syndrome symbols are left in the caller's scratch area (one per
+	//  thread).  On entry the scratch area does not contain useful data.
+	//
+	//  The codeword is the numDataBytes bytes in the numDataVecs
+	//  segments of dataVec followed by the numRedunBytes bytes in the
+	//  segments of parityVec.  It is decoded and corrected where it
+	//  lies - nothing is gathered or scattered - and pScr->fixByte points
+	//  into the segments at the bytes that were corrected.  If the
+	//  segment lengths do not add up, IOVECLENERR is set in *pErrFlg
+	//  and UNCORR returned.
+	//****************************************************************
+	int status,remainderDetdErr,kx;
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int FFSize=pCdc->ffSize;
+	const int tParm=pCdc->tParm;
+	int *Loc=pScr->Loc;
+	int *remainBytes=pScr->remainBytes;
+	int *syndromes=pScr->syndromes;
+
+	*pErrFlg=0;
+	status=0;
+	//	Tests three entries of the decode tables to determine
+	//	if they have been initialized.
+	for (kx=2;kx<=4;kx++){
+		if (logTbl[alogTbl[FFSize-kx]] != FFSize-kx){
+			*pErrFlg|=TBLNOTINIT;
+			return(UNCORR); // Return tables not initialized status
+		}
+	}
+	*pErrFlg|=ioVecLenErr(dataVec,numDataVecs,pCdc->numDataBytes) |
+		ioVecLenErr(parityVec,numParityVecs,pCdc->numRedunBytes);
+	if (*pErrFlg!=0){
+		return(UNCORR);
+	}
+	for(;;){ // Infinite loop - Exit is by "break"
+		remainderDetdErr=computeRemainder(pCdc,dataVec,numDataVecs,parityVec,
+			numParityVecs,remainBytes);
+		// If remainderDetdErr not 0, CW is not err free - could be corr or uncorr
+		if (remainderDetdErr!=0){
+			// GET HERE IF REMAINDER INDICATES AN ERROR (NON-ZERO REMAINDER)
+			status=bchDecodeRemainder(pCdc,dataVec,numDataVecs,parityVec,
+				numParityVecs,pScr,pErrFlg);
+		}
+		else {
+			for (kx=0;kx<MAXCORR;kx++){
+				Loc[kx]=pCdc->logZVal; // Loop for testing only #########################
+			}
+			for (kx=0;kx<2*tParm;kx++){
+				syndromes[kx]=0; // Loop for testing only #########################
+			}
+		}
+		break;
+	}
+	if (*pErrFlg!=0){
+		status=UNCORR;
+	}
+	// Status 0, CORR, or UNCORR (for UNCORR, *pErrFlg further defines FOR TESTING)
+	return(status);
+}
+
+static int bchDecodeSpan(const struct BchCodec *pCdc,unsigned char data[],
+						 unsigned char parity[],struct BchScratch *pScr,int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: bchDecodeSpan
+	//
+	//	Decodes and corrects in place the codeword made of the
+	//  numDataBytes bytes at data and the numRedunBytes bytes at parity
+	//  (see bchDecodeSg).  The spans need not be contiguous.
+	//****************************************************************
+	struct BchIoVec dataVec,parityVec;
+
+	dataVec.base=data;
+	dataVec.len=pCdc->numDataBytes;
+	parityVec.base=parity;
+	parityVec.len=pCdc->numRedunBytes;
+	return(bchDecodeSg(pCdc,&dataVec,1,&parityVec,1,pScr,pErrFlg));
+}
+
+static int bchDecode(const struct BchCodec *pCdc,unsigned char codeword[],
+					 struct BchScratch *pScr,int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: bchDecode
+	//
+	//	Decodes a codeword in byte format - numDataBytes data bytes
+	//  followed by the numRedunBytes redundancy bytes (see bchDecodeSpan).
+	//****************************************************************
+	return(bchDecodeSpan(pCdc,codeword,codeword+pCdc->numDataBytes,pScr,pErrFlg));
+}
+
+static int elpSplits(const struct BchCodec *pCdc,const int sigmaN[],int Ln)
+{
+	//****************************************************************
+	//	Function: elpSplits
+	//
+	//  Returns 1 if the ELP has Ln distinct roots in GF(2^m), else 0.
+	//  sigma(x) has Ln distinct roots in the field exactly when it
+	//  divides x^(2^m)-x, that is when x squared m times modulo
+	//  sigma(x) is x again.  That costs m*Ln^2 multiplies, where a
+	//  Chien search costs Ln multiplies per codeword bit, so a pattern
+	//  bchDecodeChase cannot correct is usually rejected here without
+	//  a root finder.  (A root may still fall outside the codeword.)
+	//****************************************************************
+	int jx,dx,sx,logQ,logSig[MAXCORR+1],rem[2*MAXCORR];
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int nParm=pCdc->nParm;
+
+	if (Ln<2){
+		return(1);
+	}
+	if (sigmaN[Ln]==0 || sigmaN[0]==0){
+		return(0);
+	}
+	for (jx=0;jx<=Ln;jx++){
+		logSig[jx]=(sigmaN[jx]!=0) ? logTbl[sigmaN[jx]] : -1;
+	}
+	for (jx=0;jx<Ln;jx++){
+		rem[jx]=(jx==1) ? 1 : 0; // x mod sigma(x)
+	}
+	for (sx=0;sx<pCdc->mParm;sx++){
+		// Square - the coefficients are squared and spread out
+		for (jx=Ln-1;jx>=0;jx--){
+			rem[2*jx]=(rem[jx]!=0) ? alogTbl[2*logTbl[rem[jx]]] : 0;
+			rem[2*jx+1]=0;
+		}
+		// Reduce modulo sigma(x) from the top down
+		for (dx=2*Ln-2;dx>=Ln;dx--){
+			if (rem[dx]!=0){
+				logQ=logTbl[rem[dx]]-logSig[Ln];
+				if (logQ<0){
+					logQ+=nParm;
+				}
+				for (jx=0;jx<Ln;jx++){
+					if (logSig[jx]>=0){
+						rem[dx-Ln+jx]^=alogTbl[logQ+logSig[jx]];
+					}
+				}
+				rem[dx]=0;
+			}
+		}
+	}
+	for (jx=0;jx<Ln;jx++){
+		if (rem[jx]!=((jx==1) ? 1 : 0)){
+			return(0);
+		}
+	}
+	return(1);
+}
+
+static int chaseOptimal(const int selBit[],const int selRel[],int numSel,
+						const int diffBit[],int numDiff,int cost,int tParm)
+{
+	//****************************************************************
+	//	Function: chaseOptimal
+	//
+	//  Returns 1 if no codeword is closer to the bits as read than the
+	//  one that differs from them in the numDiff bits diffBit[] at
+	//  total reliability cost.  Any other codeword differs from that
+	//  one in at least 2t+1 bits, so from the bits as read in at least
+	//  2t+1-numDiff bits not in diffBit[].  If the least reliable such
+	//  bits (from the numSel least reliable bits, selBit[] and
+	//  selRel[] sorted by reliability) add up to cost or more, the
+	//  search of bchDecodeChase can stop.
+	//****************************************************************
+	int sx,jx,need,sum;
+
+	need=2*tParm+1-numDiff;
+	sum=0;
+	for (sx=0;sx<numSel && need>0;sx++){
+		for (jx=0;jx<numDiff && diffBit[jx]!=selBit[sx];jx++){
+		}
+		if (jx==numDiff){
+			sum+=selRel[sx];
+			need--;
+		}
+	}
+	return((need<=0 && sum>=cost) ? 1 : 0);
+}
+
+static int bchDecodeChase(const struct BchCodec *pCdc,unsigned char codeword[],
+						  const unsigned char reliab[],int numFlipBits,
+						  struct BchScratch *pScr,int *pErrFlg)
+{
+	//****************************************************************
+	//	Function: bchDecodeChase
+	//
+	//	Chase-II soft decision decode of a codeword in byte format.
+	//  reliab[q] is the reliability of codeword bit q (bit 7-q%8 of
+	//  byte q/8, q<numDataBits+numRedunBits), 0 least reliable, for
+	//  example the magnitude of the bit's log likelihood ratio.  The
+	//  numFlipBits (at most MAXCHASEBITS) least reliable bits are found
+	//  and each of the 2^numFlipBits patterns of them is flipped and
+	//  hard decoded.  Of the patterns that decode, the one whose flips
+	//  and corrections have the smallest total reliability is kept and
+	//  applied to the codeword.  With numFlipBits 0 this is bchDecode.
+	//
+	//  The remainder is computed once.  A flipped bit at exponent e
+	//  adds alpha^(e*k) to odd syndrome S(k), so the patterns are
+	//  stepped through in Gray code order, one bit flipped per step,
+	//  and the t odd syndromes are updated with XORs from a table made
+	//  for the flip bits.  The key equation is only solved for a
+	//  pattern whose syndromes are not zero and whose flips alone have
+	//  less total reliability than the best pattern so far, and the
+	//  roots are only found if the ELP splits (elpSplits) and the flips
+	//  plus Ln corrections of bits at least as reliable as any bit left
+	//  out of the flips can still beat the best pattern.  The other
+	//  patterns cannot change the outcome - a word reached by a
+	//  correction that undoes a flip is also reached, at the same
+	//  total, by the pattern without that flip.  The search stops as
+	//  soon as the best word is known to be the closest (chaseOptimal).
+	//
+	//  Returns ERRFREE, CORR or UNCORR as bchDecode.  For UNCORR no
+	//  pattern decoded and the codeword is unchanged.  The scratch area
+	//  holds the syndromes of the codeword as read and the corrections
+	//  of the chosen pattern (not its flips).
+	//****************************************************************
+	int kx,jx,px,ix,q,Ln,rootsFound,errFlg,x,evenSNum,numBits,numFlips,numSel;
+	int pattern,step,flipCost,cost,bestCost,bestPattern,bestLn,hardErrFlg,relFloor;
+	int numDiff,bitLoc[MAXCORR],diffBit[MAXCHASEBITS+MAXCORR];
+	int selBit[MAXCHASEBITS+2*MAXCORR+1],selRel[MAXCHASEBITS+2*MAXCORR+1];
+	int flipSyn[MAXCHASEBITS][MAXCORR],oddSyn[MAXCORR],logFlip;
+	int syn[MAXNUMSYN],sigmaN[MAXCORR+1],Loc[MAXCORR],bestLoc[MAXCORR];
+	struct BchIoVec cwVec[2];
+	const FfElem *alogTbl=pCdc->alogTbl;
+	const FfLog *logTbl=pCdc->logTbl;
+	const int tParm=pCdc->tParm;
+	const int nParm=pCdc->nParm;
+	const int numStreamBits=pCdc->numCodewordBytes*8;
+
+	*pErrFlg=0;
+	cwVec[0].base=codeword;
+	cwVec[0].len=pCdc->numDataBytes;
+	cwVec[1].base=codeword+pCdc->numDataBytes;
+	cwVec[1].len=pCdc->numRedunBytes;
+	numBits=pCdc->numDataBits+pCdc->numRedunBits;
+	for (kx=0;kx<MAXCORR;kx++){
+		pScr->Loc[kx]=pCdc->logZVal;
+	}
+	if (computeRemainder(pCdc,&cwVec[0],1,&cwVec[1],1,pScr->remainBytes)==0){
+		for (kx=0;kx<2*tParm;kx++){
+			pScr->syndromes[kx]=0; // Loop for testing only #########################
+		}
+		return(ERRFREE);
+	}
+	if (pCdc->syndromeTblFlg!=0){
+		computeSyndromesTbl(pCdc,pScr->syndromes,pScr->remainBytes);
+	}
+	else {
+		computeSyndromes(pScr->syndromes,pCdc->numRedunBytes,pScr->remainBytes,
+			alogTbl,logTbl,nParm,tParm);
+	}
+	// Find the least reliable bits, kept sorted by reliability.  The
+	// first numFlips are flipped, the rest are for the bounds.
+	if (numFlipBits>MAXCHASEBITS){
+		numFlipBits=MAXCHASEBITS;
+	}
+	if (numFlipBits<0){
+		numFlipBits=0;
+	}
+	numSel=0;
+	for (q=0;q<numBits;q++){
+		if (numSel==numFlipBits+2*tParm+1 && reliab[q]>=selRel[numSel-1]){
+			continue;
+		}
+		px=(numSel<numFlipBits+2*tParm+1) ? numSel++ : numSel-1;
+		while (px>0 && selRel[px-1]>reliab[q]){
+			selBit[px]=selBit[px-1];
+			selRel[px]=selRel[px-1];
+			px--;
+		}
+		selBit[px]=q;
+		selRel[px]=reliab[q];
+	}
+	numFlips=(numSel<numFlipBits) ? numSel : numFlipBits;
+	relFloor=(numSel>numFlips) ? selRel[numFlips] : 0;
+	// Odd syndrome contributions of the flip bits - same exponent as
+	// fixErrors uses for a location
+	for (px=0;px<numFlips;px++){
+		logFlip=(numStreamBits-1-selBit[px])%nParm;
+		ix=logFlip;
+		for (kx=0;kx<tParm;kx++){
+			flipSyn[px][kx]=alogTbl[ix];
+			ix+=2*logFlip;
+			ix%=nParm;
+		}
+	}
+	for (kx=0;kx<tParm;kx++){
+		oddSyn[kx]=pScr->syndromes[2*kx];
+	}
+	hardErrFlg=0;
+	bestCost=0;
+	bestPattern=-1; // None decoded yet
+	bestLn=0;
+	pattern=0;
+	flipCost=0;
+	for (step=0;step<(1<<numFlips);step++){
+		if (step!=0){
+			// Gray code - flip bit px, the lowest set bit of step
+			for (px=0;((step>>px)&1)==0;px++){
+			}
+			pattern^=1<<px;
+			flipCost+=((pattern>>px)&1) ? selRel[px] : -selRel[px];
+			for (kx=0;kx<tParm;kx++){
+				oddSyn[kx]^=flipSyn[px][kx];
+			}
+		}
+		if (bestPattern>=0 && flipCost>=bestCost){
+			continue; // Cannot beat the best pattern
+		}
+		x=0;
+		for (kx=0;kx<tParm;kx++){
+			x|=oddSyn[kx];
+		}
+		Ln=0;
+		errFlg=0;
+		if (x!=0){
+			for (kx=0;kx<tParm;kx++){
+				syn[2*kx]=oddSyn[kx];
+			}
+			// Compute even Syndromes from the odd Syndromes
+			for (kx=0;kx<2*tParm;kx+=2){
+				x=syn[kx];
+				evenSNum=(2*(kx+1));
+				while (evenSNum<=2*tParm){
+					// Square "x"
+					if (x>0){
+						x=alogTbl[2*logTbl[x]];
+					}
+					syn[evenSNum-1]=x;
+					evenSNum*=2;
+				}
+			}
+			Ln=solveKeyEq(pCdc,sigmaN,Loc,syn,&rootsFound,&errFlg);
+			if (errFlg==0 && rootsFound==0){
+				if (bestPattern>=0 && flipCost+Ln*relFloor>=bestCost){
+					continue; // Cannot beat the best pattern
+				}
+				if (elpSplits(pCdc,sigmaN,Ln)==0){
+					errFlg|=ROOTSNEQLN;
+				}
+				else {
+					errFlg|=rootFind(pCdc,sigmaN,Loc,Ln);
+				}
+				if (errFlg==0 && pCdc->verifyCorrFlg!=0){
+					errFlg|=verifyCorr(pCdc,syn,Loc,Ln);
+				}
+			}
+		}
+		// Total reliability of the flips and the corrections (a
+		// correction of a flipped bit undoes the flip)
+		cost=flipCost;
+		for (jx=0;jx<Ln && errFlg==0;jx++){
+			bitLoc[jx]=(numStreamBits-logTbl[Loc[jx]]-1)%nParm;
+			if (bitLoc[jx]<0 || bitLoc[jx]>=numBits){
+				errFlg|=CORROUTSIDE;
+			}
+			else {
+				for (px=0;px<numFlips && selBit[px]!=bitLoc[jx];px++){
+				}
+				cost+=(px<numFlips && ((pattern>>px)&1)) ? -reliab[bitLoc[jx]] :
+					reliab[bitLoc[jx]];
+			}
+		}
+		if (errFlg!=0){
+			hardErrFlg|=(step==0) ? errFlg : 0;
+			continue;
+		}
+		if (bestPattern<0 || cost<bestCost){
+			bestCost=cost;
+			bestPattern=pattern;
+			bestLn=Ln;
+			for (jx=0;jx<Ln;jx++){
+				bestLoc[jx]=Loc[jx];
+			}
+			// The bits the word differs in - flips not undone and
+			// corrections of bits not flipped
+			numDiff=0;
+			for (px=0;px<numFlips;px++){
+				for (jx=0;jx<Ln && bitLoc[jx]!=selBit[px];jx++){
+				}
+				if (((pattern>>px)&1) && jx==Ln){
+					diffBit[numDiff++]=selBit[px];
+				}
+			}
+			for (jx=0;jx<Ln;jx++){
+				for (px=0;px<numFlips && selBit[px]!=bitLoc[jx];px++){
+				}
+				if (px==numFlips || ((pattern>>px)&1)==0){
+					diffBit[numDiff++]=bitLoc[jx];
+				}
+			}
+			if (chaseOptimal(selBit,selRel,numSel,diffBit,numDiff,cost,tParm)!=0){
+				break;
+			}
+		}
+	}
+	if (bestPattern<0){
+		*pErrFlg|=hardErrFlg; // No pattern decoded - the hard decision errors
+		return(UNCORR);
+	}
+	// Apply the flips and the corrections of the best pattern
+	for (px=0;px<numFlips;px++){
+		if ((bestPattern>>px)&1){
+			codeword[selBit[px]/8]^=(unsigned char)(0x80>>(selBit[px]%8));
+		}
+	}
+	for (jx=0;jx<bestLn;jx++){
+		pScr->Loc[jx]=bestLoc[jx];
+	}
+	pScr->LnOrig=bestLn; // Line for testing only ####################################
+	*pErrFlg|=fixErrors(&cwVec[0],1,&cwVec[1],1,pScr,logTbl,bestLn,
+		pCdc->numCodewordBytes,pCdc->numDataBits,pCdc->numRedunBits,nParm);
+	return((*pErrFlg!=0) ? UNCORR : CORR);
+}
+
+static void bsTranspose(const struct BchCodec *pCdc,const unsigned char pCWs[],
+						int numCWs,int firstByte,unsigned long long rows[])
+{
+	//****************************************************************
+	//	Function: bsTranspose
+	//
+	//	Transposes up to bitSliceWords*64 codewords, stored back to back
+	//  in byte format, to bit-sliced rows.  Row q holds codeword bit q
+	//  (bit 7-(q%8) of byte q/8) - bit l of word w of the row is the
+	//  bit of codeword 64*w+l.  Lanes past numCWs are zero codewords.
+	//  Only the byte columns from firstByte on are done.
+	//  Eight codewords at a time, a byte of each is gathered into a
+	//  64 bit word and the 8x8 bit matrix is transposed with three
+	//  swap steps (Hacker's Delight, Warren, section 7-3).
+	//****************************************************************
+	int bx,wx,gx,lx,sx,lane;
+	unsigned long long x,tt,row8[8];
+	const int numCodewordBytes=pCdc->numCodewordBytes;
+	const int W=pCdc->bitSliceWords;
+
+	for (bx=firstByte;bx<numCodewordBytes;bx++){
+		for (wx=0;wx<W;wx++){
+			for (sx=0;sx<8;sx++){
+				row8[sx]=0;
+			}
+			for (gx=0;gx<8;gx++){
+				lane=64*wx+8*gx;
+				x=0;
+				for (lx=0;lx<8 && lane+lx<numCWs;lx++){
+					x|=(unsigned long long)pCWs[(size_t)(lane+lx)*numCodewordBytes+bx] << (8*lx);
+				}
+				tt=(x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+				x^=tt ^ (tt << 7);
+				tt=(x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+				x^=tt ^ (tt << 14);
+				tt=(x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+				x^=tt ^ (tt << 28);
+				// Byte j of x is now bit j of the 8 codeword bytes
+				for (sx=0;sx<8;sx++){
+					row8[sx]|=((x >> (8*(7-sx))) & 0xff) << (8*gx);
+				}
+			}
+			for (sx=0;sx<8;sx++){
+				rows[(size_t)(8*bx+sx)*W+wx]=row8[sx];
+			}
+		}
+	}
+}
+
+#if BCHX86SIMD
+TARGETAVX2 static int bsTransposeAvx2(const struct BchCodec *pCdc,const unsigned char pCWs[],
+									  unsigned long long rows[])
+{
+	//****************************************************************
+	//	Function: bsTransposeAvx2
+	//
+	//	Same as bsTranspose for a full pass of bitSliceWords*64
+	//  codewords, 8 byte columns at a time.  One gather loads 8 bytes
+	//  of 4 codewords, and 8 gathers are a 32 codeword by 8 byte
+	//  block.  PSHUFB and three rounds of unpacks (a transpose of 16
+	//  bit units) turn the block around, so that register j holds byte
+	//  j of the 32 codewords in order.  Then PMOVMSKB takes bit 7 of
+	//  the 32 bytes, and adding the register to itself moves the next
+	//  bit to the top.  Returns the number of byte columns done - the
+	//  last numCodewordBytes%8 columns are left to bsTranspose.
+	//****************************************************************
+	int bx,wx,hx,px,jx,sx;
+	long long lane;
+	unsigned long long lowBits;
+	__m256i gatherIdx[2][8],blk[8],tmp[8],col[2][8];
+	const int numCodewordBytes=pCdc->numCodewordBytes;
+	const int W=pCdc->bitSliceWords;
+	const __m256i interleave=_mm256_setr_epi8(0,8,1,9,2,10,3,11,4,12,5,13,6,14,7,15,
+		0,8,1,9,2,10,3,11,4,12,5,13,6,14,7,15);
+
+	for (wx=0;wx<W;wx++){
+		// Gather px of half hx loads codewords 2p, 2p+1, 2p+16 and 2p+17
+		// of the 32, so that the unpacks leave them in order
+		for (hx=0;hx<2;hx++){
+			for (px=0;px<8;px++){
+				lane=64*wx+32*hx+2*px;
+				gatherIdx[hx][px]=_mm256_setr_epi64x(lane*numCodewordBytes,
+					(lane+1)*numCodewordBytes,(lane+16)*numCodewordBytes,
+					(lane+17)*numCodewordBytes);
+			}
+		}
+		for (bx=0;bx+8<=numCodewordBytes;bx+=8){
+			for (hx=0;hx<2;hx++){
+				for (px=0;px<8;px++){
+					blk[px]=_mm256_i64gather_epi64((const long long *)(pCWs+bx),
+						gatherIdx[hx][px],1);
+					// Each 128 bit half - byte j of its 2 codewords side by side
+					blk[px]=_mm256_shuffle_epi8(blk[px],interleave);
+				}
+				for (px=0;px<8;px+=2){
+					tmp[px]=_mm256_unpacklo_epi16(blk[px],blk[px+1]);
+					tmp[px+1]=_mm256_unpackhi_epi16(blk[px],blk[px+1]);
+				}
+				for (px=0;px<8;px+=4){
+					blk[px]=_mm256_unpacklo_epi32(tmp[px],tmp[px+2]);
+					blk[px+1]=_mm256_unpackhi_epi32(tmp[px],tmp[px+2]);
+					blk[px+2]=_mm256_unpacklo_epi32(tmp[px+1],tmp[px+3]);
+					blk[px+3]=_mm256_unpackhi_epi32(tmp[px+1],tmp[px+3]);
+				}
+				for (px=0;px<4;px++){
+					col[hx][2*px]=_mm256_unpacklo_epi64(blk[px],blk[px+4]);
+					col[hx][2*px+1]=_mm256_unpackhi_epi64(blk[px],blk[px+4]);
+				}
+			}
+			for (jx=0;jx<8;jx++){
+				for (sx=0;sx<8;sx++){
+					lowBits=(unsigned int)_mm256_movemask_epi8(col[0][jx]);
+					rows[(size_t)(8*(bx+jx)+sx)*W+wx]=lowBits
+						| ((unsigned long long)(unsigned int)_mm256_movemask_epi8(col[1][jx]) << 32);
+					col[0][jx]=_mm256_add_epi8(col[0][jx],col[0][jx]);
+					col[1][jx]=_mm256_add_epi8(col[1][jx],col[1][jx]);
+				}
+			}
+		}
+	}
+	return(numCodewordBytes-numCodewordBytes%8);
+}
+#endif
+
+static void bsFold(const struct BchCodec *pCdc,const unsigned long long rows[],
+				   unsigned long long fold[],int foldLen,int foldTap)
+{
+	//****************************************************************
+	//	Function: bsFold
+	//
+	//	Reduces the bit-sliced codewords in rows modulo
+	//  x^foldLen+x^foldTap+1 (x^foldLen+1 if foldTap is 0).  Row q is
+	//  the coefficient of x^(numRows-1-q), so long division adds each
+	//  leading row (q<numRows-foldLen) to the rows foldLen and
+	//  foldLen-foldTap after it.  Turned around, a row is final once
+	//  the leading rows foldLen and foldLen-foldTap before it are
+	//  added, so the rows are reduced in one pass into fold, a ring of
+	//  bsFoldRows rows (rows only go foldLen back).  The remainder is
+	//  left in the last foldLen rows of the ring.
+	//****************************************************************
+	int qx,wx,tapStart,tapEnd;
+	unsigned long long val;
+	const int W=pCdc->bitSliceWords;
+	const int numRows=pCdc->numCodewordBytes*8;
+	const int ringMask=pCdc->bsFoldRows-1;
+
+	tapStart=(foldTap!=0) ? foldLen-foldTap : numRows;
+	tapEnd=numRows-foldTap;
+	for (qx=0;qx<numRows;qx++){
+		for (wx=0;wx<W;wx++){
+			val=rows[(size_t)qx*W+wx];
+			if (qx>=foldLen){
+				val^=fold[((qx-foldLen) & ringMask)*W+wx];
+			}
+			if (qx>=tapStart && qx<tapEnd){
+				val^=fold[((qx-tapStart) & ringMask)*W+wx];
+			}
+			fold[(qx & ringMask)*W+wx]=val;
+		}
+	}
+}
+
+#if BCHX86SIMD
+TARGETAVX2 static void bsFoldAvx2(const struct BchCodec *pCdc,const unsigned long long rows[],
+								  unsigned long long fold[],int foldLen,int foldTap)
+{
+	//****************************************************************
+	//	Function: bsFoldAvx2
+	//
+	//	Same as bsFold for rows of 4 words (256 codewords), one AVX2
+	//  register per row.
+	//****************************************************************
+	int qx,tapStart,tapEnd;
+	__m256i val;
+	__m256i *pFold=(__m256i *)fold;
+	const __m256i *pRows=(const __m256i *)rows;
+	const int numRows=pCdc->numCodewordBytes*8;
+	const int ringMask=pCdc->bsFoldRows-1;
+
+	tapStart=(foldTap!=0) ? foldLen-foldTap : numRows;
+	tapEnd=numRows-foldTap;
+	for (qx=0;qx<numRows;qx++){
+		val=_mm256_loadu_si256(pRows+qx);
+		if (qx>=foldLen){
+			val=_mm256_xor_si256(val,_mm256_loadu_si256(pFold+((qx-foldLen) & ringMask)));
+		}
+		if (qx>=tapStart && qx<tapEnd){
+			val=_mm256_xor_si256(val,_mm256_loadu_si256(pFold+((qx-tapStart) & ringMask)));
+		}
+		_mm256_storeu_si256(pFold+(qx & ringMask),val);
+	}
+}
+
+TARGETAVX512 static void bsFoldAvx512(const struct BchCodec *pCdc,const unsigned long long rows[],
+									  unsigned long long fold[],int foldLen,int foldTap)
+{
+	//****************************************************************
+	//	Function: bsFoldAvx512
+	//
+	//	Same as bsFold for rows of 8 words (512 codewords), one AVX-512
+	//  register per row.
+	//****************************************************************
+	int qx,tapStart,tapEnd;
+	__m512i val;
+	const int numRows=pCdc->numCodewordBytes*8;
+	const int ringMask=pCdc->bsFoldRows-1;
+
+	tapStart=(foldTap!=0) ? foldLen-foldTap : numRows;
+	tapEnd=numRows-foldTap;
+	for (qx=0;qx<numRows;qx++){
+		val=_mm512_loadu_si512(rows+8*(size_t)qx);
+		if (qx>=foldLen){
+			val=_mm512_xor_si512(val,_mm512_loadu_si512(fold+8*((qx-foldLen) & ringMask)));
+		}
+		if (qx>=tapStart && qx<tapEnd){
+			val=_mm512_xor_si512(val,_mm512_loadu_si512(fold+8*((qx-tapStart) & ringMask)));
+		}
+		_mm512_storeu_si512(fold+8*(qx & ringMask),val);
+	}
+}
+#endif
+
+static void bsOddSyndrome(const struct BchCodec *pCdc,const unsigned long long fold[],
+						  int kx,unsigned long long syn[][MAXMPARM][MAXBITSLICEWORDS])
+{
+	//****************************************************************
+	//	Function: bsOddSyndrome
+	//
+	//	Computes bit-sliced syndrome 2*kx+1 of every lane from the
+	//  remainder bsFold left in its ring.  Remainder coefficient p adds
+	//  alpha^(p*(2*kx+1)) in each lane where it is set - an XOR network
+	//  of AND masks, with no branches on the data.  syn[2*kx][b] is bit
+	//  b of the syndrome, a row of bitSliceWords words.
+	//****************************************************************
+	int px,wx,bx,logVal,remLen,val;
+	unsigned long long coef,mask[MAXMPARM];
+	const int W=pCdc->bitSliceWords;
+	const int mParm=pCdc->mParm;
+	const int nParm=pCdc->nParm;
+	const int numRows=pCdc->numCodewordBytes*8;
+	const int jVal=2*kx+1;
+
+	for (bx=0;bx<mParm;bx++){
+		for (wx=0;wx<W;wx++){
+			syn[2*kx][bx][wx]=0;
+		}
+	}
+	remLen=(pCdc->bsFoldLen[kx]<numRows) ? pCdc->bsFoldLen[kx] : numRows;
+	logVal=0;
+	for (px=0;px<remLen;px++){
+		val=pCdc->alogTbl[logVal];
+		for (bx=0;bx<mParm;bx++){
+			mask[bx]=0-(unsigned long long)((val >> bx) & 1);
+		}
+		for (wx=0;wx<W;wx++){
+			coef=fold[((numRows-1-px) & (pCdc->bsFoldRows-1))*W+wx];
+			for (bx=0;bx<mParm;bx++){
+				syn[2*kx][bx][wx]^=coef & mask[bx];
+			}
+		}
+		logVal+=jVal;
+		if (logVal>=nParm){
+			logVal-=nParm;
+		}
+	}
+}
+
+static void bsSquare(const struct BchCodec *pCdc,unsigned long long opa[][MAXBITSLICEWORDS],
+					 unsigned long long prod[][MAXBITSLICEWORDS])
+{
+	//****************************************************************
+	//	Function: bsSquare
+	//
+	//	Bit-sliced square of a row of field elements.  Squaring is
+	//  linear over GF(2), so the square is the XOR of the squares of
+	//  the set bits (bsSquareTbl).
+	//****************************************************************
+	int bx,cx,wx;
+	unsigned long long mask;
+	const int mParm=pCdc->mParm;
+	const int W=pCdc->bitSliceWords;
+
+	for (cx=0;cx<mParm;cx++){
+		for (wx=0;wx<W;wx++){
+			prod[cx][wx]=0;
+		}
+	}
+	for (bx=0;bx<mParm;bx++){
+		for (cx=0;cx<mParm;cx++){
+			mask=0-(unsigned long long)((pCdc->bsSquareTbl[bx] >> cx) & 1);
+			for (wx=0;wx<W;wx++){
+				prod[cx][wx]^=opa[bx][wx] & mask;
+			}
+		}
+	}
+}
+
+static void bsMult(const struct BchCodec *pCdc,unsigned long long opa[][MAXBITSLICEWORDS],
+				   unsigned long long opb[][MAXBITSLICEWORDS],unsigned long long prod[][MAXBITSLICEWORDS])
+{
+	//****************************************************************
+	//	Function: bsMult
+	//
+	//	Bit-sliced multiply of a row of pairs of field elements - the
+	//  schoolbook carry-less product (m*m ANDs and XORs) reduced by the
+	//  field generator polynomial.  bsMultAvx2 and bsMultAvx512 are
+	//  the same for rows of 4 and 8 words.
+	//****************************************************************
+	int ix,jx,ex,wx;
+	unsigned long long wide[2*MAXMPARM-1][MAXBITSLICEWORDS];
+	const int mParm=pCdc->mParm;
+	const int ffPoly=pCdc->ffPoly;
+	const int W=pCdc->bitSliceWords;
+
+	for (ix=0;ix<2*mParm-1;ix++){
+		for (wx=0;wx<W;wx++){
+			wide[ix][wx]=0;
+		}
+	}
+	for (ix=0;ix<mParm;ix++){
+		for (jx=0;jx<mParm;jx++){
+			for (wx=0;wx<W;wx++){
+				wide[ix+jx][wx]^=opa[ix][wx] & opb[jx][wx];
+			}
+		}
+	}
+	// x^m = the low m bits of ffPoly
+	for (ix=2*mParm-2;ix>=mParm;ix--){
+		for (ex=0;ex<mParm;ex++){
+			if ((ffPoly >> ex) & 1){
+				for (wx=0;wx<W;wx++){
+					wide[ix-mParm+ex][wx]^=wide[ix][wx];
+				}
+			}
+		}
+	}
+	for (ix=0;ix<mParm;ix++){
+		for (wx=0;wx<W;wx++){
+			prod[ix][wx]=wide[ix][wx];
+		}
+	}
+}
+
+#if BCHX86SIMD
+TARGETAVX2 static void bsMultAvx2(const struct BchCodec *pCdc,unsigned long long opa[][MAXBITSLICEWORDS],
+								  unsigned long long opb[][MAXBITSLICEWORDS],
+								  unsigned long long prod[][MAXBITSLICEWORDS])
+{
+	//****************************************************************
+	//	Function: bsMultAvx2
+	//
+	//	Same as bsMult for rows of 4 words, one AVX2 register per bit.
+	//****************************************************************
+	int ix,jx,ex;
+	__m256i aBit,wide[2*MAXMPARM-1];
+	const int mParm=pCdc->mParm;
+	const int ffPoly=pCdc->ffPoly;
+
+	for (ix=0;ix<2*mParm-1;ix++){
+		wide[ix]=_mm256_setzero_si256();
+	}
+	for (ix=0;ix<mParm;ix++){
+		aBit=_mm256_loadu_si256((const __m256i *)opa[ix]);
+		for (jx=0;jx<mParm;jx++){
+			wide[ix+jx]=_mm256_xor_si256(wide[ix+jx],
+				_mm256_and_si256(aBit,_mm256_loadu_si256((const __m256i *)opb[jx])));
+		}
+	}
+	for (ix=2*mParm-2;ix>=mParm;ix--){
+		for (ex=0;ex<mParm;ex++){
+			if ((ffPoly >> ex) & 1){
+				wide[ix-mParm+ex]=_mm256_xor_si256(wide[ix-mParm+ex],wide[ix]);
+			}
+		}
+	}
+	for (ix=0;ix<mParm;ix++){
+		_mm256_storeu_si256((__m256i *)prod[ix],wide[ix]);
+	}
+}
+
+TARGETAVX512 static void bsMultAvx512(const struct BchCodec *pCdc,unsigned long long opa[][MAXBITSLICEWORDS],
+									  unsigned long long opb[][MAXBITSLICEWORDS],
+									  unsigned long long prod[][MAXBITSLICEWORDS])
+{
+	//****************************************************************
+	//	Function: bsMultAvx512
+	//
+	//	Same as bsMult for rows of 8 words, one AVX-512 register per bit.
+	//****************************************************************
+	int ix,jx,ex;
+	__m512i aBit,wide[2*MAXMPARM-1];
+	const int mParm=pCdc->mParm;
+	const int ffPoly=pCdc->ffPoly;
+
+	for (ix=0;ix<2*mParm-1;ix++){
+		wide[ix]=_mm512_setzero_si512();
+	}
+	for (ix=0;ix<mParm;ix++){
+		aBit=_mm512_loadu_si512(opa[ix]);
+		for (jx=0;jx<mParm;jx++){
+			wide[ix+jx]=_mm512_xor_si512(wide[ix+jx],
+				_mm512_and_si512(aBit,_mm512_loadu_si512(opb[jx])));
+		}
+	}
+	for (ix=2*mParm-2;ix>=mParm;ix--){
+		for (ex=0;ex<mParm;ex++){
+			if ((ffPoly >> ex) & 1){
+				wide[ix-mParm+ex]=_mm512_xor_si512(wide[ix-mParm+ex],wide[ix]);
+			}
+		}
+	}
+	for (ix=0;ix<mParm;ix++){
+		_mm512_storeu_si512(prod[ix],wide[ix]);
+	}
+}
+#endif
+
+static void bsRiBM(const struct BchCodec *pCdc,unsigned long long syn[][MAXMPARM][MAXBITSLICEWORDS],
+				   unsigned long long delta[][MAXMPARM][MAXBITSLICEWORDS],
+				   unsigned long long theta[][MAXMPARM][MAXBITSLICEWORDS],int kk[])
+{
+	//****************************************************************
+	//	Function: bsRiBM
+	//
+	//	riBM (see riBM) for all the lanes of a bit-sliced pass at once,
+	//  with the field arithmetic done by bit-sliced circuits (bsMult).
+	//  riBM has no branches that depend on the data - the length
+	//  change select is a mask with a bit per lane, so all lanes run
+	//  the same steps.  On exit delta[t..2t] holds the ELP of each lane
+	//  and kk[l] is 2*passes - 2*Ln of lane l, the inputs of riBMElp.
+	//****************************************************************
+	int qx,ix,bx,wx,lx;
+	unsigned long long sel[MAXBITSLICEWORDS];
+	unsigned long long prodA[MAXMPARM][MAXBITSLICEWORDS],prodB[MAXMPARM][MAXBITSLICEWORDS];
+	unsigned long long gamma[MAXMPARM][MAXBITSLICEWORDS],delta0[MAXMPARM][MAXBITSLICEWORDS];
+	const int mParm=pCdc->mParm;
+	const int tParm=pCdc->tParm;
+	const int W=pCdc->bitSliceWords;
+	const int numTerms=3*tParm+1;
+
+	for (ix=0;ix<numTerms+2;ix++){
+		for (bx=0;bx<mParm;bx++){
+			for (wx=0;wx<W;wx++){
+				delta[ix][bx][wx]=(ix<2*tParm) ? syn[ix][bx][wx] : 0;
+				// The number "1" in delta(3t), gamma=1
+				if (bx==0 && ix==3*tParm){
+					delta[ix][bx][wx]=~0ULL;
+				}
+				theta[ix][bx][wx]=delta[ix][bx][wx];
+				gamma[bx][wx]=(bx==0) ? ~0ULL : 0;
+			}
+		}
+	}
+	for (lx=0;lx<64*W;lx++){
+		kk[lx]=0;
+	}
+	for (qx=0;qx<tParm;qx++){
+		// sel has a one for each lane whose length changes on this pass
+		for (wx=0;wx<W;wx++){
+			sel[wx]=0;
+			for (bx=0;bx<mParm;bx++){
+				delta0[bx][wx]=delta[0][bx][wx];
+				sel[wx]|=delta0[bx][wx];
+			}
+		}
+		for (lx=0;lx<64*W;lx++){
+			if (kk[lx]<0){
+				sel[lx/64]&=~(1ULL << (lx%64));
+			}
+		}
+		for (ix=0;ix<numTerms;ix++){
+#if BCHX86SIMD
+			if (W==8){
+				bsMultAvx512(pCdc,gamma,delta[ix+2],prodA);
+				bsMultAvx512(pCdc,delta0,theta[ix+1],prodB);
+			}
+			else if (W==4){
+				bsMultAvx2(pCdc,gamma,delta[ix+2],prodA);
+				bsMultAvx2(pCdc,delta0,theta[ix+1],prodB);
+			}
+			else
+#endif
+			{
+				bsMult(pCdc,gamma,delta[ix+2],prodA);
+				bsMult(pCdc,delta0,theta[ix+1],prodB);
+			}
+			for (bx=0;bx<mParm;bx++){
+				for (wx=0;wx<W;wx++){
+					theta[ix][bx][wx]=(delta[ix+1][bx][wx] & sel[wx]) | (theta[ix][bx][wx] & ~sel[wx]);
+					delta[ix][bx][wx]=prodA[bx][wx]^prodB[bx][wx];
+				}
+			}
+		}
+		for (bx=0;bx<mParm;bx++){
+			for (wx=0;wx<W;wx++){
+				gamma[bx][wx]=(delta0[bx][wx] & sel[wx]) | (gamma[bx][wx] & ~sel[wx]);
+			}
+		}
+		for (lx=0;lx<64*W;lx++){
+			kk[lx]=((sel[lx/64] >> (lx%64)) & 1) ? -kk[lx] : kk[lx]+2;
+		}
+	}
+}
+
+//
+// An instance of this structure is the private state of one batch decode
+// worker.  The scratch area and the codeword array belong to the worker alone.
+struct BchDecodeWorker {
+	const struct BchCodec *pCdc;
+	unsigned char *buff;		// First byte of the worker's codeword range
+	int numCWs;					// # codewords in the range
+	int writeBack;				// "1" - correct the CWs in place in buff
+	int statusCnt[3];			// ERRFREE, CORR, UNCORR counts for the range
+	struct BchScratch scratch;
+	unsigned char codeword[MAXCODEWDBYTES]; // Copy of a CW in error if writeBack is 0
+	// Bit-sliced decode (bitSliceFlg=1) - bsRows (numCodewordBytes*8 rows)
+	// and bsFold (bsFoldRows rows) are allocated by bchDecodePoolStart
+	unsigned long long *bsRows,*bsFold;
+	unsigned long long bsSyn[MAXNUMSYN][MAXMPARM][MAXBITSLICEWORDS];
+	unsigned long long bsDelta[3*MAXCORR+3][MAXMPARM][MAXBITSLICEWORDS];
+	unsigned long long bsTheta[3*MAXCORR+3][MAXMPARM][MAXBITSLICEWORDS];
+	int bsKk[64*MAXBITSLICEWORDS];
+};
+
+static void bchDecodeSliced(struct BchDecodeWorker *pWkr,unsigned char pCWs[],int numCWs)
+{
+	//****************************************************************
+	//	Function: bchDecodeSliced
+	//
+	//	Decodes up to bitSliceWords*64 codewords, stored back to back in
+	//  byte format, in one bit-sliced pass.  The codewords are
+	//  transposed to rows with one bit per codeword, and the odd
+	//  syndromes of all of them are computed by XOR networks - the
+	//  rows are reduced modulo a sparse multiple of each minimum
+	//  polynomial (bsFold) and the remainder is evaluated at
+	//  alpha^(2k+1) (bsOddSyndrome).  A codeword is error free if its
+	//  odd syndromes are all zero, which for bulk scrubbing is nearly
+	//  every codeword, and then no other work is done for it.
+	//
+	//  If any codeword is in error, the even syndromes are computed by
+	//  bit-sliced squaring.  If at least BITSLICEKEYEQMIN of each 64
+	//  codewords are in error the key equation is solved for all of
+	//  them at once by bsRiBM, else by solveKeyEq one codeword at a
+	//  time.  The roots are found and the errors fixed
+	//  one codeword at a time (locateAndFix) as in bchDecode, and
+	//  statuses are counted and codewords written back as in
+	//  bchDecodeRange.
+	//****************************************************************
+	int kx,wx,bx,lx,ix,lane,numInErr,slicedKeyEq,Ln,rootsFound,errFlg,dcdStatus,val;
+	int sigmaN[MAXCORR+1],logDelta[3*MAXCORR+3];
+	unsigned long long inErr[MAXBITSLICEWORDS];
+	const struct BchCodec *pCdc=pWkr->pCdc;
+	const int W=pCdc->bitSliceWords;
+	const int tParm=pCdc->tParm;
+	const int mParm=pCdc->mParm;
+	const int numCodewordBytes=pCdc->numCodewordBytes;
+	unsigned char *pCW;
+	unsigned long long (*syn)[MAXMPARM][MAXBITSLICEWORDS]=pWkr->bsSyn;
+	struct BchScratch *pScr=&pWkr->scratch;
+	struct BchIoVec cwVec[2];	// Data and parity of a codeword in error
+
+	bx=0;
+#if BCHX86SIMD
+	if (W>1 && numCWs==64*W){
+		bx=bsTransposeAvx2(pCdc,pCWs,pWkr->bsRows);
+	}
+#endif
+	bsTranspose(pCdc,pCWs,numCWs,bx,pWkr->bsRows);
+	for (kx=0;kx<tParm;kx++){
+#if BCHX86SIMD
+		if (W==8){
+			bsFoldAvx512(pCdc,pWkr->bsRows,pWkr->bsFold,pCdc->bsFoldLen[kx],pCdc->bsFoldTap[kx]);
+		}
+		else if (W==4){
+			bsFoldAvx2(pCdc,pWkr->bsRows,pWkr->bsFold,pCdc->bsFoldLen[kx],pCdc->bsFoldTap[kx]);
+		}
+		else
+#endif
+		{
+			bsFold(pCdc,pWkr->bsRows,pWkr->bsFold,pCdc->bsFoldLen[kx],pCdc->bsFoldTap[kx]);
+		}
+		bsOddSyndrome(pCdc,pWkr->bsFold,kx,syn);
+	}
+	// inErr has a one for each lane with a nonzero odd Syndrome
+	numInErr=0;
+	for (wx=0;wx<W;wx++){
+		inErr[wx]=0;
+		for (kx=0;kx<tParm;kx++){
+			for (bx=0;bx<mParm;bx++){
+				inErr[wx]|=syn[2*kx][bx][wx];
+			}
+		}
+		if (numCWs-64*wx<64){
+			inErr[wx]&=(numCWs-64*wx>0) ? (1ULL << (numCWs-64*wx))-1 : 0;
+		}
+		for (lx=0;lx<64;lx++){
+			numInErr+=(int)((inErr[wx] >> lx) & 1);
+		}
+	}
+	pWkr->statusCnt[ERRFREE]+=numCWs-numInErr;
+	if (numInErr==0){
+		return;
+	}
+	// Compute even Syndromes from the odd Syndromes
+	for (ix=2;ix<=2*tParm;ix+=2){
+		bsSquare(pCdc,syn[ix/2-1],syn[ix-1]);
+	}
+	slicedKeyEq=(numInErr>=BITSLICEKEYEQMIN*W) ? 1 : 0;
+	if (slicedKeyEq==1){
+		bsRiBM(pCdc,syn,pWkr->bsDelta,pWkr->bsTheta,pWkr->bsKk);
+	}
+	for (lane=0;lane<numCWs;lane++){
+		wx=lane/64;
+		lx=lane%64;
+		if (((inErr[wx] >> lx) & 1)==0){
+			continue;
+		}
+		// With writeBack the codeword is corrected where it lies in
+		// pCWs, otherwise in a copy
+		pCW=pCWs+(size_t)lane*numCodewordBytes;
+		if (pWkr->writeBack!=1){
+			for (ix=0;ix<numCodewordBytes;ix++){
+				pWkr->codeword[ix]=pCW[ix];
+			}
+			pCW=pWkr->codeword;
+		}
+		for (ix=0;ix<MAXCORR;ix++){
+			pScr->Loc[ix]=pCdc->logZVal;
+		}
+		for (ix=0;ix<2*tParm;ix++){
+			val=0;
+			for (bx=0;bx<mParm;bx++){
+				val|=(int)((syn[ix][bx][wx] >> lx) & 1) << bx;
+			}
+			pScr->syndromes[ix]=val;
+		}
+		errFlg=0;
+		if (slicedKeyEq==1){
+			for (ix=tParm;ix<=2*tParm;ix++){
+				val=0;
+				for (bx=0;bx<mParm;bx++){
+					val|=(int)((pWkr->bsDelta[ix][bx][wx] >> lx) & 1) << bx;
+				}
+				logDelta[ix]=(val!=0) ? pCdc->logTbl[val] : pCdc->logZVal;
+			}
+			Ln=riBMElp(pCdc,sigmaN,logDelta,pWkr->bsKk[lane],&errFlg);
+			rootsFound=0;
+		}
+		else {
+			Ln=solveKeyEq(pCdc,sigmaN,pScr->Loc,pScr->syndromes,&rootsFound,&errFlg);
+		}
+		cwVec[0].base=pCW;
+		cwVec[0].len=pCdc->numDataBytes;
+		cwVec[1].base=pCW+pCdc->numDataBytes;
+		cwVec[1].len=pCdc->numRedunBytes;
+		locateAndFix(pCdc,&cwVec[0],1,&cwVec[1],1,sigmaN,Ln,rootsFound,pScr,&errFlg);
+		dcdStatus=(errFlg!=0) ? UNCORR : CORR;
+		pWkr->statusCnt[dcdStatus]++;
+	}
+}
+
+static void bchDecodeRange(struct BchDecodeWorker *pWkr)
+{
+	//****************************************************************
+	//	Function: bchDecodeRange
+	//
+	//	Worker function of bchDecodeBatch.  Decodes a contiguous range
+	//  of codewords in byte format and counts the decode status of
+	//  each codeword.  On option the codewords are corrected in place.
+	//  With bitSliceFlg set the range is decoded bitSliceWords*64
+	//  codewords per pass by bchDecodeSliced.
+	//
+	//  With writeBack the codewords are decoded where they lie in buff.
+	//  Without it buff must not change, so the remainder is computed
+	//  from buff and only a codeword found in error is copied to the
+	//  worker's codeword array.  The copy is decoded from that
+	//  remainder by bchDecodeRemainder, so it is computed only once.
+	//****************************************************************
+	int k1,k2,dcdStatus,errFlg,lanes;
+	const int numCodewordBytes=pWkr->pCdc->numCodewordBytes;
+	const int numDataBytes=pWkr->pCdc->numDataBytes;
+	struct BchIoVec cwVec[2];	// Data and parity of a codeword
+
+	cwVec[0].len=numDataBytes;
+	cwVec[1].len=pWkr->pCdc->numRedunBytes;
+	unsigned char *pCW;
+
+	pWkr->statusCnt[ERRFREE]=0;
+	pWkr->statusCnt[CORR]=0;
+	pWkr->statusCnt[UNCORR]=0;
+	if (pWkr->pCdc->bitSliceFlg!=0){
+		lanes=64*pWkr->pCdc->bitSliceWords;
+		for (k1=0;k1<pWkr->numCWs;k1+=lanes){
+			bchDecodeSliced(pWkr,pWkr->buff+(size_t)k1*numCodewordBytes,
+				(pWkr->numCWs-k1<lanes) ? pWkr->numCWs-k1 : lanes);
+		}
+		return;
+	}
+	for (k1=0;k1<pWkr->numCWs;k1++){
+		pCW=pWkr->buff+(size_t)k1*numCodewordBytes;
+		if (pWkr->writeBack!=1){
+			cwVec[0].base=pCW;
+			cwVec[1].base=pCW+numDataBytes;
+			if (computeRemainder(pWkr->pCdc,&cwVec[0],1,&cwVec[1],1,
+				pWkr->scratch.remainBytes)==0){
+				pWkr->statusCnt[ERRFREE]++;
+				continue;
+			}
+			for (k2=0;k2<numCodewordBytes;k2++){
+				pWkr->codeword[k2]=pCW[k2];
+			}
+			cwVec[0].base=pWkr->codeword;
+			cwVec[1].base=pWkr->codeword+numDataBytes;
+			errFlg=0;
+			dcdStatus=bchDecodeRemainder(pWkr->pCdc,&cwVec[0],1,&cwVec[1],1,
+				&pWkr->scratch,&errFlg);
+			pWkr->statusCnt[dcdStatus]++;
+			continue;
+		}
+		errFlg=0;
+		dcdStatus=bchDecodeSpan(pWkr->pCdc,pCW,pCW+numDataBytes,&pWkr->scratch,&errFlg);
+		pWkr->statusCnt[dcdStatus]++;
+	}
+}
+
+//
+// An instance of this structure is a pool of batch decode workers for one
+// codec.  The threads are started once by bchDecodePoolStart and wait for
+// the batches bchDecodeBatch hands them, so a caller that decodes many
+// batches (the disk loops, the streaming chunks) does not pay for thread
+// creation on each one.  The calling thread is worker 0.
+struct BchDecodePool {
+	const struct BchCodec *pCdc;
+	int numThreads;				// Workers, including the calling thread
+	struct BchDecodeWorker *wkr;
+	std::thread *thrd;			// thrd[1] to thrd[numThreads-1]
+	std::mutex mtx;
+	std::condition_variable startCv,doneCv;
+	int batchNum;				// Bumped when a batch is handed out
+	int busyCnt;				// Workers still decoding the batch
+	int stopFlg;				// "1" - the workers exit
+};
+
+static void bchDecodePoolWorker(struct BchDecodePool *pPool,int wkrIdx)
+{
+	//****************************************************************
+	//	Function: bchDecodePoolWorker
+	//
+	//	Thread function of pool worker wkrIdx.  Waits for a batch,
+	//  decodes its range of it (bchDecodeRange) and reports done,
+	//  until bchDecodePoolStop sets stopFlg.
+	//****************************************************************
+	int batchDone;
+
+	batchDone=0;
+	for (;;){
+		{
+			std::unique_lock<std::mutex> lock(pPool->mtx);
+			while (pPool->stopFlg==0 && pPool->batchNum==batchDone){
+				pPool->startCv.wait(lock);
+			}
+			if (pPool->stopFlg!=0){
+				return;
+			}
+			batchDone=pPool->batchNum;
+		}
+		bchDecodeRange(&pPool->wkr[wkrIdx]);
+		{
+			std::lock_guard<std::mutex> lock(pPool->mtx);
+			pPool->busyCnt--;
+			if (pPool->busyCnt==0){
+				pPool->doneCv.notify_one();
+			}
+		}
+	}
+}
+
+static void bchDecodePoolStop(struct BchDecodePool *pPool)
+{
+	//****************************************************************
+	//	Function: bchDecodePoolStop
+	//
+	//	Stops and joins the pool threads and frees the worker storage.
+	//****************************************************************
+	int kx;
+
+	if (pPool->thrd!=0){
+		{
+			std::lock_guard<std::mutex> lock(pPool->mtx);
+			pPool->stopFlg=1;
+		}
+		pPool->startCv.notify_all();
+		for (kx=1;kx<pPool->numThreads;kx++){
+			if (pPool->thrd[kx].joinable()){
+				pPool->thrd[kx].join();
+			}
+		}
+		delete[] pPool->thrd;
+		pPool->thrd=0;
+	}
+	if (pPool->wkr!=0){
+		for (kx=0;kx<pPool->numThreads;kx++){
+			free(pPool->wkr[kx].bsRows);
+			free(pPool->wkr[kx].bsFold);
+		}
+		free(pPool->wkr);
+		pPool->wkr=0;
+	}
+	pPool->numThreads=0;
+}
+
+static int bchDecodePoolStart(struct BchDecodePool *pPool,const struct BchCodec *pCdc,
+							  int numThreads)
+{
+	//****************************************************************
+	//	Function: bchDecodePoolStart
+	//
+	//	Allocates the worker storage and starts numThreads-1 worker
+	//  threads (the calling thread is the last worker).  Enter 0 for
+	//  numThreads to use one thread per hardware thread.  The bit-sliced
+	//  rows are allocated if pCdc->bitSliceFlg is set (see bchCodecInit).
+	//  If a thread cannot be created (std::system_error) the pool keeps
+	//  the threads already started, down to the calling thread alone.
+	//
+	//  Returns 0, or 1 if worker storage could not be allocated.
+	//****************************************************************
+	int kx,jx,allocErr;
+	size_t rowBytes,foldBytes;
+
+	pPool->pCdc=pCdc;
+	pPool->wkr=0;
+	pPool->thrd=0;
+	pPool->batchNum=0;
+	pPool->busyCnt=0;
+	pPool->stopFlg=0;
+	if (numThreads<=0){
+		numThreads=(int)std::thread::hardware_concurrency();
+	}
+	if (numThreads<1){
+		numThreads=1;
+	}
+	if (numThreads>MAXDECODETHREADS){
+		numThreads=MAXDECODETHREADS;
+	}
+	pPool->numThreads=numThreads;
+	// Worker state is large - allocate it rather than use the stack
+	pPool->wkr=(struct BchDecodeWorker *)malloc(numThreads*sizeof(struct BchDecodeWorker));
+	if (pPool->wkr==0){
+		pPool->numThreads=0;
+		return(1);
+	}
+	allocErr=0;
+	rowBytes=(size_t)pCdc->numCodewordBytes*8*pCdc->bitSliceWords*sizeof(unsigned long long);
+	foldBytes=(size_t)pCdc->bsFoldRows*pCdc->bitSliceWords*sizeof(unsigned long long);
+	for (kx=0;kx<numThreads;kx++){
+		pPool->wkr[kx].pCdc=pCdc;
+		pPool->wkr[kx].numCWs=0;
+		pPool->wkr[kx].bsRows=0;
+		pPool->wkr[kx].bsFold=0;
+		if (pCdc->bitSliceFlg!=0){
+			pPool->wkr[kx].bsRows=(unsigned long long *)malloc(rowBytes);
+			pPool->wkr[kx].bsFold=(unsigned long long *)malloc(foldBytes);
+			if (pPool->wkr[kx].bsRows==0 || pPool->wkr[kx].bsFold==0){
+				allocErr=1;
+			}
+		}
+	}
+	if (allocErr!=0){
+		bchDecodePoolStop(pPool);
+		return(1);
+	}
+	pPool->thrd=new std::thread[numThreads];
+	for (kx=1;kx<numThreads;kx++){
+		try {
+			pPool->thrd[kx]=std::thread(bchDecodePoolWorker,pPool,kx);
+		}
+		catch (const std::system_error &) {
+			// Out of threads - use the ones started
+			for (jx=kx;jx<numThreads;jx++){
+				free(pPool->wkr[jx].bsRows);
+				free(pPool->wkr[jx].bsFold);
+			}
+			pPool->numThreads=kx;
+			break;
+		}
+	}
+	return(0);
+}
+
+static void bchDecodeBatch(struct BchDecodePool *pPool,unsigned char buff[],int numCWs,
+						   int writeBack,int statusCnt[3],struct BchScratch *pScr)
+{
+	//****************************************************************
+	//	Function: bchDecodeBatch
+	//
+	//	This function decodes numCWs codewords stored back to back in
+	//  byte format in buff on the workers of a pool.  The codewords
+	//  are split into contiguous ranges, one range per worker.  Each
+	//  worker has its own scratch area so the only thing shared is the
+	//  read-only codec context.  On option (writeBack=1) corrected
+	//  codewords are written back in place in buff.  The ERRFREE, CORR
+	//  and UNCORR counts of the workers are merged into statusCnt and
+	//  their uncorrectable counters (for testing only) are added to
+	//  those of pScr, if pScr is not 0.
+	//****************************************************************
+	int kx,numWkrs,cwsPerThread,extraCWs,firstCW;
+	const int numCodewordBytes=pPool->pCdc->numCodewordBytes;
+
+	statusCnt[ERRFREE]=0;
+	statusCnt[CORR]=0;
+	statusCnt[UNCORR]=0;
+	numWkrs=pPool->numThreads;
+	if (numWkrs>numCWs){
+		numWkrs=numCWs>0 ? numCWs : 1;
+	}
+	cwsPerThread=numCWs/numWkrs;
+	extraCWs=numCWs%numWkrs;
+	firstCW=0;
+	for (kx=0;kx<pPool->numThreads;kx++){
+		pPool->wkr[kx].buff=buff+(size_t)firstCW*numCodewordBytes;
+		pPool->wkr[kx].numCWs=(kx<numWkrs) ? cwsPerThread+(kx<extraCWs ? 1 : 0) : 0;
+		pPool->wkr[kx].writeBack=writeBack;
+		pPool->wkr[kx].scratch.berMasUCECntr=0;
+		pPool->wkr[kx].scratch.rootFindUCECntr=0;
+		pPool->wkr[kx].scratch.fixErrorsUCECntr=0;
+		firstCW+=pPool->wkr[kx].numCWs;
+	}
+	// Hand the other ranges to the pool, the calling thread decodes the first
+	if (numWkrs>1){
+		{
+			std::lock_guard<std::mutex> lock(pPool->mtx);
+			pPool->busyCnt=pPool->numThreads-1;
+			pPool->batchNum++;
+		}
+		pPool->startCv.notify_all();
+	}
+	bchDecodeRange(&pPool->wkr[0]);
+	if (numWkrs>1){
+		std::unique_lock<std::mutex> lock(pPool->mtx);
+		while (pPool->busyCnt>0){
+			pPool->doneCv.wait(lock);
+		}
+	}
+	for (kx=0;kx<numWkrs;kx++){
+		statusCnt[ERRFREE]+=pPool->wkr[kx].statusCnt[ERRFREE];
+		statusCnt[CORR]+=pPool->wkr[kx].statusCnt[CORR];
+		statusCnt[UNCORR]+=pPool->wkr[kx].statusCnt[UNCORR];
+		if (pScr!=0){
+			pScr->berMasUCECntr+=pPool->wkr[kx].scratch.berMasUCECntr;
+			pScr->rootFindUCECntr+=pPool->wkr[kx].scratch.rootFindUCECntr;
+			pScr->fixErrorsUCECntr+=pPool->wkr[kx].scratch.fixErrorsUCECntr;
+		}
+	}
+}
+//
+// Compile time specialized codes.  BchCode<M,T,K> is one fixed binary BCH
+// code - GF(2^M) with the field generator polynomial pickFieldGenPoly picks,
+// T correctable errors and K data bytes.  Every size and loop bound is
+// a constant, so the compiler can unroll the loops of the encoder,
+// computeRemainder, computeSyndromes, berMas and the Chien search.  berMas,
+// the finite field functions and the low degree ELP solvers (lowDegreeElp)
+// are the runtime templates instantiated with BchCodeTbls.  The other
+// functions mirror the runtime ones and use the same codeword format and
+// scratch area.  The runtime BchCodec path stays for exploring codes.
+//
+// The finite field tables, code generator polynomial and encode tables
+// (BchCodeTbls) are built once, when the program starts, one instance
+// for each field and t.  Building them by constexpr evaluation takes
+// more steps than the default limits of MSVC and clang allow (and
+// close to that of gcc) for the larger codes.
+//
+constexpr int bchFixedFieldPoly(int mParm)
+{
+	//****************************************************************
+	//	Function: bchFixedFieldPoly
+	//
+	//	Same table as pickFieldGenPoly.
+	//****************************************************************
+	const int fieldPolyTbl[] = {
+		37, 67, 137, 285, 529, 1033, 2053, 4179, 8219, 17475,
+		32771, 69643, 131081, 262273, 524327, 1048585
+	};
+	return(fieldPolyTbl[mParm-5]); // m = 5 table entry is at location 0
+}
+
+constexpr int bchFixedCosetSize(int nParm,int rootBase)
+{
+	//****************************************************************
+	//	Function: bchFixedCosetSize
+	//
+	//	Returns the number of roots alpha^rootBase, alpha^(2*rootBase),
+	//  alpha^(4*rootBase)... of the minimum polynomial of alpha^rootBase
+	//  (its degree), or 0 if a smaller odd power of alpha has the same
+	//  minimum polynomial - genCodeGenPoly skips those roots too.
+	//****************************************************************
+	int root=rootBase,size=0;
+
+	do{
+		if ((root & 1)!=0 && root<rootBase){
+			return(0);
 		}
-		for (kx=0;kx<=LnOrig-1;kx++) {
-			workTiModP[kx]=TiModP[logALPHAi][kx];
+		size++;
+		root*=2;
+		if (root>=nParm){
+			root-=nParm;
 		}
-		// Detect spceial case - Detect TiModP equal all zeros
-		specialCaseFlg=1;
-		for (jx=0;jx<=LnOrig-1;jx++) {
-			if (workTiModP[jx]>0) {
-				specialCaseFlg=0;
-				break;
+	}while (root!=rootBase);
+	return(size);
+}
+
+constexpr int bchFixedCgpDegree(int mParm,int tParm)
+{
+	//****************************************************************
+	//	Function: bchFixedCgpDegree
+	//
+	//	Degree of the code generator polynomial - the sum of the degrees
+	//  of the minimum polynomials of alpha^1,3,5...2t-1.
+	//****************************************************************
+	int rootBase=1,degree=0;
+
+	for (rootBase=1;rootBase<=2*tParm-1;rootBase+=2){
+		degree+=bchFixedCosetSize((1<<mParm)-1,rootBase);
+	}
+	return(degree);
+}
+
+template<int M,int T>
+struct BchCodeTbls {
+	// mParm to affineElpDeg are named as in BchCodec, so the finite field
+	// functions, the low degree ELP solvers and berMas take the tables in
+	// place of the codec with every bound a constant
+	static constexpr int mParm=M;
+	static constexpr int mParmOdd=M%2;
+	static constexpr int tParm=T;
+	static constexpr int affineElpDeg=AFFINEELPDEG;
+	static constexpr int ffSize=1<<M;
+	static constexpr int nParm=ffSize-1;
+	static constexpr int logZVal=2*nParm;
+	static constexpr int ffPoly=bchFixedFieldPoly(M);
+	static constexpr int numRedunBits=bchFixedCgpDegree(M,T);
+	static constexpr int numRedunBytes=(numRedunBits+7)/8;
+	static constexpr int numRedunWords=(numRedunBytes+3)/4;
+	static constexpr int sliceBytes=ENCODESLICEBYTES;
+	static constexpr int clmulFoldWords=(numRedunBits+63)/64+1;
+	// Syndrome tables only if SYNDROMETBLS is 1 and they have at most
+	// FIXEDSYNTBLMAX entries - larger ones do not fit in cache
+	static constexpr int synTblFlg=(SYNDROMETBLS!=0 && numRedunBytes*BYTESTATES*T<=FIXEDSYNTBLMAX);
+	static constexpr int synTblBytes=(synTblFlg!=0) ? numRedunBytes : 1;
+	static_assert(M>=MINMPARM && M<=MAXMPARM && T>=1 && T<=MAXCORR && M*T<ffSize,
+		"BchCode - code parameter out of range");
+	static_assert(sliceBytes==1 || sliceBytes==4 || sliceBytes==8,
+		"BchCode - ENCODESLICEBYTES must be 1, 4 or 8");
+
+	FfElem alogTbl[2*ffSize];
+	FfLog logTbl[ffSize];
+	int traceTestVal,quadCompTbl[M];
+	unsigned int cgpFdbkWords[numRedunWords];
+	unsigned int encodeTbl[BYTESTATES][numRedunWords];
+	unsigned int sliceTbl[sliceBytes][BYTESTATES][numRedunWords]; // [0] not used
+	unsigned long long clmulFoldConst[clmulFoldWords];
+	unsigned short synTbl[synTblBytes][BYTESTATES][T]; // Built if synTblFlg is 1
+
+	BchCodeTbls() : alogTbl(),logTbl(),traceTestVal(0),quadCompTbl(),
+		cgpFdbkWords(),encodeTbl(),sliceTbl(),clmulFoldConst(),synTbl()
+	{
+		//****************************************************************
+		//	Function: BchCodeTbls
+		//
+		//	Builds the tables the same way as buildLogAlogTbls,
+		//  genTraceTestVal, genQuadCompTbl, genCodeGenPoly,
+		//  cvtCgpBitToCgpWord, genEncodeTbls, genClmulFoldConsts and
+		//  genSyndromeTbls.
+		//****************************************************************
+		int cgp[M*T+1]={},tmp[M*T+1]={},searchTbl[M]={};
+		int kx=0,jx=0,x=0,sum=0,firstTraceOne=0,root=0,rootBase=0,cgpDegree=0,wordAddr=0;
+		unsigned int shiftReg=1,bitMask=0,fdbk=0,fdbkSav=0,SR[numRedunWords]={};
+
+		// Log and alog tables
+		shiftReg=1;
+		for (kx=0;kx<2*ffSize;kx++){
+			alogTbl[kx]=(FfElem)shiftReg;
+			if (kx<nParm){
+				logTbl[shiftReg]=(FfLog)kx;
+			}
+			shiftReg<<=1;
+			if ((shiftReg & ffSize)!=0){
+				shiftReg^=(unsigned int)ffPoly;
 			}
 		}
-		// Handle special case of residues summing to all zeros
-		// ========== EITHER SPLIT CURRENT FACTOR OR PASS IT ON ==========================
-		if (specialCaseFlg==1) {
-			// ========== CANNOT SPLIT BECAUSE OF SPECIAL CASE - PASS ON CURRENT FACTOR
-			degA=degTbl[factorTblCurrPosIdx];
-			degB=0;
-			for (kx=0;kx<=degA;kx++) { // n+1 coefficients in a degree n polynomial
-				factorA[kx]=currFactor[kx];
+		logTbl[0]=FFLOGZERO;
+		alogTbl[logZVal]=0;
+		// Trace test value and quadratic component table (see ffQuadFun)
+		for (jx=0;jx<M;jx++){
+			x=alogTbl[jx];
+			sum=0;
+			for (kx=0;kx<M;kx++){
+				sum^=x;
+				x=(x==0) ? 0 : alogTbl[2*logTbl[x]];
 			}
-			factorB[0]=1;
-		}else{
-			// ========== TRY SPLITTING THE FACTOR ========================================
-			// Use gcd to split currFactor into two factors (factorA and factorB).
-			// NOTE: Since TiModP is a residue its degree in the below
-			// call is one less than the degree of the input poly to this function
-			errFlg |= ffPFastGcd(currFactor,degTbl[factorTblCurrPosIdx],
-				workTiModP,LnOrig-1,factorA,&degA,alogTbl,logTbl,nParm);
-			if (errFlg>0){
-				return (errFlg);
+			if (sum==1){
+				traceTestVal^=1<<jx;
 			}
-			degCF=degTbl[factorTblCurrPosIdx];
-			errFlg |= ffPFastQuotient(currFactor,degCF,factorA,degA,
-				factorB,alogTbl,logTbl,nParm);
-			if (errFlg>0){
-				return (errFlg);
+		}
+		for (kx=0;kx<M;kx++){
+			if ((traceTestVal & (1<<kx))==0){
+				searchTbl[kx]=1<<kx;
+			}
+			else if (firstTraceOne>0){
+				searchTbl[kx]=(1<<kx)^firstTraceOne;
+			}
+			else {
+				firstTraceOne=1<<kx;
 			}
-			degB=degTbl[factorTblCurrPosIdx]-degA;
 		}
-		// ========== PUT factorA IN THE FACTOR TABLE IF DEGREE >(2,4) ====================
-		skipFactorCurrIdxInc=0;
-		if ((mParmOdd==1 && degA>2) || (mParmOdd==0 && degA>4)) {
-			// Put factorA in curr pos of factorTbl
-			for (kx=0;kx<=degA;kx++) { // n+1 coeffs for degree n poly
-				factorTbl[factorTblCurrPosIdx][kx]=factorA[kx];
+		for (x=0;x<ffSize;x+=2){
+			for (kx=0;kx<M;kx++){
+				if (((x==0) ? 0 : alogTbl[2*logTbl[x]]^x)==searchTbl[kx]){
+					quadCompTbl[kx]=x;
+				}
 			}
-			alphaTbl[factorTblCurrPosIdx]=logALPHAi+1;
-			degTbl[factorTblCurrPosIdx]=degA;
-			skipFactorCurrIdxInc=1;
-		}else{
-			// Flip L-R and div thru by highest coeff. -------------------
-			// Note that loop starts at "1". This because we handle
-			// hi coeff (lowest in array) seperately.
-			// Does not use ffDiv for speed.
-			if (factorA[degA]==0){
-				return (DIVZRODIV); // Divide by zero error
+		}
+		// Code generator polynomial - product of (x - alpha^root) over the
+		// roots of the minimum polynomials, low order in address 0
+		cgp[0]=1;
+		cgpDegree=0;
+		for (rootBase=1;rootBase<=2*T-1;rootBase+=2){
+			if (bchFixedCosetSize(nParm,rootBase)==0){
+				continue;
 			}
-			tmpLogD=logTbl[factorA[degA]];
-			for (kx=1;kx<=degA;kx++) {  // n+1 coefficients in a degree n polynomial
-				tmpN=factorA[degA-kx];
-				if ((tmpN)!=0){
-					tmpLogQ=logTbl[tmpN]-tmpLogD;
-					if (tmpLogQ<0){
-						tmpLogQ=tmpLogQ+nParm;
+			root=rootBase;
+			do{
+				for (kx=cgpDegree+1;kx>=1;kx--){
+					tmp[kx]=cgp[kx-1];
+				}
+				tmp[0]=0;
+				cgpDegree++;
+				for (kx=cgpDegree;kx>=0;kx--){
+					cgp[kx]=tmp[kx]^((cgp[kx]==0) ? 0 : alogTbl[logTbl[cgp[kx]]+root]);
+				}
+				root*=2;
+				if (root>=nParm){
+					root-=nParm;
+				}
+			}while (root!=rootBase);
+		}
+		// Feedback words, high order in address 0
+		wordAddr=0;
+		bitMask=0x80000000;
+		for (kx=numRedunBits-1;kx>=0;kx--){
+			if (cgp[kx]>0){
+				cgpFdbkWords[wordAddr]^=bitMask;
+			}
+			bitMask>>=1;
+			if (bitMask==0){
+				bitMask=0x80000000;
+				wordAddr++;
+			}
+		}
+		// Encode table
+		for (unsigned int iii=0;iii<BYTESTATES;iii++){
+			for (int jjj=0;jjj<numRedunWords;jjj++){
+				SR[jjj]=0;
+			}
+			SR[0]=iii << 24;
+			for (int jjj=0;jjj<=7;jjj++){
+				fdbk=0;
+				for (int nnn=numRedunWords-1;nnn>=0;nnn--){
+					fdbkSav=fdbk;
+					fdbk=SR[nnn] >> 31;
+					SR[nnn]=(SR[nnn] << 1) ^ fdbkSav;
+				}
+				if (fdbk==1){
+					for (int nnn=0;nnn<numRedunWords;nnn++){
+						SR[nnn]^=cgpFdbkWords[nnn];
 					}
-					tmp[kx]=alogTbl[tmpLogQ];
-				}else{
-					tmp[kx]=0;
 				}
 			}
-			tmp[0]=1; // Force highest coefficient to "1"
-			// End flip and divide through -------------------------------
-			// Call quartic, cubic, quadratic, or linear to find roots
-			if (degA==4) {
-				errFlg|=quarticElp(nParm,tmp,roots,alogTbl); // 4 errors
-			};
-			if (degA==3) {
-				errFlg|=cubicElp(nParm,tmp,roots,alogTbl); // 3 errors
-			};
-			if (degA==2) {
-				errFlg|=quadraticElp(tmp,roots); // 2 errors
-			};
-			if (degA==1) {
-				linearElp(tmp,roots); // 1 error
-			};
-			if (errFlg>0){
-				return (errFlg);
+			for (int nnn=0;nnn<numRedunWords;nnn++){
+				encodeTbl[iii][nnn]=SR[nnn];
 			}
-			// Put roots in Loc array
-			for (kx=0;kx<=degA-1;kx++) {
-				Loc[rootsFoundIdx]=roots[kx];
-				rootsFoundIdx=rootsFoundIdx+1;
+		}
+		// Slicing tables - sliceTbl[d][b] is encodeTbl[b] shifted d more bytes
+		for (int dist=1;dist<sliceBytes;dist++){
+			for (int iii=0;iii<BYTESTATES;iii++){
+				fdbk=0;
+				for (int nnn=numRedunWords-1;nnn>=0;nnn--){
+					fdbkSav=fdbk;
+					fdbk=((dist==1) ? encodeTbl[iii][nnn] : sliceTbl[dist-1][iii][nnn]) >> 24;
+					SR[nnn]=(((dist==1) ? encodeTbl[iii][nnn] : sliceTbl[dist-1][iii][nnn]) << 8) ^ fdbkSav;
+				}
+				for (int nnn=0;nnn<numRedunWords;nnn++){
+					sliceTbl[dist][iii][nnn]=SR[nnn]^encodeTbl[fdbk][nnn];
+				}
 			}
 		}
-		// ========== PUT factorB IN THE FACTOR TABLE IF DEGREE >(2,4) ====================
-		if ((mParmOdd==1 && degB>2) || (mParmOdd==0 && degB>4)) {
-			if (skipFactorCurrIdxInc==0 ) {// If curr position of factor tbl not already taken for next loop
-				// Put factorB in curr pos of factorTbl
-				for (kx=0;kx<=degB;kx++) {  // n+1 coeffs for degree n poly
-					factorTbl[factorTblCurrPosIdx][kx]=factorB[kx];
+		// Fold constant - x^(64*clmulFoldWords) mod g(x), low word first
+		const int padBits=32*numRedunWords-numRedunBits;
+		for (int nnn=0;nnn<numRedunWords;nnn++){
+			SR[nnn]=0;
+		}
+		SR[numRedunWords-1-padBits/32]=1U << (padBits%32);
+		for (kx=0;kx<64*clmulFoldWords;kx++){
+			fdbk=SR[0] >> 31;
+			fdbkSav=0;
+			for (int nnn=numRedunWords-1;nnn>=0;nnn--){
+				bitMask=SR[nnn] >> 31;
+				SR[nnn]=(SR[nnn] << 1) | fdbkSav;
+				fdbkSav=bitMask;
+			}
+			if (fdbk!=0){
+				for (int nnn=0;nnn<numRedunWords;nnn++){
+					SR[nnn]^=cgpFdbkWords[nnn];
 				}
-				alphaTbl[factorTblCurrPosIdx]=logALPHAi+1;
-				degTbl[factorTblCurrPosIdx]=degB;
-				skipFactorCurrIdxInc=1;
-			}else{
-				// Put factorB in next position of factorTbl
-				for (kx=0;kx<=degB;kx++) {  // n+1 coeffs for degree n poly
-					factorTbl[factorTblNxtEntryIdx][kx]=factorB[kx];
+			}
+		}
+		for (kx=0;kx<numRedunBits;kx++){
+			jx=kx+padBits;
+			if ((SR[numRedunWords-1-jx/32] >> (jx%32)) & 1){
+				clmulFoldConst[kx/64]|=1ULL << (kx%64);
+			}
+		}
+		// Syndrome tables
+		for (int iii=0;iii<numRedunBytes && synTblFlg!=0;iii++){
+			for (int jjj=0;jjj<8;jjj++){
+				x=(((numRedunBytes-1)-iii)*8+jjj)%nParm;
+				for (kx=0;kx<T;kx++){
+					synTbl[iii][1<<jjj][kx]=(unsigned short)alogTbl[(int)(((long long)x*(2*kx+1))%nParm)];
 				}
-				alphaTbl[factorTblNxtEntryIdx]=logALPHAi+1;
-				degTbl[factorTblNxtEntryIdx]=degB;
-				factorTblNxtEntryIdx=factorTblNxtEntryIdx+1;
 			}
-		}else{
-			if (factorB[degB]==0){
-				return (DIVZRODIV); // Divide by zero error
+			for (int bVal=3;bVal<BYTESTATES;bVal++){
+				if ((bVal & (bVal-1))!=0){
+					for (kx=0;kx<T;kx++){
+						synTbl[iii][bVal][kx]=synTbl[iii][bVal & (-bVal)][kx]^synTbl[iii][bVal & (bVal-1)][kx];
+					}
+				}
 			}
-			tmpLogD=logTbl[factorB[degB]];
-			for (kx=1;kx<=degB;kx++) {  // n+1 coefficients in a degree n polynomial
-				tmpN=factorB[degB-kx];
-				if ((tmpN)!=0){
-					tmpLogQ=logTbl[tmpN]-tmpLogD;
-					if (tmpLogQ<0){
-						tmpLogQ=tmpLogQ+nParm;
+		}
+	}
+};
+
+// One instance of the tables of each field and t, shared by all K,
+// built at startup
+template<int M,int T>
+const BchCodeTbls<M,T> bchFixedTbls;
+
+template<int M,int T,int K>
+struct BchCode {
+	typedef BchCodeTbls<M,T> Tbls;
+	static constexpr int mParm=M;
+	static constexpr int tParm=T;
+	static constexpr int nParm=Tbls::nParm;
+	static constexpr int logZVal=Tbls::logZVal;
+	static constexpr int ffPoly=Tbls::ffPoly;
+	static constexpr int numRedunBits=Tbls::numRedunBits;
+	static constexpr int numRedunBytes=Tbls::numRedunBytes;
+	static constexpr int numRedunWords=Tbls::numRedunWords;
+	static constexpr int numDataBytes=K;
+	static constexpr int numDataBits=8*K;
+	static constexpr int numCodewordBytes=K+numRedunBytes;
+	static constexpr int numSyndromes=2*T;
+	static_assert(K>=0 && K<=(nParm-numRedunBits)/8,"BchCode - K too large for the field");
+
+	static void shiftInDataBytesTbl(unsigned int SR[],const unsigned char data[],const int numBytes)
+	{
+		//****************************************************************
+		//	Function: BchCode::shiftInDataBytesTbl
+		//
+		//	shiftInDataBytesTbl for the fixed code.  numBytes is K or
+		//  the CLMUL accumulator size, so it is a constant once inlined.
+		//****************************************************************
+		const Tbls &tb=bchFixedTbls<M,T>;
+		const int sliceBytes=Tbls::sliceBytes;
+		const int wordShift=sliceBytes/4;
+		unsigned int fdbk,fdbkSav,fdbkWords[MAXSLICEBYTES/4]={0};
+		int jx,kx,dataAddr;
+
+		dataAddr=0;
+		if (sliceBytes>1){
+			for (; dataAddr+sliceBytes <= numBytes; dataAddr+=sliceBytes) {
+				for (kx=0;kx<wordShift;kx++){
+					fdbk=((unsigned int)data[dataAddr+4*kx]<<24) ^
+						((unsigned int)data[dataAddr+4*kx+1]<<16) ^
+						((unsigned int)data[dataAddr+4*kx+2]<<8) ^
+						(unsigned int)data[dataAddr+4*kx+3];
+					fdbkWords[kx]=(kx<numRedunWords) ? fdbk^SR[kx] : fdbk;
+				}
+				for (jx=0; jx < numRedunWords;jx++){
+					SR[jx] = (jx+wordShift < numRedunWords) ? SR[jx+wordShift] : 0;
+				}
+				for (kx=0;kx<sliceBytes;kx++){
+					fdbk=(fdbkWords[kx/4] >> (24-8*(kx%4))) & 0x000000ff;
+					for (jx=0; jx < numRedunWords;jx++){
+						SR[jx] ^= (kx==sliceBytes-1) ? tb.encodeTbl[fdbk][jx] :
+							tb.sliceTbl[sliceBytes-1-kx][fdbk][jx];
 					}
-					tmp[kx]=alogTbl[tmpLogQ];
-				}else{
-					tmp[kx]=0;
 				}
 			}
-			tmp[0]=1; // Force lowest coefficient to "1"
-			// Call quartic, cubic, quadratic, or linear to find roots
-			if (degB==4) {
-				errFlg|=quarticElp(nParm,tmp,roots,alogTbl); // 4 errors
-			};
-			if (degB==3) {
-				errFlg|=cubicElp(nParm,tmp,roots,alogTbl); // 3 errors
-			};
-			if (degB==2) {
-				errFlg|=quadraticElp(tmp,roots); // 2 errors
-			};
-			if (degB==1) {
-				linearElp(tmp,roots); // 1 error
-			};
-			if (errFlg>0){
-				return (errFlg);
+		}
+		for (; dataAddr < numBytes; dataAddr++) {
+			fdbk = 0;
+			for (jx=numRedunWords-1; jx >=0 ;jx--){
+				fdbkSav = fdbk;
+				fdbk = (SR[jx] >> 24) & 0x000000ff;
+				SR[jx] = (SR[jx] << 8) ^ fdbkSav;
 			}
-			// Put roots in Loc array
-			for (kx=0;kx<=degB-1;kx++) {
-				Loc[rootsFoundIdx]=roots[kx];
-				rootsFoundIdx=rootsFoundIdx+1;
+			fdbk ^= (unsigned int)data[dataAddr];
+			for (jx=0; jx < numRedunWords;jx++){
+				SR[jx] ^= tb.encodeTbl[fdbk][jx];
 			}
 		}
-		// This "if" decides if use curr factor tbl pos again or advance
-		if (skipFactorCurrIdxInc==0) {
-			factorTblCurrPosIdx=factorTblCurrPosIdx+1;
+	}
+
+#if BCHX86SIMD
+	TARGETCLMUL static void shiftInDataBytesClmul(unsigned int SR[],const unsigned char data[])
+	{
+		//****************************************************************
+		//	Function: BchCode::shiftInDataBytesClmul
+		//
+		//	shiftInDataBytesClmul for the K data bytes of the code.
+		//****************************************************************
+		const Tbls &tb=bchFixedTbls<M,T>;
+		const int foldWords=Tbls::clmulFoldWords;
+		unsigned long long accum[foldWords]={0},prod[2],fdbk,dataWord;
+		unsigned char foldBytes[8*foldWords];
+		int jx,kx,dataAddr;
+		__m128i fdbkVec,constVec;
+
+		for (dataAddr=0;dataAddr<K%8;dataAddr++){
+			accum[0]=(accum[0] << 8) | (unsigned int)data[dataAddr];
 		}
-		if (factorTblCurrPosIdx>LnOrig) {
-			// Uncorrectable Err - factorTblCurrPosIdx exceeds LnOrig
-			return (BTAFACTORTBLERR);
+		for (; dataAddr < K; dataAddr+=8) {
+			dataWord=0;
+			for (kx=0;kx<8;kx++){
+				dataWord=(dataWord << 8) | (unsigned int)data[dataAddr+kx];
+			}
+			fdbk=accum[foldWords-1];
+			for (kx=foldWords-1;kx>0;kx--){
+				accum[kx]=accum[kx-1];
+			}
+			accum[0]=dataWord;
+			fdbkVec=_mm_set_epi64x(0,(long long)fdbk);
+			for (jx=0;jx<foldWords-1;jx++){
+				constVec=_mm_loadl_epi64((const __m128i *)&tb.clmulFoldConst[jx]);
+				_mm_storeu_si128((__m128i *)prod,_mm_clmulepi64_si128(fdbkVec,constVec,0x00));
+				accum[jx]^=prod[0];
+				accum[jx+1]^=prod[1];
+			}
 		}
-	} // ========== END WHILE - END OF FACTORING FOR CURRENT CASE =======================
-	// Check if correct number of roots found
-	if ((errFlg==0) && (rootsFoundIdx)!=LnOrig) {
-		errFlg |= BTANUMROOTSERR;
-	}
-	if (errFlg==0){
-		for (kx1=0;kx1<=LnOrig-1;kx1++) {
-			for (kx2=kx1+1;kx2<=LnOrig-1;kx2++) {
-				if (Loc[kx1]==Loc[kx2]) {
-					return (BTAREPEATEDROOTS);
-				}
+		for (kx=0;kx<foldWords;kx++){
+			for (jx=0;jx<8;jx++){
+				foldBytes[8*kx+jx]=(unsigned char)(accum[foldWords-1-kx] >> (56-8*jx));
 			}
 		}
+		shiftInDataBytesTbl(SR,foldBytes,8*foldWords);
 	}
-	return (errFlg);
-}
+#endif
 
-static int rootFindBTA(int sigmaN[],int Loc[],const int alogTbl[], const int logTbl[],
-					   const int LnOrig,const int nParm,const int mParmOdd,
-					   const int mParm,const int LogZVal,const int ffsize)
-{
-	//****************************************************************
-	//	Function: rootFindBTA
-	//
-	//  NOTE: There are seperate rootFind functions for Chien and BTA.
-	//
-	//  This function is the highest level root finding function.  It calls
-	//  lower level root finding functions.  There are special functions
-	//  called for error locator polynomial (ELP) degrees 1 to 4 ("m" even)
-	//  or 1 to 2 ("m" odd).  If the degree of the ELP is greater than
-	//  4 ("m" even) or 2 ("m" odd) the Chien search function is called.
-	//****************************************************************
-	int errFlg;
+	static void shiftInDataBytes(unsigned int SR[],const unsigned char data[])
+	{
+		//****************************************************************
+		//	Function: BchCode::shiftInDataBytes
+		//
+		//	Shifts the K data bytes into SR, which must be zero on entry,
+		//  with CLMUL folding if the CPU has it and K is at least
+		//  CLMULMINDATABYTES (as REMENGAUTO picks), else with the tables.
+		//****************************************************************
+#if BCHX86SIMD
+		static const int clmulFlg=(cpuFeatures() & CPUPCLMUL)!=0;
 
-	// Note that special cases for quartic and cubic used only for m even
-	// while the special cases for linear and quadratic used for m odd or even
-	if (LnOrig==1){
-		linearElp(sigmaN,Loc); // No status returned - no errs detected in function
-		errFlg=0;
+		if (K>=CLMULMINDATABYTES && clmulFlg!=0){
+			shiftInDataBytesClmul(SR,data);
+			return;
+		}
+#endif
+		shiftInDataBytesTbl(SR,data,K);
+	}
+
+	static void encode(unsigned char codeword[])
+	{
+		//****************************************************************
+		//	Function: BchCode::encode
+		//
+		//	bchEncode for the fixed code.
+		//****************************************************************
+		unsigned int SR[numRedunWords]={0};
+		int kx;
+
+		shiftInDataBytes(SR,codeword);
+		for (kx=0;kx<numRedunBytes;kx++){
+			codeword[K+kx]=(int)((SR[kx/4] >> (24-8*(kx%4))) & 0xff);
+		}
+	}
+
+	static int computeRemainder(const unsigned char codeword[],int remainBytes[])
+	{
+		//****************************************************************
+		//	Function: BchCode::computeRemainder
+		//
+		//	computeRemainder for the fixed code.
+		//****************************************************************
+		unsigned int fdbk,fdbkSav,SR[numRedunWords]={0};
+		int nnn,readCWAddr,remainderDetdErr;
+
+		shiftInDataBytes(SR,codeword);
+		remainderDetdErr=0;
+		for (readCWAddr = K; readCWAddr < numCodewordBytes; readCWAddr++) {
+			fdbk = 0;
+			for (nnn=numRedunWords-1; nnn >=0 ;nnn--){
+				fdbkSav = fdbk;
+				fdbk = (SR[nnn] >> 24);
+				SR[nnn] = (SR[nnn] << 8) ^ fdbkSav;
+			}
+			fdbk ^= (unsigned int)codeword[readCWAddr];
+			remainBytes[readCWAddr-K]=(int)fdbk;
+			remainderDetdErr|=(fdbk!=0);
+		}
+		return(remainderDetdErr);
 	}
-	else if (LnOrig==2){
-		errFlg=quadraticElp(sigmaN,Loc);
+
+	static void computeSyndromes(int syndromes[],const int remainBytes[])
+	{
+		//****************************************************************
+		//	Function: BchCode::computeSyndromes
+		//
+		//	computeSyndromesTbl, or computeSyndromes if there are no
+		//  syndrome tables (see synTblFlg), for the fixed code - the odd
+		//  syndromes from the remainder, the even ones by squaring.
+		//****************************************************************
+		const Tbls &tb=bchFixedTbls<M,T>;
+		int iii,jjj,kkk,x,evenSNum,accumVal,bumpVal;
+
+		for (kkk=0;kkk<numSyndromes;kkk++){
+			syndromes[kkk] = 0;
+		}
+		for (iii=0;iii < numRedunBytes && Tbls::synTblFlg!=0;iii++){
+			if (remainBytes[iii]!=0){
+				for (kkk=0;kkk<T;kkk++){
+					syndromes[2*kkk]^=tb.synTbl[iii][remainBytes[iii]][kkk];
+				}
+			}
+		}
+		for (iii=0;iii < numRedunBytes && Tbls::synTblFlg==0;iii++){
+			for (jjj=0;jjj<8;jjj++){
+				if ((remainBytes[iii] >> jjj) & 1){
+					accumVal=((numRedunBytes-1)-iii)*8+jjj;
+					bumpVal=2*accumVal;
+					for (kkk=0;kkk<numSyndromes;kkk+=2){
+						syndromes[kkk] ^= tb.alogTbl[accumVal];
+						accumVal+=bumpVal;
+						if (accumVal>=nParm){
+							accumVal-=nParm;
+							if (accumVal>=nParm){
+								accumVal-=nParm;
+							}
+						}
+					}
+				}
+			}
+		}
+		for (kkk=0;kkk<numSyndromes;kkk+=2){
+			x=syndromes[kkk];
+			for (evenSNum=2*(kkk+1);evenSNum<=numSyndromes;evenSNum*=2){
+				if (x>0){
+					x=tb.alogTbl[2*tb.logTbl[x]];
+				}
+				syndromes[evenSNum-1]=x;
+			}
+		}
 	}
-	else if (LnOrig==3 && mParmOdd==0){
-		errFlg=cubicElp(nParm,sigmaN,Loc,alogTbl);
+
+	static int chienSearch(int sigmaN[],int Loc[],const int LnOrig)
+	{
+		//****************************************************************
+		//	Function: BchCode::chienSearch
+		//
+		//	Finds the roots of the ELP as rootFindChien does.  The Chien
+		//  search runs over the codeword bits and divides the ELP down by
+		//  each root it finds until the degree is elpStopDeg, then the
+		//  last roots are found by lowDegreeElp.  The
+		//  coefficients above the degree are held at the log of zero, so
+		//  every step runs the same T terms and the loop can be unrolled.
+		//  The search quits, with ROOTSNEQLN, as soon as the positions
+		//  left cannot hold the missing roots (see chienSearchRange).
+		//****************************************************************
+		const Tbls &tb=bchFixedTbls<M,T>;
+		const int startPos=numCodewordBytes*8-numDataBits-numRedunBits;
+		const int endPos=numCodewordBytes*8;
+		const int stopDeg=elpStopDeg(&tb);
+		int coef[T+1],nn,jj,accum,Ln,logPos;
+
+		Ln=LnOrig;
+		if (Ln>stopDeg){
+			for (jj=1;jj<=T;jj++){
+				coef[jj]=logZVal;
+				if (jj<=Ln && sigmaN[jj]!=0){
+					coef[jj]=(tb.logTbl[sigmaN[jj]]+nParm-(jj*startPos)%nParm)%nParm;
+				}
+			}
+			for (nn=startPos;nn<endPos && endPos-nn>Ln-stopDeg;nn++){
+				accum=0;
+				for (jj=1;jj<=T && jj<=Ln;jj++){
+					if (coef[jj]!=logZVal){
+						accum^=tb.alogTbl[coef[jj]];
+						coef[jj]-=jj;
+						if (coef[jj]<0){
+							coef[jj]+=nParm;
+						}
+					}
+				}
+				if (accum!=1){
+					continue;
+				}
+				// Root - divide sigma(x) by (1+alpha^nn*x) and advance the
+				// quotient to position nn+1
+				Loc[Ln-1]=tb.alogTbl[nn];
+				for (jj=1;jj<Ln;jj++){
+					sigmaN[jj]^=::ffMult(&tb,sigmaN[jj-1],Loc[Ln-1]);
+				}
+				sigmaN[Ln]=0;
+				Ln--;
+				if (Ln==stopDeg){
+					break;
+				}
+				logPos=nParm-(nn+1)%nParm;
+				for (jj=1;jj<=Ln;jj++){
+					coef[jj]=logZVal;
+					if (sigmaN[jj]!=0){
+						coef[jj]=(tb.logTbl[sigmaN[jj]]+(jj*logPos)%nParm)%nParm;
+					}
+				}
+				coef[Ln+1]=logZVal;
+			}
+			if (Ln!=stopDeg){
+				return(ROOTSNEQLN);
+			}
+		}
+		return(lowDegreeElp(&tb,sigmaN,Loc,Ln));
 	}
-	else if (LnOrig==4 && mParmOdd==0){
-		errFlg=quarticElp(nParm,sigmaN,Loc,alogTbl);
+
+	static int lowWeightDecode(int sigmaN[],int Loc[],const int syndromes[])
+	{
+		//****************************************************************
+		//	Function: BchCode::lowWeightDecode
+		//
+		//	lowWeightDecode for the fixed code.  Returns Ln, with sigmaN
+		//  and Loc filled in, or 0 if berMas must be used.
+		//****************************************************************
+		const Tbls &tb=bchFixedTbls<M,T>;
+		int s1,s3,s5,d,Ln,kx,errFlg;
+		int sigmaTmp[T+1];
+
+		errFlg=0;
+		s1=syndromes[0];
+		s3=(T>=2) ? syndromes[2] : 0;
+		d=::ffMult(&tb,::ffMult(&tb,s1,s1),s1)^s3;
+		sigmaN[0]=1;
+		sigmaN[1]=s1;
+		if (d==0 || T==1){
+			Ln=1;
+		}
+		else if (T==2){
+			sigmaN[2]=::ffDiv(&tb,d,s1,&errFlg);
+			Ln=2;
+		}
+		else {
+			s5=syndromes[4];
+			sigmaN[2]=::ffDiv(&tb,::ffMult(&tb,::ffMult(&tb,s1,s1),s3)^s5,d,&errFlg);
+			sigmaN[3]=d^::ffMult(&tb,s1,sigmaN[2]);
+			Ln=(sigmaN[3]==0) ? 2 : 3;
+		}
+		if (s1==0 && Ln<3){
+			return(0); // Not 1 or 2 errors
+		}
+		for (kx=0;kx<=Ln;kx++){
+			sigmaTmp[kx]=sigmaN[kx]; // chienSearch may change the ELP
+		}
+		errFlg|=chienSearch(sigmaTmp,Loc,Ln);
+		if (errFlg==0){
+			errFlg=verifyCorr(syndromes,Loc,Ln);
+		}
+		if (errFlg!=0){
+			return(0);
+		}
+		return(Ln);
 	}
-	else
+
+	static int verifyCorr(const int syndromes[],const int Loc[],int Ln)
 	{
-		errFlg=BTA(sigmaN,Loc,alogTbl,logTbl,
-			LnOrig,nParm,mParmOdd,mParm,LogZVal,ffsize);
+		//****************************************************************
+		//	Function: BchCode::verifyCorr
+		//
+		//	verifyCorr for the fixed code - 0 if the Ln locations clear
+		//  the odd syndromes, else VERIFYERR.
+		//****************************************************************
+		const Tbls &tb=bchFixedTbls<M,T>;
+		int kx,jx,sum,logPow[T],logStep[T];
+
+		if (Ln<0 || Ln>T){
+			return(VERIFYERR);
+		}
+		for (jx=0;jx<Ln;jx++){
+			if (Loc[jx]==0){
+				return(VERIFYERR);
+			}
+			logPow[jx]=tb.logTbl[Loc[jx]];
+			logStep[jx]=(2*logPow[jx])%nParm;
+		}
+		for (kx=0;kx<numSyndromes;kx+=2){
+			sum=syndromes[kx];
+			for (jx=0;jx<Ln;jx++){
+				sum^=tb.alogTbl[logPow[jx]];
+				logPow[jx]+=logStep[jx];
+				if (logPow[jx]>=nParm){
+					logPow[jx]-=nParm;
+				}
+			}
+			if (sum!=0){
+				return(VERIFYERR);
+			}
+		}
+		return(0);
 	}
-	return (errFlg);
-}
 
-static int fixErrors(int codeword[],const int Loc[],const int logTbl[],int Ln,int numCodewordBytes,
-					 int numDataBits, int numRedunBits,int nParm)
-{
-	//****************************************************************
-	//	Function: fixErrors
-	//
-	//	Function to do the actual correction of errors after error
-	// locations have been found by the decode function.
-	//****************************************************************
-	int kx,jx,bitLoc,byteLoc,byteValue,byteBitNum,errFlg;
+	static int decode(unsigned char codeword[],struct BchScratch *pScr,int *pErrFlg)
+	{
+		//****************************************************************
+		//	Function: BchCode::decode
+		//
+		//	bchDecode for the fixed code - remainder, syndromes, the closed
+		//  form for 1 to 3 errors or berMas and the Chien search, on
+		//  option verifyCorr, then fixErrors.  Returns ERRFREE, CORR or UNCORR
+		//  with the error flags in *pErrFlg and, as bchDecode, the
+		//  remainder, syndromes, ELP and locations in the scratch area.
+		//****************************************************************
+		const Tbls &tb=bchFixedTbls<M,T>;
+		int sigmaN[T+1],kx,Ln,rootsFound;
+		struct BchIoVec cwVec[2];	// Data and parity for fixErrors
 
-	errFlg=0;
-	for (kx=0;kx<Ln;kx++){
-		bitLoc = (((numCodewordBytes*8 - logTbl[Loc[kx]])-1)%nParm);
-		// Bounds check fwd displacement because pad bits at end.
-		// Note to Neal.
-		if (bitLoc>=0 && bitLoc<numDataBits+numRedunBits){
-			byteLoc = bitLoc/8;
-			byteBitNum = 7 - (bitLoc % 8);
-			byteValue=1;
-			for (jx=byteBitNum;jx>=1;jx--){
-				byteValue *=2;
+		*pErrFlg=0;
+		for (kx=0;kx<MAXCORR;kx++){
+			pScr->Loc[kx]=logZVal;
+		}
+		if (computeRemainder(codeword,pScr->remainBytes)==0){
+			for (kx=0;kx<numSyndromes;kx++){
+				pScr->syndromes[kx]=0; // Loop for testing only #########################
 			}
-			codeword[byteLoc] ^= byteValue;
+			return(ERRFREE);
 		}
-		else{
-			errFlg |= CORROUTSIDE;
+		computeSyndromes(pScr->syndromes,pScr->remainBytes);
+		Ln=(LOWWEIGHTDECODE!=0) ? lowWeightDecode(sigmaN,pScr->Loc,pScr->syndromes) : 0;
+		rootsFound=Ln;
+		if (Ln==0){
+			Ln=berMas(&tb,sigmaN,pScr->syndromes,pErrFlg);
 		}
+		pScr->LnOrig=Ln; // Line for testing only ####################################
+		for (kx=0;kx<=Ln && kx<=T;kx++){
+			pScr->sigmaOrig[kx]=sigmaN[kx]; // Loop for testing only #################
+		}
+		if (*pErrFlg!=0){
+			pScr->berMasUCECntr++; // Line for testing only ##########################
+			return(UNCORR);
+		}
+		if (rootsFound==0){
+			*pErrFlg|=chienSearch(sigmaN,pScr->Loc,Ln);
+			if (*pErrFlg==0 && VERIFYCORR!=0){
+				*pErrFlg|=verifyCorr(pScr->syndromes,pScr->Loc,Ln);
+			}
+		}
+		if (*pErrFlg!=0){
+			pScr->rootFindUCECntr++; // Line for testing only ########################
+			return(UNCORR);
+		}
+		cwVec[0].base=codeword;
+		cwVec[0].len=K;
+		cwVec[1].base=codeword+K;
+		cwVec[1].len=numRedunBytes;
+		*pErrFlg|=fixErrors(&cwVec[0],1,&cwVec[1],1,pScr,tb.logTbl,Ln,numCodewordBytes,
+			numDataBits,numRedunBits,nParm);
+		if (*pErrFlg!=0){
+			pScr->fixErrorsUCECntr++; // Line for testing only #######################
+			return(UNCORR);
+		}
+		return(CORR);
 	}
-	return (errFlg);
-}
+};
+
+#if FIXEDCODES
+//
+// An instance of this structure is one entry of fixedCodeTbl - the
+// parameters and the functions of a BchCode.
+struct BchFixedCode {
+	int mParm,ffPoly,tParm,numDataBytes;
+	void (*encode)(unsigned char codeword[]);
+	int (*decode)(unsigned char codeword[],struct BchScratch *pScr,int *pErrFlg);
+};
+#define FIXEDCODE(m,t,k) {m,BchCode<m,t,k>::ffPoly,t,k,&BchCode<m,t,k>::encode,&BchCode<m,t,k>::decode}
+//
+// The codes built in compile time specialized form.  A product that runs
+// only a few codes lists them here.
+static const struct BchFixedCode fixedCodeTbl[]={
+	FIXEDCODE(13,8,512),
+	FIXEDCODE(14,40,1024),
+	FIXEDCODE(15,12,2000)
+};
 
-static int bchDecode(int Loc[],const int alogTbl[], const int logTbl[],int FFSize,
-					 int tParm,int numCodewordBytes,int nParm,int mParmOdd,
-					 int numDataBits,int numRedunBits,int codeword[],
-					 int numRedunWords,int numRedunBytes,int numDataBytes,
-					 const unsigned int encodeTbl[BYTESTATES][MAXREDUNWDS],
-					 int remainBytes[],int syndromes[],int *pErrFlg,
-					 const int LogZVal,const int mParm,const int ffsize)
+static const struct BchFixedCode *findFixedCode(const struct BchCodec *pCdc)
 {
 	//****************************************************************
-	//	Function: bchDecode
-	//
-	//	This function performs decoding by calling -
-	//  - a function to compute a remainder
-	//  - a function to compute syndromes from the remainder
-	//  - a Berlekamp-Massey function to compute an error
-	//    locator polynomial
-	//  - a root finding function to find error locations
-	//    (roots of the error locator polynomial)
-	//
-	//  There is some test code in this function.  If you plan to implement
-	//  this function then you may want to remove the test code after
-	//  testing is complete.  All such code is commented "For testing only"
+	//	Function: findFixedCode
 	//
-	//  Array addresses for syndrome symbols and remainder bytes are passed
-	//  to this function but on entry to this function these arrays do not
-	//  contain useful data.
+	//	Returns the fixedCodeTbl entry for the code of pCdc, 0 if there
+	//  is none.
 	//****************************************************************
-	int status,remainderDetdErr,Ln,kx;
-	int sigmaN[MAXCORR+1];
+	int kx;
 
-	*pErrFlg=0;
-	status=0;
-	//	Tests three entries of the decode tables to determine
-	//	if they have been initialized.
-	for (kx=2;kx<=4;kx++){
-		if (logTbl[alogTbl[FFSize-kx]] != FFSize-kx){
-			*pErrFlg|=TBLNOTINIT;
-			return(UNCORR); // Return tables not initialized status
-		}
-	}
-	for (kx=0;kx<MAXCORR;kx++){
-		// Changed to "LogZVal" 9-9-10
-		Loc[kx]=LogZVal; // Set to log of zero
-	}
-	for(;;){ // Infinite loop - Exit is by "break"
-		remainderDetdErr=computeRemainder(codeword,numRedunWords,numRedunBytes,
-			numDataBytes,encodeTbl,remainBytes);
-		// If remainderDetdErr not 0, CW is not err free - could be corr or uncorr
-		if (remainderDetdErr!=0){
-			// GET HERE IF REMAINDER INDICATES AN ERROR (NON-ZERO REMAINDER)
-			status=CORR;
-			computeSyndromes(syndromes,numRedunBytes,remainBytes,
-				alogTbl,logTbl,nParm,tParm);
-			//	Compute coeff's of ELP using Berlekamp/Massey
-			Ln=berMas(tParm,sigmaN,syndromes,pErrFlg,nParm,alogTbl,logTbl);
-			gblLnOrig=Ln; // Line for testing only ################################
-			for (kx=0;kx<=Ln;kx++){
-				gblSigmaOrig[kx]=sigmaN[kx]; // Loop for testing only #############
-			}
-			if (*pErrFlg!=0){
-				gblBerMasUCECntr++; // Line for testing only ######################
-				break;
-			}
-			//	Find the roots of the ELP
-			if (gblRootFindOption==1){  // "1" - BTA, "0" - Chien
-				*pErrFlg|=rootFindBTA(sigmaN,Loc,alogTbl,logTbl,Ln,nParm,
-					mParmOdd,mParm,LogZVal,ffsize);
-			}else{
-				*pErrFlg|=rootFindChien(sigmaN,Loc,alogTbl,logTbl,
-					Ln,numCodewordBytes,nParm,mParmOdd);
-			}
-			if (*pErrFlg!=0){
-				gblRootFindUCECntr++; // Line for testing only ####################
-				break;
-			}
-			//	Fix the errors in the data buffer
-			*pErrFlg|=fixErrors(codeword,Loc,logTbl,Ln,numCodewordBytes,
-				numDataBits, numRedunBits,nParm);
-			if (*pErrFlg!=0){
-				gblFixErrorsUCECntr++; // Line for testing only ###################
-				break;
-			}
-		}
-		else {
-			for (kx=0;kx<2*tParm;kx++){
-				syndromes[kx]=0; // Loop for testing only #########################
-			}
+	for (kx=0;kx<(int)(sizeof(fixedCodeTbl)/sizeof(fixedCodeTbl[0]));kx++){
+		if (fixedCodeTbl[kx].mParm==pCdc->mParm && fixedCodeTbl[kx].ffPoly==pCdc->ffPoly &&
+			fixedCodeTbl[kx].tParm==pCdc->tParm &&
+			fixedCodeTbl[kx].numDataBytes==pCdc->numDataBytes){
+			return(&fixedCodeTbl[kx]);
 		}
-		break;
 	}
-	if (*pErrFlg!=0){
-		status=UNCORR;
-	}
-	// Status 0, CORR, or UNCORR (for UNCORR, *pErrFlg further defines FOR TESTING)
-	return(status);
+	return(0);
 }
+#endif
 static void printAppliedErrs()
 {
 	//****************************************************************
@@ -2599,12 +8580,12 @@ static void printAppliedErrs()
 	int kx,bitLocFromEnd;
 
 	printf("\nRaw bit Locs in applyErrors (log form)(from FRONT of gblCodeword)\n");
-	for (kx=0;kx<gblLnOrig;kx++){
+	for (kx=0;kx<gblScratch.LnOrig;kx++){
 		printf("%d ",gblRawLoc[kx]);
 	}
 	printf("\nRaw bit Locs in applyErrors (log form)(from END of gblCodeword)\n");
-	for (kx=0;kx<gblLnOrig;kx++){
-		bitLocFromEnd=(gblNumCodewordBytes*8-1)-gblRawLoc[kx];
+	for (kx=0;kx<gblScratch.LnOrig;kx++){
+		bitLocFromEnd=(gblCodec.numCodewordBytes*8-1)-gblRawLoc[kx];
 		printf("%d ",bitLocFromEnd);
 	}
 	printf("\nApplied errors - byte Locs (from FRONT of gblCodeword) and Values");
@@ -2621,10 +8602,10 @@ static void printSigmaN()
 	int kx;
 
 	printf("\n***** gblSigmaOrig (Alog format), gblLnOrig*****\n");
-	for (kx=0;kx<=gblLnOrig;kx++){
-		printf("%d ",gblSigmaOrig[kx]);
+	for (kx=0;kx<=gblScratch.LnOrig;kx++){
+		printf("%d ",gblScratch.sigmaOrig[kx]);
 	}
-	printf("   (%d)",gblLnOrig);
+	printf("   (%d)",gblScratch.LnOrig);
 }
 
 static int compareResults()
@@ -2641,7 +8622,7 @@ static int compareResults()
 	// compare the saved gblCodeword with the gblCodeword after correction
 	// and return the number of miscompares
 	misCompareCnt=0;
-	for (kx=0;kx<gblNumCodewordBytes;kx++){
+	for (kx=0;kx<gblCodec.numCodewordBytes;kx++){
 		if (gblCodeword[kx]!=gblCodewordSav[kx]){
 			misCompareCnt++;
 		}
@@ -2649,7 +8630,8 @@ static int compareResults()
 	return (misCompareCnt);
 }
 
-static int ffMult(int opa, int opb)
+template<class Cdc>
+static int ffMult(const Cdc *pCdc,int opa, int opb)
 {
 	//****************************************************************
 	//	Function: ffMult
@@ -2663,14 +8645,15 @@ static int ffMult(int opa, int opb)
 	if (opa==0 || opb==0){
 		return(0);
 	}
-	tmp =  gblLogTbl[opa]+gblLogTbl[opb];
-	if (tmp >= gblNParm){
-		tmp -= gblNParm;
+	tmp =  pCdc->logTbl[opa]+pCdc->logTbl[opb];
+	if (tmp >= pCdc->nParm){
+		tmp -= pCdc->nParm;
 	}
-	return (gblAlogTbl[tmp]);
+	return (pCdc->alogTbl[tmp]);
 }
 
-static int ffInv(int opa, int *pErrFlg)// Pointer to status
+template<class Cdc>
+static int ffInv(const Cdc *pCdc,int opa, int *pErrFlg)// Pointer to status
 {
 	//****************************************************************
 	//	Function: ffInv
@@ -2684,15 +8667,16 @@ static int ffInv(int opa, int *pErrFlg)// Pointer to status
 		*pErrFlg|=DIVZROINV; // Or into location pointed to
 		return(0);
 	}
-	if (gblLogTbl[opa]==0){
-		return(gblAlogTbl[0]);// gblAlogTbl[0] for general case - other types of finite fields
+	if (pCdc->logTbl[opa]==0){
+		return(pCdc->alogTbl[0]);// alogTbl[0] for general case - other types of finite fields
 	}
 	else {
-		return(gblAlogTbl[gblNParm-gblLogTbl[opa]]);
+		return(pCdc->alogTbl[pCdc->nParm-pCdc->logTbl[opa]]);
 	}
 }
 
-static int ffDiv(int opa, int opb, int *pErrFlg)
+template<class Cdc>
+static int ffDiv(const Cdc *pCdc,int opa, int opb, int *pErrFlg)
 {
 	//****************************************************************
 	//	Function: ffDiv
@@ -2710,11 +8694,11 @@ static int ffDiv(int opa, int opb, int *pErrFlg)
 	if (opa==0){
 		return(0);
 	}
-	tmp = gblLogTbl[opa]-gblLogTbl[opb];
+	tmp = pCdc->logTbl[opa]-pCdc->logTbl[opb];
 	if (tmp<0){
-		tmp += gblNParm;
+		tmp += pCdc->nParm;
 	}
-	return (gblAlogTbl[tmp]);
+	return (pCdc->alogTbl[tmp]);
 }
 
 static void printLogAlogTbls()
@@ -2725,16 +8709,16 @@ static void printLogAlogTbls()
 	int kx;
 
 	printf("\n***** gblAlogTbl ***** = \n");
-	for (kx = 0; kx <gblFFSize; kx++) {
-		printf("%d ", gblAlogTbl[kx]);
+	for (kx = 0; kx <gblCodec.ffSize; kx++) {
+		printf("%d ", gblCodec.alogTbl[kx]);
 		if (kx && ((kx % 20) == 0)){
 			printf("\n");
 		}
 	}
 	printf("\n");
 	printf("\n***** gblLogTbl ***** = \n");
-	for (kx = 0; kx <gblFFSize; kx++) {
-		printf("%d ", gblLogTbl[kx]);
+	for (kx = 0; kx <gblCodec.ffSize; kx++) {
+		printf("%d ", gblCodec.logTbl[kx]);
 		if (kx && ((kx % 20) == 0)){
 			printf("\n");
 		}
@@ -2752,8 +8736,8 @@ static void printCgpBits()
 
 	printf("\n");
 	printf("\n***** gblCgpBitArray ***** = \n");
-	for (kx = 0; kx <= gblCgpDegree; kx++) {
-		printf("%d ", gblCgpBitArray[kx]);
+	for (kx = 0; kx <= gblCodec.cgpDegree; kx++) {
+		printf("%d ", gblCodec.cgpBitArray[kx]);
 		if ((kx % 20) == 19){
 			printf("\n");
 		}
@@ -2772,132 +8756,603 @@ static void printCgpWords()
 
 	// Print the ints containing the code generator poly (32 bits per int)
 	printf("\n***** cgpWordArray ***** = \n");
-	for (kx = 0; kx < gblNumRedunWords; kx++){
-		printf("%8x ", gblCgpFdbkWords[kx]);
+	for (kx = 0; kx < gblCodec.numRedunWords; kx++){
+		printf("%8x ", gblCodec.cgpFdbkWords[kx]);
+	}
+	printf("\n");
+	//printf("\n");
+}
+
+static void printOrigCodeword()
+{
+	//****************************************************************
+	//	Function: printOrigCodeword
+	//
+	//  Print the encoded codeword as it was before errors were applied
+	//****************************************************************
+	int kx;
+
+	printf("\n\nCodeword after encoding = \n");
+	for (kx=0;kx<gblCodec.numDataBytes+gblCodec.numRedunBytes;kx++){
+		printf("%x-",gblCodewordSav[kx]);
+		if (kx % 20 == 19){
+			printf("\n");
+		}
+	}
+	printf("\n");
+}
+
+static void printCodeword()
+{
+	//****************************************************************
+	//	Function: printCodeword
+	//****************************************************************
+	int kx;
+
+	printf("\n\nCodeword after correction = \n");
+	for (kx=0;kx<gblCodec.numDataBytes+gblCodec.numRedunBytes;kx++){
+		printf("%x-",gblCodeword[kx]);
+		if (kx % 20 == 19){
+			printf("\n");
+		}
+	}
+	printf("\n");
+}
+
+static void printRemainBytes()
+{
+	//****************************************************************
+	//	Function: printRemainBytes
+	//
+	//  Print the remainder bytes
+	//****************************************************************
+	int kx;
+
+	printf("\nRemainder bytes = \n");
+	for (kx=0;kx<gblCodec.numRedunBytes;kx++){
+		printf("%d-",gblScratch.remainBytes[kx]);
+		if (kx % 20 == 19){
+			printf("\n");
+		}
+	}
+	printf("\n");
+}
+
+static void printSyndromes()
+{
+	//****************************************************************
+	//	Function: printSyndromes
+	//****************************************************************
+	int kx;
+
+	printf("\nSyndromes = \n");
+	for (kx=0;kx<2*gblCodec.tParm;kx++){
+		printf("%d-",gblScratch.syndromes[kx]);
+		if (kx % 20 == 19){
+			printf("\n");
+		}
+	}
+}
+
+static void printLocs()
+{
+	//****************************************************************
+	//	Function: printLocs
+	//
+	//	Function to print error locations
+	//****************************************************************
+	int kx,locTmp;
+
+	printf("\nRaw err locations (alog) (found by root search)(from end of CW) = \n");
+	for (kx=0;kx<gblScratch.LnOrig;kx++){
+		printf("%d-",gblScratch.Loc[kx]);
+		if (kx % 20 == 19){
+			printf("\n");
+		}
+	}
+	printf("\nRaw err locations (log) (found by root search)(from end of CW) = \n");
+	for (kx=0;kx<gblScratch.LnOrig;kx++){
+		printf("%d-",gblCodec.logTbl[gblScratch.Loc[kx]]);
+		if (kx % 20 == 19){
+			printf("\n");
+		}
+	}
+	printf("\nAdjusted Err Byte Locations (found by root search)(from front of CW) = \n");
+	for (kx=0;kx<gblScratch.LnOrig;kx++){
+		locTmp = ((((gblCodec.numCodewordBytes)*8
+			- gblCodec.logTbl[gblScratch.Loc[kx]])-1)%gblCodec.nParm)/8;
+		printf("%d-",locTmp);
+		if (kx % 20 == 19){
+			printf("\n");
+		}
+	}
+}
+
+static void printMiscompares()
+{
+	//****************************************************************
+	//	Function: printMiscompares
+	//****************************************************************
+	int kx;
+
+	for (kx=0;kx<gblCodec.numCodewordBytes;kx++){
+		if (gblCodeword[kx]!=gblCodewordSav[kx]){
+			printf("\nMiscompare - Loc %d  -  Rcvd %x  Expd %x",
+				kx,gblCodeword[kx],gblCodewordSav[kx]);
+		}
+	}
+}
+static void flipDistinctBits(int numErrs,int bitLoc[])
+{
+	//****************************************************************
+	//	Function: flipDistinctBits
+	//
+	//	Function to flip numErrs different random bits of gblCodeword.
+	//  The bit addresses are left in bitLoc.  Two errors at one bit
+	//  would cancel, leaving fewer errors than asked for.
+	//****************************************************************
+	int jx,ix;
+	const int numBits=gblCodec.numDataBits+gblCodec.numRedunBits;
+
+	for (jx=0;jx<numErrs;jx++){
+		do{
+			bitLoc[jx]=rand()%numBits;
+			for (ix=0;ix<jx && bitLoc[ix]!=bitLoc[jx];ix++){
+			}
+		}while (ix<jx);
+		gblCodeword[bitLoc[jx]/8]^=(unsigned char)(0x80>>(bitLoc[jx]%8));
+	}
+}
+
+static int chkUncorrUntouched(int numCWs,int *pNumUncorr)
+{
+	//****************************************************************
+	//	Function: chkUncorrUntouched
+	//
+	//	Function to decode numCWs words of t+1 different random bit
+	//  errors on the all zeros codeword and check that every word
+	//  bchDecode returns UNCORR for is left as it was received.  On a
+	//  shortened code a t+1 error word often decodes to locations some
+	//  of which are in the shortened part, and none of the others may
+	//  be flipped.
+	//  The # of UNCORR words is left in *pNumUncorr.  Returns the # of
+	//  UNCORR words the decoder changed.
+	//****************************************************************
+	static unsigned char rcvdCW[MAXCODEWDBYTES];
+	int kx,jx,errFlg,numChgd,bitLoc[MAXCORR+1];
+
+	numChgd=0;
+	*pNumUncorr=0;
+	for (kx=0;kx<numCWs;kx++){
+		clearWriteCW();
+		flipDistinctBits(gblCodec.tParm+1,bitLoc);
+		for (jx=0;jx<gblCodec.numCodewordBytes;jx++){
+			rcvdCW[jx]=gblCodeword[jx];
+		}
+		errFlg=0;
+		if (bchDecode(&gblCodec,gblCodeword,&gblScratch,&errFlg)==UNCORR){
+			(*pNumUncorr)++;
+			for (jx=0;jx<gblCodec.numCodewordBytes && gblCodeword[jx]==rcvdCW[jx];jx++){
+			}
+			if (jx<gblCodec.numCodewordBytes){
+				numChgd++;
+			}
+		}
+	}
+	return(numChgd);
+}
+
+static void genReliab()
+{
+	//****************************************************************
+	//	Function: genReliab
+	//
+	//	Function to simulate soft decision input for bchDecodeChase.
+	//  The bits gblRawLoc holds the errors at get reliabilities of 0
+	//  to 63, all other bits 64 to 255, so the least reliable bits
+	//  are errors.
+	//****************************************************************
+	int kx;
+
+	for (kx=0;kx<gblCodec.numDataBits+gblCodec.numRedunBits;kx++){
+		gblReliab[kx]=(unsigned char)(64+rand()%192);
+	}
+	for (kx=0;kx<gblNumErrsApplied;kx++){
+		gblReliab[gblRawLoc[kx]]=(unsigned char)(rand()%64);
+	}
+}
+
+static int chkChase(int numCWs,int *pNumT1Corr)
+{
+	//****************************************************************
+	//	Function: chkChase
+	//
+	//	Function to check bchDecodeChase on numCWs words of 0 to t+1
+	//  random bit errors on the all zeros codeword.  With no flip bits
+	//  the status and the corrected word must be those of bchDecode.
+	//  Then numCWs words of t+1 errors are decoded with CHASECHKBITS
+	//  flip bits.  One error is the least reliable bit, the other t
+	//  errors get reliability 128 and all other bits 255.  Flipping the
+	//  first error leaves t errors, and any other codeword differs
+	//  from the word read in at least t bits of reliability 255, so
+	//  the all zeros codeword must be found.  The # of these words
+	//  corrected is left in *pNumT1Corr.  Returns the # of words for
+	//  which the two decodes did not match.
+	//****************************************************************
+	static unsigned char hardCW[MAXCODEWDBYTES];
+	int kx,jx,ix,numErrs,numBits,numMis,status,errFlg,bitLoc[MAXCORR+1];
+
+	numBits=gblCodec.numDataBits+gblCodec.numRedunBits;
+	numMis=0;
+	for (kx=0;kx<numCWs;kx++){
+		clearWriteCW();
+		numErrs=rand()%(gblCodec.tParm+2);
+		for (jx=0;jx<numErrs;jx++){
+			ix=rand()%numBits;
+			gblCodeword[ix/8]^=(unsigned char)(0x80>>(ix%8));
+		}
+		for (jx=0;jx<numBits;jx++){
+			gblReliab[jx]=(unsigned char)(rand()%256);
+		}
+		for (jx=0;jx<gblCodec.numCodewordBytes;jx++){
+			hardCW[jx]=gblCodeword[jx];
+		}
+		status=bchDecode(&gblCodec,hardCW,&gblScratch,&errFlg);
+		if (bchDecodeChase(&gblCodec,gblCodeword,gblReliab,0,&gblScratch,&errFlg)!=status){
+			numMis++;
+			continue;
+		}
+		for (jx=0;jx<gblCodec.numCodewordBytes && gblCodeword[jx]==hardCW[jx];jx++){
+		}
+		if (jx<gblCodec.numCodewordBytes){
+			numMis++;
+		}
+	}
+	*pNumT1Corr=0;
+	for (kx=0;kx<numCWs;kx++){
+		clearWriteCW();
+		for (jx=0;jx<numBits;jx++){
+			gblReliab[jx]=255;
+		}
+		flipDistinctBits(gblCodec.tParm+1,bitLoc);
+		for (jx=0;jx<=gblCodec.tParm;jx++){
+			gblReliab[bitLoc[jx]]=(unsigned char)((jx==0) ? 0 : 128);
+		}
+		if (bchDecodeChase(&gblCodec,gblCodeword,gblReliab,CHASECHKBITS,
+			&gblScratch,&errFlg)!=CORR){
+			continue;
+		}
+		for (jx=0;jx<gblCodec.numCodewordBytes && gblCodeword[jx]==0;jx++){
+		}
+		if (jx==gblCodec.numCodewordBytes){
+			(*pNumT1Corr)++;
+		}
 	}
-	printf("\n");
-	//printf("\n");
+	return(numMis);
 }
 
-static void printOrigCodeword()
+static int chkKeyEq(int numCWs)
 {
 	//****************************************************************
-	//	Function: printOrigCodeword
+	//	Function: chkKeyEq
 	//
-	//  Print the encoded codeword as it was before errors were applied
+	//	Function to check riBM against berMas.  numCWs words of 1 to t+1
+	//  different random bit errors on the all zeros codeword are made,
+	//  and the ELP of each is computed by berMas and by riBM at each
+	//  width this CPU runs (1, and 32 and 64 terms per step with AVX2
+	//  and AVX-512BW).  The error flags must be the same, and if they
+	//  are 0 so must Ln and sigmaN(0..Ln).  With BERMASERR set the ELP
+	//  is not used, and its degree may differ (riBM can give Ln>t).
+	//  Returns the # of ELPs that differ.
 	//****************************************************************
-	int kx;
+	static struct BchCodec ribmCdc;
+	int kx,jx,wx,Ln,ribmLn,errFlg,ribmErrFlg,numMis;
+	int bitLoc[MAXCORR+1],sigmaN[MAXCORR+1],ribmSigmaN[MAXCORR+1];
+	struct BchIoVec dataVec,parityVec;
+	const int lanes[3]={1,32,64};
+	const int features[3]={0,CPUAVX2,CPUAVX512BW};
 
-	printf("\n\nCodeword after encoding = \n");
-	for (kx=0;kx<gblNumDataBytes+gblNumRedunBytes;kx++){
-		printf("%x-",gblCodewordSav[kx]);
-		if (kx % 20 == 19){
-			printf("\n");
+	ribmCdc=gblCodec; // Shares the tables, only keyEqLanes is changed
+	ribmCdc.keyEqSolver=KEYEQRIBM;
+	dataVec.base=gblCodeword;
+	dataVec.len=gblCodec.numDataBytes;
+	parityVec.base=&gblCodeword[gblCodec.numDataBytes];
+	parityVec.len=gblCodec.numRedunBytes;
+	numMis=0;
+	for (kx=0;kx<numCWs;kx++){
+		clearWriteCW();
+		flipDistinctBits(1+rand()%(gblCodec.tParm+1),bitLoc);
+		(void)computeRemainder(&gblCodec,&dataVec,1,&parityVec,1,gblScratch.remainBytes);
+		computeSyndromes(gblScratch.syndromes,gblCodec.numRedunBytes,gblScratch.remainBytes,
+			gblCodec.alogTbl,gblCodec.logTbl,gblCodec.nParm,gblCodec.tParm);
+		errFlg=0;
+		Ln=berMas(&gblCodec,sigmaN,gblScratch.syndromes,&errFlg);
+		for (wx=0;wx<3;wx++){
+			if (wx>0 && (BCHX86SIMD==0 || (cpuFeatures() & features[wx])==0)){
+				continue;
+			}
+			ribmCdc.keyEqLanes=lanes[wx];
+			ribmErrFlg=0;
+			ribmLn=riBM(&ribmCdc,ribmSigmaN,gblScratch.syndromes,&ribmErrFlg);
+			if (ribmErrFlg!=errFlg){
+				numMis++;
+				continue;
+			}
+			for (jx=0;jx<=Ln && ribmLn==Ln && ribmSigmaN[jx]==sigmaN[jx];jx++){
+			}
+			if (errFlg==0 && (ribmLn!=Ln || jx<=Ln)){
+				numMis++;
+			}
 		}
 	}
-	printf("\n");
+	return(numMis);
 }
 
-static void printCodeword()
+static int chkFfKernels(int numVecs)
 {
 	//****************************************************************
-	//	Function: printCodeword
+	//	Function: chkFfKernels
+	//
+	//	Function to check the GF(2^m) batch kernels against ffMult.
+	//  numVecs vectors of 0 to 3*BATCHEVALPTS random elements (zeros
+	//  included, so the lengths are mostly not a multiple of the 8 or
+	//  32 elements of a SIMD step) are run through ffMultBatch,
+	//  ffMultConstBatch, ffSquareBatch and ffPolyEvalBatch (a random
+	//  polynomial of degree 0 to t) with the kernels gblCodec picked
+	//  and again with the log and alog tables only.  Every result must
+	//  be the product, square or Horner's rule done with ffMult.
+	//  Returns the # of vectors for which a kernel differs.
 	//****************************************************************
-	int kx;
+	static struct BchCodec tblCdc;
+	static FfElem opa[3*BATCHEVALPTS],opb[3*BATCHEVALPTS],res[3*BATCHEVALPTS];
+	int vx,ix,jx,px,num,c,deg,val,misFlg,numMis,coef[MAXCORR+1];
+	const struct BchCodec *pCdc;
 
-	printf("\n\nCodeword after correction = \n");
-	for (kx=0;kx<gblNumDataBytes+gblNumRedunBytes;kx++){
-		printf("%x-",gblCodeword[kx]);
-		if (kx % 20 == 19){
-			printf("\n");
+	tblCdc=gblCodec; // Shares the tables, only ffKernelFeatures is changed
+	tblCdc.ffKernelFeatures=0;
+	numMis=0;
+	for (px=0;px<2;px++){
+		pCdc=(px==0) ? &gblCodec : &tblCdc;
+		for (vx=0;vx<numVecs;vx++){
+			num=rand()%(3*BATCHEVALPTS+1);
+			for (ix=0;ix<num;ix++){
+				opa[ix]=(FfElem)((rand()%8==0) ? 0 : rand()%pCdc->ffSize);
+				opb[ix]=(FfElem)((rand()%8==0) ? 0 : rand()%pCdc->ffSize);
+			}
+			c=(rand()%8==0) ? 0 : rand()%pCdc->ffSize;
+			deg=rand()%(pCdc->tParm+1);
+			for (jx=0;jx<=deg;jx++){
+				coef[jx]=(rand()%8==0) ? 0 : rand()%pCdc->ffSize;
+			}
+			misFlg=0;
+			ffMultBatch(pCdc,opa,opb,res,num);
+			for (ix=0;ix<num;ix++){
+				misFlg|=(res[ix]!=ffMult(pCdc,opa[ix],opb[ix]));
+			}
+			ffMultConstBatch(pCdc,c,opa,res,num);
+			for (ix=0;ix<num;ix++){
+				misFlg|=(res[ix]!=ffMult(pCdc,c,opa[ix]));
+			}
+			ffSquareBatch(pCdc,opa,res,num);
+			for (ix=0;ix<num;ix++){
+				misFlg|=(res[ix]!=ffMult(pCdc,opa[ix],opa[ix]));
+			}
+			ffPolyEvalBatch(pCdc,coef,deg,opa,res,num);
+			for (ix=0;ix<num;ix++){
+				val=coef[deg];
+				for (jx=deg-1;jx>=0;jx--){
+					val=ffMult(pCdc,val,opa[ix])^coef[jx];
+				}
+				misFlg|=(res[ix]!=val);
+			}
+			numMis+=misFlg;
 		}
 	}
-	printf("\n");
+	return(numMis);
 }
 
-static void printRemainBytes()
+static int chkEncodeBatch(int *pNumCWs)
 {
 	//****************************************************************
-	//	Function: printRemainBytes
+	//	Function: chkEncodeBatch
 	//
-	//  Print the remainder bytes
+	//	Function to check bchEncodeBatch against bchEncode.  Batches of
+	//  every size from 1 to ENCODEBATCHCWS-1 codewords, so every # of
+	//  codewords left over after the lane groups is seen, are filled
+	//  with random bytes (stale parity included) and encoded at each
+	//  lane width this CPU runs (1, and 8 and 16 codewords in lockstep
+	//  with AVX2 and AVX-512F).  Each codeword is then encoded again
+	//  with bchEncode and the two must match byte for byte.
+	//  The # of codewords checked is left in *pNumCWs.  Returns the #
+	//  of codewords that differ.
 	//****************************************************************
-	int kx;
+	static struct BchCodec batchCdc;
+	static unsigned char batchBuff[ENCODEBATCHCWS*MAXCODEWDBYTES];
+	unsigned char *batchCWs[ENCODEBATCHCWS];
+	int numCWs,kx,jx,wx,numMis;
+	const int numCWBytes=gblCodec.numCodewordBytes;
+	const int lanes[3]={1,8,16};
+	const int features[3]={0,CPUAVX2,CPUAVX512};
 
-	printf("\nRemainder bytes = \n");
-	for (kx=0;kx<gblNumRedunBytes;kx++){
-		printf("%d-",gblRemainBytes[kx]);
-		if (kx % 20 == 19){
-			printf("\n");
+	batchCdc=gblCodec; // Shares the tables, only encodeLanes is changed
+	numMis=0;
+	*pNumCWs=0;
+	for (wx=0;wx<3;wx++){
+		if (wx>0 && (BCHX86SIMD==0 || (cpuFeatures() & features[wx])==0)){
+			continue;
+		}
+		batchCdc.encodeLanes=lanes[wx];
+		for (numCWs=1;numCWs<ENCODEBATCHCWS;numCWs++){
+			for (kx=0;kx<numCWs;kx++){
+				batchCWs[kx]=&batchBuff[kx*numCWBytes];
+				for (jx=0;jx<numCWBytes;jx++){
+					batchCWs[kx][jx]=(unsigned char)(rand()%BYTESTATES);
+				}
+			}
+			bchEncodeBatch(&batchCdc,batchCWs,numCWs);
+			for (kx=0;kx<numCWs;kx++){
+				for (jx=0;jx<numCWBytes;jx++){
+					gblCodeword[jx]=batchCWs[kx][jx];
+				}
+				bchEncode(&gblCodec,gblCodeword);
+				for (jx=0;jx<numCWBytes && gblCodeword[jx]==batchCWs[kx][jx];jx++){
+				}
+				if (jx<numCWBytes){
+					numMis++;
+				}
+			}
+			*pNumCWs+=numCWs;
 		}
 	}
-	printf("\n");
+	return(numMis);
 }
 
-static void printSyndromes()
+static int sgSplit(struct BchIoVec vec[],unsigned char buff[],int *pBuffAddr,
+				   const unsigned char src[],int numBytes)
 {
 	//****************************************************************
-	//	Function: printSyndromes
+	//	Function: sgSplit
+	//
+	//	Function to copy the numBytes bytes at src to buff from
+	//  *pBuffAddr on, split into at most SGCHKSEGS segments at random
+	//  points, and describe them in vec.  Segments are picked empty or
+	//  one byte long, up to 15 bytes long (so the 64 bit data words of
+	//  the CLMUL engine straddle segments), of any length or the rest.
+	//  A guard byte SGCHKGUARD follows each segment.  *pBuffAddr is
+	//  moved past the last guard byte.  Returns the # of segments.
 	//****************************************************************
-	int kx;
+	int numVecs,srcAddr,len,pick,kx;
 
-	printf("\nSyndromes = \n");
-	for (kx=0;kx<2*gblTParm;kx++){
-		printf("%d-",gblSyndromes[kx]);
-		if (kx % 20 == 19){
-			printf("\n");
+	numVecs=0;
+	srcAddr=0;
+	do{
+		len=numBytes-srcAddr;
+		if (numVecs<SGCHKSEGS-1){
+			switch (rand()%4){
+			case 0:
+				pick=rand()%2;
+				break;
+			case 1:
+				pick=rand()%16;
+				break;
+			case 2:
+				pick=rand()%(len+1);
+				break;
+			default:
+				pick=len;
+				break;
+			}
+			if (pick<len){
+				len=pick;
+			}
 		}
-	}
+		vec[numVecs].base=&buff[*pBuffAddr];
+		vec[numVecs].len=len;
+		for (kx=0;kx<len;kx++){
+			buff[(*pBuffAddr)++]=src[srcAddr++];
+		}
+		buff[(*pBuffAddr)++]=SGCHKGUARD;
+		numVecs++;
+	}while (srcAddr<numBytes);
+	return(numVecs);
 }
 
-static void printLocs()
+static int sgMiscompare(const struct BchIoVec vec[],int numVecs,const unsigned char bytes[],
+						int numBytes)
 {
 	//****************************************************************
-	//	Function: printLocs
+	//	Function: sgMiscompare
 	//
-	//	Function to print error locations
+	//	Returns 1 if the bytes in the segments of vec (see sgSplit) are
+	//  not the numBytes bytes at bytes or a guard byte was written,
+	//  else 0.
 	//****************************************************************
-	int kx,locTmp;
+	int kx;
 
-	printf("\nRaw err locations (alog) (found by root search)(from end of CW) = \n");
-	for (kx=0;kx<gblLnOrig;kx++){
-		printf("%d-",gblLoc[kx]);
-		if (kx % 20 == 19){
-			printf("\n");
-		}
-	}
-	printf("\nRaw err locations (log) (found by root search)(from end of CW) = \n");
-	for (kx=0;kx<gblLnOrig;kx++){
-		printf("%d-",gblLogTbl[gblLoc[kx]]);
-		if (kx % 20 == 19){
-			printf("\n");
+	for (kx=0;kx<numBytes;kx++){
+		if (*ioVecByte(vec,numVecs,kx)!=bytes[kx]){
+			return(1);
 		}
 	}
-	printf("\nAdjusted Err Byte Locations (found by root search)(from front of CW) = \n");
-	for (kx=0;kx<gblLnOrig;kx++){
-		locTmp = ((((gblNumCodewordBytes)*8
-			- gblLogTbl[gblLoc[kx]])-1)%gblNParm)/8;
-		printf("%d-",locTmp);
-		if (kx % 20 == 19){
-			printf("\n");
+	for (kx=0;kx<numVecs;kx++){
+		if (vec[kx].base[vec[kx].len]!=SGCHKGUARD){
+			return(1);
 		}
 	}
+	return(0);
 }
 
-static void printMiscompares()
+static int chkScatterGather(int numCWs,int *pNumChkd)
 {
 	//****************************************************************
-	//	Function: printMiscompares
+	//	Function: chkScatterGather
+	//
+	//	Function to check bchEncodeSg and bchDecodeSg against bchEncode
+	//  and bchDecode.  numCWs codewords of random data are split at
+	//  random points into data and parity segments (see sgSplit) and
+	//  encoded both ways - the parity must match.  Then 0 to t+1
+	//  different random bit errors are applied, the word is split
+	//  again and decoded both ways - the status, the error flags and
+	//  all the bytes must match, and no guard byte may be written.
+	//  This is done with each remainder engine this CPU runs (the
+	//  table engine, and CLMUL if the CPU has PCLMULQDQ), while
+	//  bchEncode and bchDecode use the engine gblCodec picked.
+	//  The # of words checked is left in *pNumChkd.  Returns the # of
+	//  words for which the two paths differ.
 	//****************************************************************
-	int kx;
+	static struct BchCodec sgCdc;
+	static unsigned char sgBuff[MAXCODEWDBYTES+2*SGCHKSEGS];
+	struct BchIoVec dataVec[SGCHKSEGS],parityVec[SGCHKSEGS];
+	int kx,jx,ex,buffAddr,numDataVecs,numParityVecs,numMis;
+	int status,sgStatus,errFlg,sgErrFlg,bitLoc[MAXCORR+1];
+	const int numDataBytes=gblCodec.numDataBytes;
+	const int numRedunBytes=gblCodec.numRedunBytes;
+	const int engines[2]={REMENGTABLE,REMENGCLMUL};
 
-	for (kx=0;kx<gblNumCodewordBytes;kx++){
-		if (gblCodeword[kx]!=gblCodewordSav[kx]){
-			printf("\nMiscompare - Loc %d  -  Rcvd %x  Expd %x",
-				kx,gblCodeword[kx],gblCodewordSav[kx]);
+	numMis=0;
+	*pNumChkd=0;
+	for (ex=0;ex<2;ex++){
+		sgCdc=gblCodec; // Shares the tables, only the remainder engine is changed
+		sgCdc.remainderEngine=engines[ex];
+		genClmulFoldConsts(&sgCdc);
+		if (sgCdc.remainderEngine!=engines[ex]){
+			continue; // No PCLMULQDQ
+		}
+		*pNumChkd+=numCWs;
+		for (kx=0;kx<numCWs;kx++){
+			for (jx=0;jx<gblCodec.numCodewordBytes;jx++){
+				gblCodeword[jx]=(unsigned char)(rand()%BYTESTATES);
+			}
+			buffAddr=0;
+			numDataVecs=sgSplit(dataVec,sgBuff,&buffAddr,gblCodeword,numDataBytes);
+			numParityVecs=sgSplit(parityVec,sgBuff,&buffAddr,&gblCodeword[numDataBytes],
+				numRedunBytes);
+			bchEncode(&gblCodec,gblCodeword);
+			if (bchEncodeSg(&sgCdc,dataVec,numDataVecs,parityVec,numParityVecs)!=0 ||
+				sgMiscompare(parityVec,numParityVecs,&gblCodeword[numDataBytes],
+				numRedunBytes)!=0){
+				numMis++;
+				continue;
+			}
+			flipDistinctBits(rand()%(gblCodec.tParm+2),bitLoc);
+			buffAddr=0;
+			numDataVecs=sgSplit(dataVec,sgBuff,&buffAddr,gblCodeword,numDataBytes);
+			numParityVecs=sgSplit(parityVec,sgBuff,&buffAddr,&gblCodeword[numDataBytes],
+				numRedunBytes);
+			status=bchDecode(&gblCodec,gblCodeword,&gblScratch,&errFlg);
+			sgStatus=bchDecodeSg(&sgCdc,dataVec,numDataVecs,parityVec,numParityVecs,
+				&gblScratch,&sgErrFlg);
+			if (sgStatus!=status || sgErrFlg!=errFlg ||
+				sgMiscompare(dataVec,numDataVecs,gblCodeword,numDataBytes)!=0 ||
+				sgMiscompare(parityVec,numParityVecs,&gblCodeword[numDataBytes],
+				numRedunBytes)!=0){
+				numMis++;
+			}
 		}
 	}
+	return(numMis);
 }
+
 static struct statAndFCnt bchEval(int CWsPerPass,
 								  unsigned int mySeed, int randomDataFlg,
 								  int doCompareFlg,int *pErrFlg,
@@ -2909,7 +9364,7 @@ static struct statAndFCnt bchEval(int CWsPerPass,
 	//	Function to test the bch encoding and decoding functions
 	//***************************************************************
 	int dcdStatus,statusExpd,evalStatus;
-	int numErrsSimed,misCompareCnt,CWCntr;
+	int numErrsSimed,misCompareCnt,CWCntr,kx;
 	struct statAndFCnt statusAndFCnt;
 
 	//*********************BEGIN PASS LOOP**********************
@@ -2923,8 +9378,18 @@ static struct statAndFCnt bchEval(int CWsPerPass,
 			// Generate a random data record
 			genWriteData();
 			// Encode the random data record
-			bchEncode(gblEncodeTbl,gblCodeword,gblNumRedunWords,
-				gblNumRedunBytes,gblNumDataBytes);
+#if FIXEDCODES
+			if (gblFixedCode!=0){
+				gblFixedCode->encode(gblCodeword);
+			}
+			else
+#endif
+			bchEncode(&gblCodec,gblCodeword);
+			// Rewrite part of the data and update the parity for it
+			if (gblUpdParityFlg==1 && chkUpdateParity()!=0){
+				evalStatus=UPDPARITYERR;
+				break;
+			}
 		}
 		else {
 			// Clear the write codeword
@@ -2936,20 +9401,35 @@ static struct statAndFCnt bchEval(int CWsPerPass,
 		statusExpd=0;
 		// Go pick and apply random errors
 		numErrsSimed=applyErrors(minErrsToSim,maxErrsToSim);
-		if (numErrsSimed>gblTParm){
+		if (numErrsSimed>gblCodec.tParm){
 			statusExpd=UNCORR;
 		}
-		else if (numErrsSimed>=1 && numErrsSimed<=gblTParm){
+		else if (numErrsSimed>=1 && numErrsSimed<=gblCodec.tParm){
 			statusExpd=CORR;
 		}
 		else {
 			statusExpd=ERRFREE;
 		}
-		dcdStatus=bchDecode(gblLoc,gblAlogTbl,gblLogTbl,gblFFSize,gblTParm,
-			gblNumCodewordBytes,gblNParm,gblMParmOdd,
-			gblNumDataBits,gblNumRedunBits,gblCodeword,
-			gblNumRedunWords,gblNumRedunBytes,gblNumDataBytes,gblEncodeTbl,
-			gblRemainBytes,gblSyndromes,pErrFlg,gblLogZVal,gblMParm,gblFFSize);   //  *****DECODE*****
+		if (doCompareFlg==1){
+			// Save the received codeword - UNCORR must leave it as it is
+			for (kx=0;kx<gblCodec.numCodewordBytes;kx++){
+				gblCodewordRcvd[kx]=gblCodeword[kx];
+			}
+		}
+#if FIXEDCODES
+		if (gblFixedCode!=0){
+			dcdStatus=gblFixedCode->decode(gblCodeword,&gblScratch,pErrFlg); // *****DECODE*****
+		}
+		else
+#endif
+		if (gblChaseFlg==1){
+			genReliab();
+			dcdStatus=bchDecodeChase(&gblCodec,gblCodeword,gblReliab,gblChaseBits,
+				&gblScratch,pErrFlg);											//  *****DECODE*****
+		}
+		else {
+			dcdStatus=bchDecode(&gblCodec,gblCodeword,&gblScratch,pErrFlg);   //  *****DECODE*****
+		}
 		if (dcdStatus==UNCORR && statusExpd<UNCORR){
 			//		Return error
 			evalStatus=(UNCORRNOTEXPD+dcdStatus);
@@ -2978,6 +9458,16 @@ static struct statAndFCnt bchEval(int CWsPerPass,
 				evalStatus=(COMPAREERR+dcdStatus);
 				break;
 			}
+			if (dcdStatus==UNCORR){
+				for (kx=0;kx<gblCodec.numCodewordBytes &&
+					gblCodeword[kx]==gblCodewordRcvd[kx];kx++){
+				}
+				if (kx<gblCodec.numCodewordBytes){
+					//		Return error - a partial correction was applied
+					evalStatus=(UNCORRCHGD+dcdStatus);
+					break;
+				}
+			}
 		}
 	}
 	//**********************END LOOP**********************
@@ -2993,6 +9483,8 @@ static void correctCWsFromDisk(int toDoCode,int loopAllCWsCnt)
 	//
 	//	This function is used to correct codewords from disk.
 	//  And on option to write corrected codewords back to disk.
+	//  Codewords are decoded by bchDecodeBatch on a pool of worker
+	//  threads.
 	//****************************************************************
 	static unsigned char fileBuff[MAXFILESIZE];
 	int numDiskCodewords;
@@ -3001,21 +9493,24 @@ static void correctCWsFromDisk(int toDoCode,int loopAllCWsCnt)
 	time_t timeStart,timeEnd; // "time_t" is a "typedef" defined in "time.h"
 	//                This is in "time.h" -> "typedef long time_t;"
 	FILE *infp,*outfp; // --type FILE--    File pointers
-	int k1,k2,loops,junk,tmp,errFlg;
-	int dcdStatus,errFreeCnt,correctableCnt,unCorrectableCnt;
+	int loops,junk,tmp,numThreads;
+	int errFreeCnt,correctableCnt,unCorrectableCnt,statusCnt[3];
 	size_t count,readLength,writeLength,numElements;
+	struct BchDecodePool pool;
 	//
-	errFlg=0;
-	// These three initializations are to make "PC lint" happy
+	// These initializations are to make "PC lint" happy
 	errFreeCnt=0;
 	correctableCnt=0;
 	unCorrectableCnt=0;
+	statusCnt[ERRFREE]=0;
+	statusCnt[CORR]=0;
+	statusCnt[UNCORR]=0;
 	do{
 		printf("\nEnter # CWs to read and correct from disk.");
 		printf("\nMust be less than or eq # CWs on disk and # CWs * CW length");
 		printf("\nin bytes must be less than or eq to %d.\n",MAXFILESIZE);
 		(void)scanf_s("%d", &numDiskCodewords);
-		tmp=numDiskCodewords*gblNumCodewordBytes;
+		tmp=numDiskCodewords*gblCodec.numCodewordBytes;
 	}while (numDiskCodewords<1 || tmp>MAXFILESIZE);
 	do {
 		printf("\nEnter file path and name for READING - Example - C://Folder/File.bin.\n");
@@ -3034,7 +9529,7 @@ static void correctCWsFromDisk(int toDoCode,int loopAllCWsCnt)
 		(void)scanf_s("%d",&junk);
 		return;
 	}
-	readLength=(size_t)(numDiskCodewords*gblNumCodewordBytes);
+	readLength=(size_t)(numDiskCodewords*gblCodec.numCodewordBytes);
 	numElements=1;
 	count=fread(fileBuff,readLength,numElements,infp);//No "&" - its already an addr
 	if (count!=numElements){
@@ -3047,45 +9542,39 @@ static void correctCWsFromDisk(int toDoCode,int loopAllCWsCnt)
 		return;
 	}
 	fclose(infp);
-	printf( "\nBUSY - Correcting codewords from disk.\n\n");
+	do{
+		printf("\nEnter # of decode threads (1 to %d).",MAXDECODETHREADS);
+		printf("\nEnter 0 to use one thread per hardware thread (%d).\n",
+			(int)std::thread::hardware_concurrency());
+		(void)scanf_s("%d", &numThreads);
+	}while (numThreads<0 || numThreads>MAXDECODETHREADS);
+	if (bchDecodePoolStart(&pool,&gblCodec,numThreads)!=0){
+		printf("\n*****UNABLE TO ALLOCATE DECODE WORKER STORAGE*****\n");
+		printf("\n-----ENTER ANY NUMBER TO EXIT-----\n");
+		(void)scanf_s("%d",&junk);
+		return;
+	}
+	printf( "\nBUSY - Correcting codewords from disk on %d threads.\n\n",pool.numThreads);
 	(void)time( &timeStart ); // Get current time
 	for (loops=1;loops<=loopAllCWsCnt;loops++){
-		errFreeCnt=0;
-		correctableCnt=0;
-		unCorrectableCnt=0;
-		for (k1=0;k1<=numDiskCodewords-1;k1++){
-			for (k2=0;k2<gblNumCodewordBytes;k2++){
-				// Copy CW from gblFileBuff to global CW array
-				gblCodeword[k2]=fileBuff[k1*gblNumCodewordBytes+k2];
-			}
-			dcdStatus=bchDecode(gblLoc,gblAlogTbl,gblLogTbl,gblFFSize,gblTParm,
-				gblNumCodewordBytes,gblNParm,gblMParmOdd,
-				gblNumDataBits,gblNumRedunBits,gblCodeword,
-				gblNumRedunWords,gblNumRedunBytes,gblNumDataBytes,gblEncodeTbl,
-				gblRemainBytes,gblSyndromes,&errFlg,gblLogZVal,gblMParm,gblFFSize);
-			if (toDoCode==2) { // If to write corrected CWs back to disk
-				for (k2=0;k2<gblNumCodewordBytes;k2++){
-					// Copy corrected CW array back to gblFileBuff
-					fileBuff[k1*gblNumCodewordBytes+k2]=(unsigned char)gblCodeword[k2];
-				}
-			}
-			if (loops==loopAllCWsCnt && dcdStatus==0){
-				errFreeCnt++;
-			}
-			if (loops==loopAllCWsCnt && dcdStatus==1){
-				correctableCnt++;
-			}
-			if (loops==loopAllCWsCnt && dcdStatus==2){
-				unCorrectableCnt++;
-			}
-		}
-	}
+		// Codewords are corrected in place in fileBuff, without staging
+		// copies, only if they are to be written to disk.  Otherwise
+		// fileBuff is left as read.
+		bchDecodeBatch(&pool,fileBuff,numDiskCodewords,(toDoCode==2) ? 1 : 0,
+			statusCnt,&gblScratch);
+	}
+	bchDecodePoolStop(&pool);
+	errFreeCnt=statusCnt[ERRFREE];
+	correctableCnt=statusCnt[CORR];
+	unCorrectableCnt=statusCnt[UNCORR];
 	(void)time( &timeEnd ); // Get current time
 	printf("Elapsed Time in Seconds   - %d\n\n",(int)(timeEnd-timeStart));
 	printf("-----Error counts for the last loop follow.-----\n");
 	printf("Error Free Count = %d \n",errFreeCnt);
 	printf("Correctable Error Count = %d \n",correctableCnt);
 	printf("unCorrectable Error Count = %d \n",unCorrectableCnt);
+	printf("gblBerMasUCECntr %d gblRootFindUCECntr %d gblFixErrorsUCECntr %d (all loops)\n",
+		gblScratch.berMasUCECntr,gblScratch.rootFindUCECntr,gblScratch.fixErrorsUCECntr);
 	if (toDoCode==2){
 		// ############ WRITE THE OUTPUT FILE #####################################
 		do {
@@ -3127,6 +9616,188 @@ static void correctCWsFromDisk(int toDoCode,int loopAllCWsCnt)
 	(void)scanf_s("%d",&junk);
 	return;
 }
+//
+// An instance of this structure describes one read or write of a chunk of
+// codewords that runs on its own thread while another chunk is decoded.
+struct StreamIoJob {
+	FILE *fp;
+	unsigned char *buff;
+	size_t length;				// # bytes to read or write
+	size_t count;				// # bytes actually read or written
+};
+
+static void streamReadChunk(struct StreamIoJob *pJob)
+{
+	//****************************************************************
+	//	Function: streamReadChunk
+	//****************************************************************
+	pJob->count=fread(pJob->buff,1,pJob->length,pJob->fp);
+}
+
+static void streamWriteChunk(struct StreamIoJob *pJob)
+{
+	//****************************************************************
+	//	Function: streamWriteChunk
+	//****************************************************************
+	pJob->count=fwrite(pJob->buff,1,pJob->length,pJob->fp);
+}
+
+static void streamCWsFromDisk()
+{
+	//****************************************************************
+	//	Function: streamCWsFromDisk
+	//
+	//	This function corrects a file of codewords of any size and
+	//  streams the corrected codewords to a new file.  The file is
+	//  processed in chunks using three rotating buffers.  While one
+	//  chunk is decoded (by bchDecodeBatch), the next chunk is read
+	//  and the previous chunk is written on two I/O threads.  Memory
+	//  use is fixed at 3*STREAMCHUNKBYTES whatever the file size.
+	//
+	//  If the file length is not a multiple of the codeword length,
+	//  the bytes past the last whole codeword are copied unchanged.
+	//****************************************************************
+	static unsigned char streamBuff[3][STREAMCHUNKBYTES];
+	size_t chunkLength,buffLength[3],wrtLength;
+	char inFileName[100];
+	char outFileName[100];
+	time_t timeStart,timeEnd;
+	FILE *infp,*outfp; // --type FILE--    File pointers
+	struct StreamIoJob rdJob,wrtJob;
+	std::thread rdThrd,wrtThrd;
+	int cur,nxt,wrtIdx,junk,numThreads,numCWs,ioErr,statusCnt[3];
+	long long numCWsTotal,errFreeCnt,correctableCnt,unCorrectableCnt;
+	struct BchDecodePool pool;
+
+	chunkLength=(size_t)(STREAMCHUNKBYTES/gblCodec.numCodewordBytes)*gblCodec.numCodewordBytes;
+	do {
+		printf("\nEnter file path and name for READING - Example - C://Folder/File.bin.\n");
+		// Was unsuccessful in using scanf_s at this point
+		(void)scanf("%s", inFileName); // No "&" - already addr
+		infp=fopen(inFileName,"rb");
+		if (infp==0){
+			printf("*****OPEN ERROR ON READ INPUT FILE*****\n");
+		}
+	} while (infp==0);
+	printf("The program will read from - %s.\n",inFileName);
+	do {
+		printf("\nEnter file path and name for WRITING - Example - C://Folder/File.bin.");
+		printf("\nThe file must be a new file - existing files will not be overwritten.\n");
+		// Was unsuccessful in using scanf_s at this point
+		(void)scanf("%s", outFileName);// No "&" - already addr of array
+		outfp=fopen(outFileName,"rb"); // See if file for writing exists already
+		if (outfp!=0){ // If the file for writing already exists
+			fclose(outfp);
+			printf("\n*****FILE FOR WRITING EXISTS ALREADY*****\n");
+			outfp=0; // Do this so we will repeat the do-while loop
+		}
+		else {
+			outfp=fopen(outFileName,"wb");
+			if (outfp==0){
+				printf("\n*****OPEN ERROR ON FILE FOR WRITING*****\n");
+			}
+		}
+	} while (outfp==0);
+	do{
+		printf("\nEnter # of decode threads (1 to %d).",MAXDECODETHREADS);
+		printf("\nEnter 0 to use one thread per hardware thread (%d).\n",
+			(int)std::thread::hardware_concurrency());
+		(void)scanf_s("%d", &numThreads);
+	}while (numThreads<0 || numThreads>MAXDECODETHREADS);
+	if (bchDecodePoolStart(&pool,&gblCodec,numThreads)!=0){
+		printf("\n*****UNABLE TO ALLOCATE DECODE WORKER STORAGE*****\n");
+		fclose(infp);
+		fclose(outfp);
+		printf("\n-----ENTER ANY NUMBER TO EXIT-----\n");
+		(void)scanf_s("%d",&junk);
+		return;
+	}
+	printf( "\nBUSY - Streaming and correcting codewords from disk on %d threads.\n\n",
+		pool.numThreads);
+	(void)time( &timeStart ); // Get current time
+	numCWsTotal=0;
+	errFreeCnt=0;
+	correctableCnt=0;
+	unCorrectableCnt=0;
+	statusCnt[ERRFREE]=0;
+	statusCnt[CORR]=0;
+	statusCnt[UNCORR]=0;
+	ioErr=0;
+	rdJob.fp=infp;
+	wrtJob.fp=outfp;
+	buffLength[0]=fread(streamBuff[0],1,chunkLength,infp);
+	wrtIdx=0;
+	wrtLength=0; // Nothing to write on the first pass
+	for (cur=0;buffLength[cur]>0 || wrtLength>0;cur=nxt){
+		nxt=(cur+1)%3;
+		// Start the read of the next chunk unless the end of file was reached
+		buffLength[nxt]=0;
+		if (buffLength[cur]==chunkLength){
+			rdJob.buff=streamBuff[nxt];
+			rdJob.length=chunkLength;
+			rdThrd=std::thread(streamReadChunk,&rdJob);
+		}
+		// Start the write of the previous chunk
+		if (wrtLength>0){
+			wrtJob.buff=streamBuff[wrtIdx];
+			wrtJob.length=wrtLength;
+			wrtThrd=std::thread(streamWriteChunk,&wrtJob);
+		}
+		// Decode the current chunk in place while the I/O is in progress
+		numCWs=(int)(buffLength[cur]/gblCodec.numCodewordBytes);
+		if (numCWs>0){
+			bchDecodeBatch(&pool,streamBuff[cur],numCWs,1,statusCnt,&gblScratch);
+			numCWsTotal+=numCWs;
+			errFreeCnt+=statusCnt[ERRFREE];
+			correctableCnt+=statusCnt[CORR];
+			unCorrectableCnt+=statusCnt[UNCORR];
+		}
+		if (buffLength[cur]%gblCodec.numCodewordBytes!=0){
+			printf("\nFile length is not a multiple of the codeword length.");
+			printf("\nThe last %d bytes were copied unchanged.\n",
+				(int)(buffLength[cur]%gblCodec.numCodewordBytes));
+		}
+		if (rdThrd.joinable()){
+			rdThrd.join();
+			buffLength[nxt]=rdJob.count;
+		}
+		if (wrtThrd.joinable()){
+			wrtThrd.join();
+			if (wrtJob.count!=wrtLength){
+				ioErr=1;
+				printf("\nFile write error");
+			}
+		}
+		if (ioErr!=0){
+			break;
+		}
+		wrtIdx=cur;
+		wrtLength=buffLength[cur];
+	}
+	if (ferror(infp)){
+		ioErr=1;
+		printf("\nFile read error");
+	}
+	bchDecodePoolStop(&pool);
+	fclose(infp);
+	fclose(outfp);
+	(void)time( &timeEnd ); // Get current time
+	printf("Elapsed Time in Seconds   - %d\n\n",(int)(timeEnd-timeStart));
+	if (ioErr!=0){
+		printf("\n*****THE OUTPUT FILE IS INCOMPLETE*****\n");
+	}
+	printf("-----Error counts follow.-----\n");
+	printf("Codeword Count = %lld \n",numCWsTotal);
+	printf("Error Free Count = %lld \n",errFreeCnt);
+	printf("Correctable Error Count = %lld \n",correctableCnt);
+	printf("unCorrectable Error Count = %lld \n",unCorrectableCnt);
+	printf("gblBerMasUCECntr %d gblRootFindUCECntr %d gblFixErrorsUCECntr %d\n",
+		gblScratch.berMasUCECntr,gblScratch.rootFindUCECntr,gblScratch.fixErrorsUCECntr);
+	printf("\n************ DONE - ENTER ANY NUMBER TO EXIT ***********\n");
+	(void)scanf_s("%d",&junk);
+	return;
+}
+
 static void wrtTestCWsToDisk(int randomDataFlg,int minErrsToSim, int maxErrsToSim)
 {
 	//****************************************************************
@@ -3139,7 +9810,8 @@ static void wrtTestCWsToDisk(int randomDataFlg,int minErrsToSim, int maxErrsToSi
 	int numDiskCodewords;
 	char outFileName[100];
 	FILE *outfp; // --type FILE--    Output file pointer
-	int k1,k2,junk,tmp;
+	unsigned char *batchCWs[ENCODEBATCHCWS];
+	int k1,k2,junk,tmp,numBatchCWs;
 	size_t count,writeLength,numElements;
 	time_t timeForSeed;
 	do{
@@ -3147,7 +9819,7 @@ static void wrtTestCWsToDisk(int randomDataFlg,int minErrsToSim, int maxErrsToSi
 		printf("\n(The # of CWs) * (CW length)in bytes must be less than");
 		printf("\nor eq to %d.\n",MAXFILESIZE);
 		(void)scanf_s("%d", &numDiskCodewords);
-		tmp=numDiskCodewords*gblNumCodewordBytes;
+		tmp=numDiskCodewords*gblCodec.numCodewordBytes;
 	}while (numDiskCodewords<1 || tmp>MAXFILESIZE);
 	// #########################################################################
 	// THIS LOOP ENCODES ALL THE TEST CODEWORDS TO WRITE TO DISK
@@ -3158,20 +9830,39 @@ static void wrtTestCWsToDisk(int randomDataFlg,int minErrsToSim, int maxErrsToSi
 		if (randomDataFlg==1){
 			// Generate a random data record
 			genWriteData();
-			// Encode the random data record
-			bchEncode(gblEncodeTbl,gblCodeword,gblNumRedunWords,
-				gblNumRedunBytes,gblNumDataBytes);
 		}
 		else {
 			// Clear the write codeword
 			clearWriteCW();//The all 0's CW is a valid CW, no need encode this path
 		}
+		for (k2=0;k2<gblCodec.numCodewordBytes;k2++){
+			// Copy data CW array to the file buffer
+			fileBuff[k1*gblCodec.numCodewordBytes+k2]=gblCodeword[k2];
+		}
+	}
+	if (randomDataFlg==1){
+		// Encode the random data records in the file buffer in batches
+		for (k1=0;k1<numDiskCodewords;k1+=numBatchCWs){
+			numBatchCWs=numDiskCodewords-k1;
+			if (numBatchCWs>ENCODEBATCHCWS){
+				numBatchCWs=ENCODEBATCHCWS;
+			}
+			for (k2=0;k2<numBatchCWs;k2++){
+				batchCWs[k2]=&fileBuff[(k1+k2)*gblCodec.numCodewordBytes];
+			}
+			bchEncodeBatch(&gblCodec,batchCWs,numBatchCWs);
+		}
+	}
+	for (k1=0;k1<=numDiskCodewords-1;k1++){
+		for (k2=0;k2<gblCodec.numCodewordBytes;k2++){
+			gblCodeword[k2]=fileBuff[k1*gblCodec.numCodewordBytes+k2];
+		}
 		// Go pick and apply random errors
 		(void)applyErrors(minErrsToSim,maxErrsToSim);
 		// We have a test codeword, now put it in the file buffer
-		for (k2=0;k2<gblNumCodewordBytes;k2++){
+		for (k2=0;k2<gblCodec.numCodewordBytes;k2++){
 			// Copy test CW array to the file buffer
-			fileBuff[k1*gblNumCodewordBytes+k2]=(unsigned char)gblCodeword[k2];
+			fileBuff[k1*gblCodec.numCodewordBytes+k2]=gblCodeword[k2];
 		}
 	}
 	// Finished putting all the test CWs in the file buffer
@@ -3198,7 +9889,7 @@ static void wrtTestCWsToDisk(int randomDataFlg,int minErrsToSim, int maxErrsToSi
 	printf("\n**** IF YOU DO NOT WANT TO WRITE THIS FILE, TERMINATE THIS PROGRAM ****");
 	printf("\n**** IF YOU WISH TO WRITE THE FILE - ENTER ANY NUMBER ****\n");
 	(void)scanf_s("%d", &junk);
-	writeLength=(size_t)(numDiskCodewords*gblNumCodewordBytes);
+	writeLength=(size_t)(numDiskCodewords*gblCodec.numCodewordBytes);
 	numElements=1;
 	count=fwrite(fileBuff,writeLength,numElements,outfp);//No "&" - already addr
 	if (count!=numElements){
@@ -3234,8 +9925,11 @@ int main()
 	int kx,junk,initStatus,evalStatus,toDoCode,failCWCnt;
 	int accumMisCorrCnt,passesToDo,CWsPerPass,tmp,tmpMax;
 	int randomDataFlg,doCompareFlg,printTblsFlg,passCntr;
-	int loopAllCWsCnt,errFlg;
+	int loopAllCWsCnt,errFlg,saveTblFlg;
 	int minErrsToSim,maxErrsToSim;
+	int mParm,ffPoly,tParm,numDataBytes,rootFindOption,keyEqSolver,bitSliceFlg,ffSize;
+	char tblFileName[100];
+	FILE *tblFp;
 
 	unsigned int seed,userSeed;
 
@@ -3265,7 +9959,7 @@ int main()
 	(void)scanf_s("%d",&junk);
 	// Get the major function the program is to perform on this run
 	do{
-		// 0,11,22,33 Trying to avoid toDoCode being confused with any other entry
+		// 0,11,22,33,44 Trying to avoid toDoCode being confused with any other entry
 		printf("\nSELECT THE MAJOR FUNCTION THE PROGRAM IS TO PERFORM ON THIS RUN.");
 		printf("\nEnter ---0--- to generate CWs, apply errors, perform correction,");
 		printf("\nand report elapsed time.");
@@ -3274,9 +9968,11 @@ int main()
 		printf("\nEnter ---22--- to read CWs from disk, perform correction, and");
 		printf("\nwrite the corrected CWs back to a new file on disk.");
 		printf("\nEnter ---33--- to generate test CWs and write them to a new");
-		printf("\nfile on disk.\n");
+		printf("\nfile on disk.");
+		printf("\nEnter ---44--- to stream CWs from a file of any size, perform");
+		printf("\ncorrection, and stream the corrected CWs to a new file on disk.\n");
 		(void)scanf_s("%d", &toDoCode);
-	}while ((toDoCode/10>3 || toDoCode/10<0) || ((toDoCode/10)!=(toDoCode % 10)));
+	}while ((toDoCode/10>4 || toDoCode/10<0) || ((toDoCode/10)!=(toDoCode % 10)));
 	toDoCode=toDoCode % 10;
 	if (toDoCode==0){
 		printf("\nAt the end of each pass the pgm will print pass info.  This info");
@@ -3297,63 +9993,66 @@ int main()
 		do{
 			printf("\nEnter 0 to use the fast Chien search root finder.");
 			printf("\nEnter 1 to use the Berlekamp trace (BTA) root finder.");
+			printf("\nEnter 2 to use the SIMD (AVX2/AVX-512) Chien search root finder.");
+			printf("\nEnter 3 to use the constant multiplier table Chien search.");
+			printf("\nEnter 4 to use the table Chien search if its tables fit in");
+			printf("\ncache, else the SIMD Chien search.");
+			printf("\nEnter 5 to use the affine (linearized) polynomial root finder.");
+			printf("\nEnter 6 to time the root finders at startup and use the");
+			printf("\nfastest one for each ELP degree.");
+			printf("\nEnter 7 to evaluate the ELP at every codeword position with");
+			printf("\nthe GF(2^m) batch kernels (VPCLMULQDQ if the CPU has it).");
 			printf("\nYou may need to test with both to determine which one best");
 			printf("\nfits your requirement. As an example, the BTA algorithm");
 			printf("\nis faster for a data block size of 1024 bytes and");
 			printf("\nGF(2^14)and for between 6 and 64 errors occurring. I have");
 			printf("\nnot performed timing tests ourside that range.\n");
-			(void)scanf_s("%d", &gblRootFindOption);
-		}while (gblRootFindOption < 0 || gblRootFindOption>1);
+			(void)scanf_s("%d", &rootFindOption);
+		}while (rootFindOption<ROOTFINDCHIEN || rootFindOption>=ROOTFINDOPTIONS);
+		do{
+			printf("\nEnter 0 to compute the ELP with Berlekamp-Massey (berMas).");
+			printf("\nEnter 1 to use the inversionless riBM, SIMD if the CPU has");
+			printf("\nAVX2 or AVX-512BW (checked against berMas at startup).\n");
+			(void)scanf_s("%d", &keyEqSolver);
+		}while (keyEqSolver!=KEYEQBERMAS && keyEqSolver!=KEYEQRIBM);
 	}else{
-		gblRootFindOption=1; // Should not matter, but set to something
+		rootFindOption=ROOTFINDBTA; // Should not matter, but set to something
+		keyEqSolver=KEYEQSOLVER;
 	}
 	do{
 		printf("\nEnter m of GF(2^m), must be between %d & %d.\n",MINMPARM,MAXMPARM);
-		(void)scanf_s("%d", &gblMParm);
-	}while (gblMParm<MINMPARM || gblMParm > MAXMPARM);
+		(void)scanf_s("%d", &mParm);
+	}while (mParm<MINMPARM || mParm > MAXMPARM);
 	// Compute finite field size
-	gblFFSize=1;
-	for (kx = 1; kx <= gblMParm; kx++){
-		gblFFSize *= 2;
+	ffSize=1;
+	for (kx = 1; kx <= mParm; kx++){
+		ffSize *= 2;
 	}
-	if (gblFFSize > MAXFFSIZE){
+	if (ffSize > MAXFFSIZE){
 		printf("\nffSize > MAXFFSIZE - change the m parameter you entered or ");
 		printf("\nchange MAXMPARM and MAXFFSIZE in the source code and restart.\n");
 		printf("\n************ ENTER ANY NUMBER TO EXIT ***********\n");
 		(void)scanf_s("%d",&junk);
 		return(0);
 	}
-	gblMParmOdd = gblMParm % 2;
-	gblNParm=gblFFSize - 1;	// n = (2^m)-1
 	// Ask if user wishes to specify the primitive polynomial for the finite field
-	// Added next line 9-9-2010
-	gblLogZVal=2*gblNParm;
 	do{
 		printf("\nEnter primitive polynomial in decimal (Example- enter 67 for 1000011).");
 		printf("\nEnter 0 to have pgm select the primitive poly.\n");
-		(void)scanf_s("%d",&gblFFPoly);
-	}while ((gblFFPoly<=gblFFSize || gblFFPoly>=gblFFSize*2) && gblFFPoly!=0);
-	if (gblFFPoly>0 && (gblFFPoly<=gblFFSize || gblFFPoly>=2*gblFFSize)){
-		printf("\nThe primitive polynomial you entered is not a valid polynomial\n");
-		printf("\nof degree m (you entered m above).  Restart and try again.\n");
-		printf("\n************ ENTER ANY NUMBER TO EXIT ***********\n");
-		(void)scanf_s("%d",&junk);
-		return(0);
-	}
+		(void)scanf_s("%d",&ffPoly);
+	}while ((ffPoly<=ffSize || ffPoly>=ffSize*2) && ffPoly!=0);
 	// Get correction capability
 	do{
 		printf("\nEnter 't', the max # of single bit errors the code will be");
 		printf("\ndesigned to correct.  t*m must be < 2^m-1 and t must be less");
 		printf("\nthan or equal to MAXCORR (a define in the source code).\n");
-		(void)scanf_s("%d", &gblTParm);
-	}while (gblTParm > MAXCORR || gblTParm*gblMParm>=gblFFSize);
-	if (gblFFPoly==0){ // gblFFPoly will be greater than 0 if user entered a poly above
-		pickFieldGenPoly(); // PICK FINITE FIELD GENERATOR POLYNOMIAL
-	}
-	printf("\ngblFFPoly=%d  gblFFSize=%d\n",gblFFPoly,gblFFSize);
-	bchInit();  // GENERATE LOG AND ALOG TABLES
-	initStatus = chkLogAlogTbls();
-	if (initStatus>ZERO){
+		(void)scanf_s("%d", &tParm);
+	}while (tParm<1 || tParm > MAXCORR || tParm*mParm>=ffSize);
+	// GENERATE LOG AND ALOG TABLES AND THE CODE GENERATOR POLYNOMIAL (CGP)
+	// - bchCodecInit does this again, this call gives the max data length
+	initStatus=initFieldAndCgp(&gblCodec,mParm,ffPoly,tParm);
+	printf("\ngblFFPoly=%d  gblFFSize=%d\n",gblCodec.ffPoly,gblCodec.ffSize);
+	if (initStatus==LOGALOGBUILDERR){
 		printf("\n***** ERROR IN bchInit. *****  initStatus %d.",initStatus);
 		printf("\nThe polynomial you entered several steps above may be");
 		printf("\nNON-primitive or it may have been entered incorrectly.");
@@ -3362,43 +10061,29 @@ int main()
 		(void)scanf_s("%d",&junk);
 		return(0);
 	}
-	tmp=genCodeGenPoly();// GENERATE CODE GENERATOR POLYNOMIAL (CGP)
-	// Call or previous line will set gblCgpDegree
-	if (tmp!=0){
-		printf("\n***** Fatal error in cgp generation *****  error flag %d.",tmp);
+	if (initStatus!=0){
+		printf("\n***** Fatal error in cgp generation *****  error flag %d.",initStatus);
 		printf("\n************ ENTER ANY NUMBER TO EXIT ***********\n");
 		(void)scanf_s("%d",&junk);
 		return(0);
 	}
-	gblNumRedunBits = gblCgpDegree; //Do not try to make this # evenly divisible by 8
-	gblNumRedunBytes = (gblCgpDegree)/8;
-	if ((gblCgpDegree % 8) >0){
-		gblNumRedunBytes++;
-	}
 	// Get number of data bytes
 	do{
-		tmp=(gblNParm-gblCgpDegree)/8;
+		tmp=(gblCodec.nParm-gblCodec.cgpDegree)/8;
 		printf("\n\nEnter data length in bytes, must be <= %d. \n",tmp);
-		(void)scanf_s("%d", &gblNumDataBytes);
-	}while (gblNumDataBytes>tmp || gblNumDataBytes<0);
-	gblNumCodewordBytes = gblNumDataBytes+gblNumRedunBytes;
-	gblNumDataBits = gblNumDataBytes*8;
-	gblKParm = gblNumDataBits;
-	gblNumRedunWords = gblNumRedunBytes/4;
-	if ((gblNumRedunBytes % 4) >0){
-		gblNumRedunWords++;
-	}
+		(void)scanf_s("%d", &numDataBytes);
+	}while (numDataBytes>tmp || numDataBytes<0);
 	if (toDoCode==0 || toDoCode==3){//If pgm to gen CWs, apply errs, correct, report time
 		do{
-			tmpMax=2*gblTParm;
+			tmpMax=2*gblCodec.tParm;
 			if (MAXERRSTOSIM<tmpMax){
-				tmpMax=MAXERRSTOSIM; // tmpMax is min(MAXERRSTOSIM,2*gblTParm)
+				tmpMax=MAXERRSTOSIM; // tmpMax is min(MAXERRSTOSIM,2*gblCodec.tParm)
 			}
 			printf("\nEnter max # errors to apply.");
 			printf("\nMust be less than or equal to %d.\n",tmpMax);
 			(void)scanf_s("%d", &maxErrsToSim);
 		}while (maxErrsToSim>tmpMax || maxErrsToSim<0);
-		if(maxErrsToSim>gblTParm){
+		if(maxErrsToSim>gblCodec.tParm){
 			printf("\nYou have elected to sim UNCORR as well as CORR errors.\n");
 		}
 		do{
@@ -3431,6 +10116,24 @@ int main()
 			printf("\ncontrol the seed for the 1st pass only, after");
 			printf("\nthat it will be random.\n");
 			(void)scanf_s("%d", &userSeed);
+			do{
+				printf("\nEnter 1 to rewrite a random part of the data of each CW after");
+				printf("\nencoding and update its parity with bchUpdateParity (checked");
+				printf("\nagainst bchEncode), 0 to skip.\n");
+				(void)scanf_s("%d", &gblUpdParityFlg);
+			}while (gblUpdParityFlg!=0 && gblUpdParityFlg!=1);
+		}
+		do{
+			printf("\nEnter 1 for Chase-II soft decision decoding (bchDecodeChase) with");
+			printf("\nsimulated bit reliabilities - the error bits are the least");
+			printf("\nreliable.  Enter 0 for hard decision decoding (bchDecode).\n");
+			(void)scanf_s("%d", &gblChaseFlg);
+		}while (gblChaseFlg!=0 && gblChaseFlg!=1);
+		if (gblChaseFlg==1){
+			do{
+				printf("\nEnter the # of least reliable bits to flip, 0 to %d.\n",MAXCHASEBITS);
+				(void)scanf_s("%d", &gblChaseBits);
+			}while (gblChaseBits<0 || gblChaseBits>MAXCHASEBITS);
 		}
 		do{
 			printf("\nEnter # of codewords to generate per pass.");
@@ -3461,22 +10164,144 @@ int main()
 			(void)scanf_s("%d", &loopAllCWsCnt);
 		}while (loopAllCWsCnt<1 || loopAllCWsCnt>MAXLOOPALLCWSCNT);
 	}
-	printf("\nnParm=%d,gblKParm=%d,gblCgpDegree=%d",gblNParm,gblKParm,gblCgpDegree);
+	bitSliceFlg=BITSLICEDECODE;
+	if (toDoCode==1 || toDoCode==2 || toDoCode==4){
+		do{
+			printf("\nEnter 1 to decode 64 to 512 codewords per pass bit-sliced (for");
+			printf("\nbulk scrubbing of mostly error free codewords), 0 to decode one");
+			printf("\nat a time.\n");
+			(void)scanf_s("%d",&bitSliceFlg);
+		}while (bitSliceFlg<0 || bitSliceFlg>1);
+	}
+	// GENERATE THE ENCODE AND DECODE TABLES
+	initStatus=bchCodecInit(&gblCodec,mParm,gblCodec.ffPoly,tParm,numDataBytes,rootFindOption,
+		keyEqSolver,bitSliceFlg);
+	if (initStatus!=0){
+		printf("\n***** ERROR IN bchCodecInit *****  error flag %x.",initStatus);
+		printf("\n************ ENTER ANY NUMBER TO EXIT ***********\n");
+		(void)scanf_s("%d",&junk);
+		return(0);
+	}
+	printf("\nnParm=%d,gblKParm=%d,gblCgpDegree=%d",gblCodec.nParm,gblCodec.kParm,gblCodec.cgpDegree);
 	printf("\n\nnumRedunBits=%d,gblNumRedunBytes=%d,gblNumRedunWords=%d",
-		gblNumRedunBits,gblNumRedunBytes,gblNumRedunWords);
-	printf("\n\nnumDataBytes=%d,gblNumCodewordBytes=%d\n",gblNumDataBytes,gblNumCodewordBytes);
-	cvtCgpBitToCgpWord();// CONVERT CODE GENERATOR POLY (CGP) FROM BIT TO WORD FORMAT
-	genEncodeTbls();	 // GENERATE ENCODE TABLES
+		gblCodec.numRedunBits,gblCodec.numRedunBytes,gblCodec.numRedunWords);
+	printf("\n\nnumDataBytes=%d,gblNumCodewordBytes=%d\n",gblCodec.numDataBytes,gblCodec.numCodewordBytes);
+	if (gblCodec.remainderEngine==REMENGCLMUL){
+		printf("\nEncode and remainder use carry-less multiply folding.\n");
+	}
+	else{
+		printf("\nEncode and remainder use %d byte slicing tables.\n",
+			gblCodec.encodeSliceBytes);
+	}
+	printf("\nBatch encode runs %d codewords in lockstep.\n",gblCodec.encodeLanes);
+	if (gblCodec.ffKernelFeatures!=0){
+		printf("\nThe GF(2^m) batch kernels use%s%s.\n",
+			(gblCodec.ffKernelFeatures & CPUGFNI) ? " GFNI" : "",
+			(gblCodec.ffKernelFeatures & CPUVPCLMUL) ? " VPCLMULQDQ" : "");
+	}
+	if (gblCodec.rootFindOption==ROOTFINDSIMD){
+		printf("\nThe SIMD Chien search evaluates %d positions per step%s.\n",
+			gblCodec.chienLanes,(gblCodec.chienLanes==64 &&
+			(gblCodec.ffKernelFeatures & CPUGFNI)!=0) ? " (GFNI)" : "");
+	}
+	else if (gblCodec.rootFindOption==ROOTFINDTABLE){
+		printf("\nThe Chien search multiplier tables use %d bytes.\n",
+			gblCodec.chienTblBytes);
+	}
+	if (gblCodec.keyEqSolver==KEYEQRIBM){
+		printf("\nThe key equation is solved with riBM, %d terms per step.\n",
+			gblCodec.keyEqLanes);
+	}
+	if (gblCodec.bitSliceFlg!=0){
+		printf("\nBit-sliced decode runs %d codewords per pass.\n",
+			64*gblCodec.bitSliceWords);
+	}
+	printf("\nELPs of degree %d or less are solved without a search.\n",
+		elpStopDeg(&gblCodec));
+	if (gblCodec.rootFindOption==ROOTFINDTUNED){
+		printRootFindTbl(&gblCodec,stdout);
+		do{
+			printf("\nEnter 1 to save the calibration table to a text file, 0 to go on.\n");
+			(void)scanf_s("%d",&saveTblFlg);
+		}while (saveTblFlg<0 || saveTblFlg>1);
+		if (saveTblFlg==1){
+			printf("\nEnter file path and name for WRITING - Example - C://Folder/Tune.txt.\n");
+			// Was unsuccessful in using scanf_s at this point
+			(void)scanf("%s", tblFileName);// No "&" - already addr of array
+			tblFp=fopen(tblFileName,"w");
+			if (tblFp==0){
+				printf("\n*****OPEN ERROR ON FILE FOR WRITING*****\n");
+			}
+			else {
+				printRootFindTbl(&gblCodec,tblFp);
+				fclose(tblFp);
+			}
+		}
+	}
+#if FIXEDCODES
+	gblFixedCode=0;
+	if (toDoCode==0 && gblChaseFlg==0 && gblCodec.keyEqSolver==KEYEQBERMAS &&
+		findFixedCode(&gblCodec)!=0){
+		do{
+			printf("\nThis code is also built in compile time specialized form (BchCode).");
+			printf("\nEnter 1 to encode and decode with it, 0 to use the runtime codec.\n");
+			(void)scanf_s("%d",&junk);
+		}while (junk<0 || junk>1);
+		if (junk==1){
+			gblFixedCode=findFixedCode(&gblCodec);
+		}
+	}
+#endif
+	if (toDoCode==0 || toDoCode==3){
+		kx=chkEncodeBatch(&junk);
+		printf("\nBatch encode check - %d of %d codewords encoded by bchEncodeBatch",
+			kx,junk);
+		printf("\ndiffered from those of bchEncode (must be 0).\n");
+	}
+	if (toDoCode==0){
+		kx=chkUncorrUntouched(UNCORRCHKCWS,&junk);
+		printf("\nUNCORR check - %d of %d words of t+1 errors were uncorrectable,",
+			junk,UNCORRCHKCWS);
+		printf("\n%d of them were changed by the decoder (must be 0).\n",kx);
+		kx=chkFfKernels(FFKERNELCHKVECS);
+		printf("\nGF(2^m) kernel check - %d of %d random vectors, with the kernels picked",
+			kx,2*FFKERNELCHKVECS);
+		printf("\nand with the tables only, gave results that differ from ffMult (must be 0).\n");
+		kx=chkScatterGather(SGCHKCWS,&junk);
+		printf("\nScatter-gather check - %d of %d words split into segments at random",
+			kx,junk);
+		printf("\npoints (%d per remainder engine) encoded or decoded differently",SGCHKCWS);
+		printf("\nthan by bchEncode and bchDecode (must be 0).\n");
+		if (gblChaseFlg==1){
+			kx=chkChase(CHASECHKCWS,&junk);
+			printf("\nChase check - with no flip bits %d of %d words decoded differently",
+				kx,CHASECHKCWS);
+			printf("\nthan by bchDecode (must be 0).  With %d flip bits %d of %d words",
+				CHASECHKBITS,junk,CHASECHKCWS);
+			printf("\nof t+1 errors, one the least reliable bit, were corrected (must be %d).\n",
+				CHASECHKCWS);
+		}
+		if (gblCodec.keyEqSolver==KEYEQRIBM){
+			kx=chkKeyEq(KEYEQCHKCWS);
+			printf("\nriBM check - %d of the ELPs of %d words of 1 to t+1 errors, at each",
+				kx,KEYEQCHKCWS);
+			printf("\nriBM width, differed from those of berMas (must be 0).\n");
+		}
+	}
 	printCgpBits();
 	printCgpWords();
 	accumMisCorrCnt = 0;
-	gblBerMasUCECntr=0;
-	gblRootFindUCECntr=0;
-	gblFixErrorsUCECntr=0;
+	gblScratch.berMasUCECntr=0;
+	gblScratch.rootFindUCECntr=0;
+	gblScratch.fixErrorsUCECntr=0;
 	if (toDoCode==1 || toDoCode==2){ // Rd and corr CWs from disk, on option write back
 		correctCWsFromDisk(toDoCode,loopAllCWsCnt); // Load and correct codewords from disk
 		return(0); // Done EXIT the program
 	}
+	if (toDoCode==4){ // Stream CWs from disk, correct, and stream to a new file
+		streamCWsFromDisk();
+		return(0); // Done EXIT the program
+	}
 	if (toDoCode==3){ // Write test CWs to disk
 		wrtTestCWsToDisk(randomDataFlg,minErrsToSim,maxErrsToSim); // Load and correct codewords from disk
 		return(0); // Done EXIT the program
@@ -3510,10 +10335,10 @@ int main()
 				printf("\nFailing codeword # = %d",failCWCnt);
 				printf("\nRandom number seed = %u",seed);
 				printf("\nquadCompTbl = ");
-				for (kx=0;kx<gblMParm;kx++){
-					printf("%d ",gblQuadCompTbl[kx]);
+				for (kx=0;kx<gblCodec.mParm;kx++){
+					printf("%d ",gblCodec.quadCompTbl[kx]);
 				}
-				printf("\ngblTraceTestVal = %d ",gblTraceTestVal);
+				printf("\ngblTraceTestVal = %d ",gblCodec.traceTestVal);
 				printAppliedErrs();
 				printRemainBytes();
 				printSyndromes();
@@ -3521,7 +10346,7 @@ int main()
 				printLocs();
 				printMiscompares();
 				printf("\nerrFlg(hex) %x  gblMParmOdd %d",
-					errFlg,gblMParmOdd);
+					errFlg,gblCodec.mParmOdd);
 				do{
 					printf("\nEnter 1 to print codeword and log/alog tables.");
 					printf("\nIf the finite field is very large, the print out");
@@ -3564,14 +10389,30 @@ int main()
 			printf("\nPass # %d  # CWs per pass %d  accumMisCorrCnt %d",
 				passCntr,CWsPerPass,accumMisCorrCnt);
 			printf("\ngblBerMasUCECntr %d gblRootFindUCECntr %d gblFixErrorsUCECntr %d",
-				gblBerMasUCECntr, gblRootFindUCECntr, gblFixErrorsUCECntr);
+				gblScratch.berMasUCECntr, gblScratch.rootFindUCECntr, gblScratch.fixErrorsUCECntr);
 			printf("\nRandom number seed = %u\n",seed);
 			printf("\nYou are using the following parameters -- ");
 			printf("\nm %d t %d max errs to sim %d min errs to sim %d # data bytes %d",
-				gblMParm,gblTParm,maxErrsToSim,minErrsToSim,gblNumDataBytes);
+				gblCodec.mParm,gblCodec.tParm,maxErrsToSim,minErrsToSim,gblCodec.numDataBytes);
 			printf("\nCompare Flg %d Random Flg %d",doCompareFlg,randomDataFlg);
-			if (gblRootFindOption==0){
+			if (gblChaseFlg==1){
+				printf("\nChase-II soft decision decoding, %d flip bits",gblChaseBits);
+			}
+			if (gblCodec.keyEqSolver==KEYEQRIBM){
+				printf("\nriBM key equation solver, %d terms per step",gblCodec.keyEqLanes);
+			}
+			if (gblCodec.rootFindOption==ROOTFINDCHIEN){
 				printf("\nYou are using the Chien Search root finder\n");
+			}else if (gblCodec.rootFindOption==ROOTFINDSIMD){
+				printf("\nYou are using the SIMD Chien Search root finder\n");
+			}else if (gblCodec.rootFindOption==ROOTFINDTABLE){
+				printf("\nYou are using the table Chien Search root finder\n");
+			}else if (gblCodec.rootFindOption==ROOTFINDAFFINE){
+				printf("\nYou are using the affine polynomial root finder\n");
+			}else if (gblCodec.rootFindOption==ROOTFINDTUNED){
+				printf("\nYou are using the root finders picked per ELP degree\n");
+			}else if (gblCodec.rootFindOption==ROOTFINDBATCH){
+				printf("\nYou are using the batch polynomial evaluation root finder\n");
 			}else{
 				printf("\nYou are using the Berlekamp trace (BTA) root finder\n");
 			}